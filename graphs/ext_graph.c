@@ -0,0 +1,224 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "graphs.h"
+
+/* Smallest adjacency window, in bytes */
+#define EXT_WINDOW_MIN 4096
+
+/**
+ * read_full - pread(2) that retries short reads
+ *
+ * @fd: File descriptor
+ * @buf: Destination buffer
+ * @size: Number of bytes to read
+ * @pos: File position
+ *
+ * Return: 1 if `size` bytes were read, otherwise 0
+ */
+static int
+read_full(int fd, void *buf, size_t size, long pos);
+
+/**
+ * read_offsets - Reads and validates the offsets of a snapshot
+ *
+ * @graph: Pointer to semi-external graph, its counts set from the header
+ * @file_size: Size of the snapshot, header excluded
+ *
+ * Return: 1 if the offsets fit the file and run from 0 to nb_edges without
+ *   decreasing, otherwise 0
+ */
+static int
+read_offsets(ext_graph_t *graph, size_t file_size);
+
+/**
+ * ext_graph_open - Opens an on-disk snapshot for semi-external traversal
+ *
+ * @path: Path of a file written by graph_csr_save
+ * @mem_budget: Bytes allowed for buffered adjacency (at least one page
+ *   is used). Offsets and visited flags are held in RAM on top of it
+ *
+ * Return: Pointer to semi-external graph or NULL on failure
+ */
+ext_graph_t
+*ext_graph_open(const char *path, size_t mem_budget)
+{
+	ext_graph_t *graph = NULL;
+	graph_csr_header_t header;
+	struct stat st;
+
+	if (!path)
+		return (NULL);
+
+	graph = calloc(1, sizeof(ext_graph_t));
+
+	if (!graph)
+		return (NULL);
+
+	graph->fd = open(path, O_RDONLY);
+
+	if (graph->fd < 0 || fstat(graph->fd, &st) ||
+		!read_full(graph->fd, &header, sizeof(header), 0) ||
+		memcmp(header.magic, GRAPH_CSR_MAGIC, sizeof(header.magic)))
+		goto on_fail;
+
+	graph->nb_vertices = header.nb_vertices;
+	graph->nb_edges = header.nb_edges;
+
+	if (!read_offsets(graph, (size_t)st.st_size - sizeof(header)))
+		goto on_fail;
+
+	graph->targets_pos = (long)(sizeof(header) +
+		(header.nb_vertices + 1) * sizeof(size_t));
+	mem_budget = mem_budget < EXT_WINDOW_MIN ? EXT_WINDOW_MIN : mem_budget;
+	graph->window_cap = mem_budget / sizeof(size_t);
+	graph->window = malloc(graph->window_cap * sizeof(size_t));
+
+	if (!graph->window)
+		goto on_fail;
+
+	/* Hint the kernel to read ahead aggressively along the targets */
+	posix_fadvise(graph->fd, graph->targets_pos, 0, POSIX_FADV_SEQUENTIAL);
+	return (graph);
+
+on_fail:
+	ext_graph_close(graph);
+	return (NULL);
+}
+
+/**
+ * ext_graph_close - Semi-external graph free function
+ *
+ * @graph: Pointer to semi-external graph
+ */
+void
+ext_graph_close(ext_graph_t *graph)
+{
+	if (!graph)
+		return;
+
+	if (graph->fd >= 0)
+		close(graph->fd);
+
+	free(graph->offsets);
+	free(graph->window);
+	free(graph);
+}
+
+/**
+ * ext_graph_edges - Maps a range of targets into the window
+ *
+ * @graph: Pointer to semi-external graph
+ * @first: Edge offset of the first target wanted
+ * @hint_end: Edge offset up to which the caller expects to read next
+ * @count: Pointer to store the number of targets available at the return
+ *   value (at least 1 on success)
+ *
+ * Return: Pointer to the target at `first`, NULL on failure or if the
+ *   window read holds a target out of range
+ */
+const size_t
+*ext_graph_edges(ext_graph_t *graph, size_t first, size_t hint_end,
+	size_t *count)
+{
+	size_t want, i;
+	long pos;
+
+	if (first >= graph->nb_edges)
+		return (NULL);
+
+	if (first < graph->window_first ||
+		first >= graph->window_first + graph->window_count)
+	{
+		want = hint_end > first ? hint_end - first : 1;
+		want = want > graph->window_cap ? graph->window_cap : want;
+		want = want > graph->nb_edges - first ?
+			graph->nb_edges - first : want;
+		pos = graph->targets_pos + (long)(first * sizeof(size_t));
+		graph->window_count = 0;
+
+		if (!read_full(graph->fd, graph->window, want * sizeof(size_t),
+			pos))
+			return (NULL);
+
+		/* Callers index vertex state with these: reject bad ones */
+		for (i = 0; i < want; ++i)
+			if (graph->window[i] >= graph->nb_vertices)
+				return (NULL);
+
+		graph->window_first = first;
+		graph->window_count = want;
+		graph->bytes_read += want * sizeof(size_t);
+		/* Overlap the next window's I/O with work on this one */
+		posix_fadvise(graph->fd, pos + (long)(want * sizeof(size_t)),
+			(long)(graph->window_cap * sizeof(size_t)),
+			POSIX_FADV_WILLNEED);
+	}
+
+	*count = graph->window_first + graph->window_count - first;
+	return (graph->window + (first - graph->window_first));
+}
+
+/**
+ * read_full - pread(2) that retries short reads
+ *
+ * @fd: File descriptor
+ * @buf: Destination buffer
+ * @size: Number of bytes to read
+ * @pos: File position
+ *
+ * Return: 1 if `size` bytes were read, otherwise 0
+ */
+static int
+read_full(int fd, void *buf, size_t size, long pos)
+{
+	ssize_t n;
+
+	while (size)
+	{
+		n = pread(fd, buf, size, pos);
+
+		if (n <= 0)
+			return (0);
+
+		buf = (char *)buf + n;
+		size -= (size_t)n;
+		pos += n;
+	}
+
+	return (1);
+}
+
+/**
+ * read_offsets - Reads and validates the offsets of a snapshot
+ *
+ * @graph: Pointer to semi-external graph, its counts set from the header
+ * @file_size: Size of the snapshot, header excluded
+ *
+ * Return: 1 if the offsets fit the file and run from 0 to nb_edges without
+ *   decreasing, otherwise 0
+ */
+static int
+read_offsets(ext_graph_t *graph, size_t file_size)
+{
+	size_t words = file_size / sizeof(size_t), n = graph->nb_vertices, i;
+
+	/* Compare counts, not byte sizes, so nothing can overflow */
+	if (file_size % sizeof(size_t) || n >= words ||
+		graph->nb_edges != words - n - 1)
+		return (0);
+
+	graph->offsets = malloc((n + 1) * sizeof(size_t));
+
+	if (!graph->offsets || !read_full(graph->fd, graph->offsets,
+		(n + 1) * sizeof(size_t), (long)sizeof(graph_csr_header_t)))
+		return (0);
+
+	for (i = 0; i < n; ++i)
+		if (graph->offsets[i] > graph->offsets[i + 1])
+			return (0);
+
+	return (!graph->offsets[0] && graph->offsets[n] == graph->nb_edges);
+}
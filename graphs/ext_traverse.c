@@ -0,0 +1,250 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/* Largest hole (in targets) read through rather than skipped */
+#define EXT_GAP_MAX 8192
+
+#define BIT_TEST(bits, i) ((bits)[(i) >> 3] & (1u << ((i) & 7)))
+#define BIT_SET(bits, i) ((bits)[(i) >> 3] |= (unsigned char)(1u << ((i) & 7)))
+
+/**
+ * index_cmp - qsort comparator for vertex indices
+ *
+ * @a: Pointer to first size_t
+ * @b: Pointer to second size_t
+ *
+ * Return: Negative, 0 or positive, as for qsort
+ */
+static int
+index_cmp(const void *a, const void *b);
+
+/**
+ * run_end - Finds how far one sequential read can serve a sorted frontier
+ *
+ * @graph: Pointer to semi-external graph
+ * @level: Sorted frontier
+ * @i: Position of the vertex that needs a read
+ * @n: Frontier size
+ *
+ * Return: Edge offset to read up to
+ */
+static size_t
+run_end(const ext_graph_t *graph, const size_t *level, size_t i, size_t n);
+
+/**
+ * expand_level - Collects the unvisited targets of a whole frontier
+ *
+ * @graph: Pointer to semi-external graph
+ * @visited: Visited bitmap
+ * @level: Sorted frontier
+ * @n: Frontier size
+ * @next: Output array for the next frontier
+ *
+ * Return: Size of the next frontier, or (size_t)-1 on failure
+ */
+static size_t
+expand_level(ext_graph_t *graph, unsigned char *visited, const size_t *level,
+	size_t n, size_t *next);
+
+/**
+ * ext_breadth_first_traverse - Semi-external breadth-first traversal
+ * Levels are expanded in vertex-index order so that adjacency is read
+ * front to back; vertices of one level are visited in index order
+ *
+ * @graph: Pointer to semi-external graph
+ * @action: Function called for each vertex reached from vertex 0
+ *
+ * Return: The greatest vertex depth or 0UL on failure
+ */
+size_t
+ext_breadth_first_traverse(ext_graph_t *graph, ext_action_t action)
+{
+	unsigned char *visited = NULL;
+	size_t *base = NULL, *level = NULL, *next = NULL, n = 1, i, depth = 0;
+
+	if (!graph || !graph->nb_vertices || !action)
+		return (0);
+
+	visited = calloc(graph->nb_vertices / 8 + 1, 1);
+	base = malloc(2 * graph->nb_vertices * sizeof(size_t));
+
+	if (!visited || !base)
+		goto out;
+
+	level = base, next = base + graph->nb_vertices;
+	level[0] = 0;
+	BIT_SET(visited, 0);
+
+	for (;;)
+	{
+		for (i = 0; i < n; ++i)
+			action(level[i], depth);
+
+		n = expand_level(graph, visited, level, n, next);
+
+		if (n == (size_t)-1)
+			depth = 0;
+
+		if (!n || n == (size_t)-1)
+			break;
+
+		qsort(next, n, sizeof(size_t), index_cmp);
+		level = next;
+		next = level == base ? base + graph->nb_vertices : base;
+		++depth;
+	}
+
+out:
+	free(visited);
+	free(base);
+	return (depth);
+}
+
+/**
+ * ext_depth_first_traverse - Semi-external depth-first traversal
+ *
+ * @graph: Pointer to semi-external graph
+ * @action: Function called for each vertex reached from vertex 0
+ *
+ * Return: The greatest vertex depth or 0UL on failure
+ */
+size_t
+ext_depth_first_traverse(ext_graph_t *graph, ext_action_t action)
+{
+	unsigned char *visited = NULL;
+	ext_frame_t *stack = NULL, *top = NULL;
+	const size_t *target = NULL;
+	size_t depth, max_depth = 0, n;
+
+	if (!graph || !graph->nb_vertices || !action)
+		return (0);
+
+	visited = calloc(graph->nb_vertices / 8 + 1, 1);
+	stack = malloc(graph->nb_vertices * sizeof(ext_frame_t));
+	depth = visited && stack;
+
+	if (depth)
+	{
+		BIT_SET(visited, 0), action(0, 0);
+		stack->v = 0, stack->e = graph->offsets[0];
+	}
+
+	/* `depth` is the number of frames, i.e. the depth of the next push */
+	while (depth)
+	{
+		top = stack + depth - 1;
+
+		if (top->e == graph->offsets[top->v + 1])
+		{
+			--depth;
+			continue;
+		}
+
+		target = ext_graph_edges(graph, top->e++,
+			graph->offsets[top->v + 1], &n);
+
+		if (!target)
+			max_depth = depth = 0;
+		else if (!BIT_TEST(visited, *target))
+		{
+			BIT_SET(visited, *target), action(*target, depth);
+			max_depth = depth > max_depth ? depth : max_depth;
+			stack[depth].v = *target;
+			stack[depth++].e = graph->offsets[*target];
+		}
+	}
+
+	free(visited);
+	free(stack);
+	return (max_depth);
+}
+
+/**
+ * expand_level - Collects the unvisited targets of a whole frontier
+ *
+ * @graph: Pointer to semi-external graph
+ * @visited: Visited bitmap
+ * @level: Sorted frontier
+ * @n: Frontier size
+ * @next: Output array for the next frontier
+ *
+ * Return: Size of the next frontier, or (size_t)-1 on failure
+ */
+static size_t
+expand_level(ext_graph_t *graph, unsigned char *visited, const size_t *level,
+	size_t n, size_t *next)
+{
+	const size_t *target = NULL;
+	size_t i, k, e, end, hint = 0, count, nb_next = 0;
+
+	for (i = 0; i < n; ++i)
+	{
+		end = graph->offsets[level[i] + 1];
+
+		for (e = graph->offsets[level[i]]; e < end; e += count)
+		{
+			if (e < graph->window_first ||
+				e >= graph->window_first + graph->window_count)
+				hint = run_end(graph, level, i, n);
+
+			hint = hint > end ? hint : end;
+			target = ext_graph_edges(graph, e, hint, &count);
+
+			if (!target)
+				return ((size_t)-1);
+
+			count = count > end - e ? end - e : count;
+
+			for (k = 0; k < count; ++k)
+			{
+				if (!BIT_TEST(visited, target[k]))
+				{
+					BIT_SET(visited, target[k]);
+					next[nb_next++] = target[k];
+				}
+			}
+		}
+	}
+
+	return (nb_next);
+}
+
+/**
+ * run_end - Finds how far one sequential read can serve a sorted frontier
+ *
+ * @graph: Pointer to semi-external graph
+ * @level: Sorted frontier
+ * @i: Position of the vertex that needs a read
+ * @n: Frontier size
+ *
+ * Return: Edge offset to read up to
+ */
+static size_t
+run_end(const ext_graph_t *graph, const size_t *level, size_t i, size_t n)
+{
+	const size_t *off = graph->offsets;
+	size_t start = off[level[i]], end = off[level[i] + 1];
+
+	/* Stop at the window size, or at a hole cheaper to seek over */
+	while (++i < n && off[level[i] + 1] - start <= graph->window_cap &&
+		off[level[i]] - end <= EXT_GAP_MAX)
+		end = off[level[i] + 1];
+
+	return (end);
+}
+
+/**
+ * index_cmp - qsort comparator for vertex indices
+ *
+ * @a: Pointer to first size_t
+ * @b: Pointer to second size_t
+ *
+ * Return: Negative, 0 or positive, as for qsort
+ */
+static int
+index_cmp(const void *a, const void *b)
+{
+	size_t ia = *(const size_t *)a, ib = *(const size_t *)b;
+
+	return ((ia > ib) - (ia < ib));
+}
@@ -0,0 +1,19 @@
+#include <time.h>
+#include "graphs.h"
+
+/**
+ * graph_clock_ns - Reads the monotonic clock
+ *
+ * Return: Current monotonic time, in nanoseconds
+ */
+unsigned long
+graph_clock_ns(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts))
+		return (0);
+
+	return ((unsigned long)ts.tv_sec * 1000000000UL +
+		(unsigned long)ts.tv_nsec);
+}
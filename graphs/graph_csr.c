@@ -0,0 +1,85 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * graph_csr_alloc - Allocates an empty adjacency snapshot
+ *
+ * @nb_vertices: Number of vertices
+ * @nb_edges: Number of edges
+ *
+ * Return: Pointer to snapshot structure or NULL if allocation fails
+ */
+graph_csr_t
+*graph_csr_alloc(size_t nb_vertices, size_t nb_edges)
+{
+	graph_csr_t *csr = NULL;
+	size_t alloc_size;
+
+	alloc_size = sizeof(graph_csr_t);
+	alloc_size += (nb_vertices + 1 + nb_edges) * sizeof(size_t);
+	alloc_size += nb_vertices * sizeof(vertex_t *);
+	csr = calloc(1, alloc_size);
+
+	if (!csr)
+		return (NULL);
+
+	/* Pointer array first so that it stays aligned */
+	csr->vertices = (vertex_t **)(csr + 1);
+	csr->offsets = (size_t *)(csr->vertices + nb_vertices);
+	csr->targets = csr->offsets + nb_vertices + 1;
+	csr->nb_vertices = nb_vertices;
+	csr->nb_edges = nb_edges;
+	return (csr);
+}
+
+/**
+ * graph_csr_create - Builds a contiguous adjacency snapshot of a graph
+ *
+ * @graph: Pointer to graph structure
+ *
+ * Return: Pointer to snapshot structure or NULL on failure
+ */
+graph_csr_t
+*graph_csr_create(const graph_t *graph)
+{
+	graph_csr_t *csr = NULL;
+	vertex_t *v = NULL;
+	edge_t *e = NULL;
+	size_t nb_edges = 0, pos = 0;
+
+	if (!graph)
+		return (NULL);
+
+	for (v = graph->vertices; v; v = v->next)
+		nb_edges += v->nb_edges;
+
+	csr = graph_csr_alloc(graph->nb_vertices, nb_edges);
+
+	if (!csr)
+		return (NULL);
+
+	/* Vertex indices follow list order, so offsets fill front to back */
+	for (v = graph->vertices; v; v = v->next)
+	{
+		csr->vertices[v->index] = v;
+		csr->offsets[v->index] = pos;
+
+		for (e = v->edges; e && pos < nb_edges; e = e->next)
+			csr->targets[pos++] = e->dest->index;
+	}
+
+	csr->offsets[graph->nb_vertices] = pos;
+	csr->nb_edges = pos;
+	return (csr);
+}
+
+/**
+ * graph_csr_delete - Adjacency-snapshot free function
+ *
+ * @csr: Pointer to snapshot structure
+ */
+void
+graph_csr_delete(graph_csr_t *csr)
+{
+	free(csr);
+}
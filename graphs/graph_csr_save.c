@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <string.h>
+#include "graphs.h"
+
+/**
+ * graph_csr_save - Writes an adjacency snapshot to a file
+ *
+ * @csr: Pointer to snapshot structure
+ * @path: Path of the file to create or truncate
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int
+graph_csr_save(const graph_csr_t *csr, const char *path)
+{
+	graph_csr_header_t header;
+	FILE *file = NULL;
+	int ok;
+
+	if (!csr || !path)
+		return (0);
+
+	file = fopen(path, "wb");
+
+	if (!file)
+		return (0);
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, GRAPH_CSR_MAGIC, sizeof(header.magic));
+	header.nb_vertices = csr->nb_vertices;
+	header.nb_edges = csr->nb_edges;
+
+	ok = fwrite(&header, sizeof(header), 1, file) == 1;
+	ok = ok && fwrite(csr->offsets, sizeof(size_t), csr->nb_vertices + 1,
+		file) == csr->nb_vertices + 1;
+	ok = ok && fwrite(csr->targets, sizeof(size_t), csr->nb_edges,
+		file) == csr->nb_edges;
+
+	return (!fclose(file) && ok);
+}
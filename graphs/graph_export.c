@@ -0,0 +1,189 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+#define PUT_LITERAL(w, s) graph_writer_put((w), (s), sizeof(s) - 1)
+/* Puts a literal without its first `skip` characters */
+#define PUT_SKIP(w, s, skip) \
+	graph_writer_put((w), (s) + (skip), sizeof(s) - 1 - (size_t)(skip))
+
+/**
+ * export_any - Emits a graph in the requested format
+ *
+ * @graph: Pointer to graph structure
+ * @format: Export format
+ * @w: Pointer to writer
+ */
+static void
+export_any(const graph_t *graph, graph_format_t format, graph_writer_t *w);
+
+/**
+ * export_json - Emits a graph as a JSON object
+ *
+ * @graph: Pointer to graph structure
+ * @w: Pointer to writer
+ */
+static void
+export_json(const graph_t *graph, graph_writer_t *w);
+
+/**
+ * graph_export_fd - Writes a graph to a file descriptor
+ * Output is staged in a GRAPH_WRITER_BUFSIZE buffer, one write(2) per chunk
+ *
+ * @graph: Pointer to graph structure
+ * @format: Export format
+ * @fd: Destination file descriptor
+ *
+ * Return: Number of bytes written, or -1 on failure
+ */
+long
+graph_export_fd(const graph_t *graph, graph_format_t format, int fd)
+{
+	graph_writer_t w = { -1, NULL, GRAPH_WRITER_BUFSIZE, 0, 0, 0 };
+
+	if (!graph || fd < 0 || format > GRAPH_FORMAT_JSON)
+		return (-1);
+
+	w.fd = fd;
+	w.buf = malloc(w.cap);
+
+	if (!w.buf)
+		return (-1);
+
+	export_any(graph, format, &w);
+	graph_writer_flush(&w);
+	free(w.buf);
+	return (w.error ? -1 : (long)w.total);
+}
+
+/**
+ * graph_export_mem - Writes a graph to a caller-provided buffer
+ * Like snprintf, output is truncated (and null-terminated) to fit `size`
+ *
+ * @graph: Pointer to graph structure
+ * @format: Export format
+ * @buf: Destination buffer (may be NULL if `size` is 0)
+ * @size: Size of `buf`
+ *
+ * Return: Length of the full output, excluding the null byte, or -1 on
+ *   failure. A return value of `size` or more means it was truncated
+ */
+long
+graph_export_mem(const graph_t *graph, graph_format_t format, char *buf,
+	size_t size)
+{
+	graph_writer_t w = { -1, NULL, 0, 0, 0, 0 };
+
+	if (!graph || (!buf && size) || format > GRAPH_FORMAT_JSON)
+		return (-1);
+
+	/* Formatted straight into the caller's buffer, no staging copy */
+	w.buf = buf;
+	w.cap = size ? size - 1 : 0;
+	export_any(graph, format, &w);
+
+	if (size)
+		buf[w.len] = '\0';
+
+	return ((long)w.total);
+}
+
+/**
+ * export_any - Emits a graph in the requested format
+ *
+ * @graph: Pointer to graph structure
+ * @format: Export format
+ * @w: Pointer to writer
+ */
+static void
+export_any(const graph_t *graph, graph_format_t format, graph_writer_t *w)
+{
+	const vertex_t *v = NULL;
+	const edge_t *e = NULL;
+
+	if (format == GRAPH_FORMAT_JSON)
+	{
+		export_json(graph, w);
+		return;
+	}
+
+	if (format == GRAPH_FORMAT_DOT)
+		PUT_LITERAL(w, "digraph {\n");
+
+	for (v = graph->vertices; v && format == GRAPH_FORMAT_DOT; v = v->next)
+	{
+		PUT_LITERAL(w, "\t");
+		graph_writer_put_index(w, v->index);
+		PUT_LITERAL(w, " [label=");
+		graph_writer_put_escaped(w, v->content, GRAPH_FORMAT_DOT);
+		PUT_LITERAL(w, "];\n");
+	}
+
+	for (v = graph->vertices; v; v = v->next)
+	{
+		for (e = v->edges; e; e = e->next)
+		{
+			if (format == GRAPH_FORMAT_DOT)
+				PUT_LITERAL(w, "\t");
+
+			graph_writer_put_index(w, v->index);
+
+			if (format == GRAPH_FORMAT_DOT)
+				PUT_LITERAL(w, " -> ");
+			else
+				PUT_LITERAL(w, " ");
+
+			graph_writer_put_index(w, e->dest->index);
+			if (format == GRAPH_FORMAT_DOT)
+				PUT_LITERAL(w, ";\n");
+			else
+				PUT_LITERAL(w, "\n");
+		}
+	}
+
+	if (format == GRAPH_FORMAT_DOT)
+		PUT_LITERAL(w, "}\n");
+}
+
+/**
+ * export_json - Emits a graph as a JSON object
+ *
+ * @graph: Pointer to graph structure
+ * @w: Pointer to writer
+ */
+static void
+export_json(const graph_t *graph, graph_writer_t *w)
+{
+	const vertex_t *v = NULL;
+	const edge_t *e = NULL;
+	int first = 1;
+
+	PUT_LITERAL(w, "{\"vertices\":[");
+
+	for (v = graph->vertices; v; v = v->next)
+	{
+		/* Leading comma skipped for the first element */
+		first = v == graph->vertices;
+		PUT_SKIP(w, ",{\"index\":", first);
+		graph_writer_put_index(w, v->index);
+		PUT_LITERAL(w, ",\"content\":");
+		graph_writer_put_escaped(w, v->content, GRAPH_FORMAT_JSON);
+		PUT_LITERAL(w, "}");
+	}
+
+	PUT_LITERAL(w, "],\"edges\":[");
+	first = 1;
+
+	for (v = graph->vertices; v; v = v->next)
+	{
+		for (e = v->edges; e; e = e->next, first = 0)
+		{
+			PUT_SKIP(w, ",[", first);
+			graph_writer_put_index(w, v->index);
+			PUT_LITERAL(w, ",");
+			graph_writer_put_index(w, e->dest->index);
+			PUT_LITERAL(w, "]");
+		}
+	}
+
+	PUT_LITERAL(w, "]}\n");
+}
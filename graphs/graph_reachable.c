@@ -0,0 +1,147 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * comp_reaches - Reachability between two components
+ *
+ * @index: Pointer to reachability index
+ * @a: Source component
+ * @b: Destination component
+ *
+ * Return: 1 if `a` reaches `b`, otherwise 0
+ */
+static int
+comp_reaches(const reach_index_t *index, size_t a, size_t b);
+
+/**
+ * graph_reachable - Answers "can `a` reach `b`?" in O(label size)
+ *
+ * @index: Pointer to reachability index of the graph
+ * @a: Pointer to source vertex
+ * @b: Pointer to destination vertex
+ *
+ * Return: 1 if there is a path from `a` to `b` (a vertex reaches itself),
+ *   0 if not or on failure
+ */
+int
+graph_reachable(const reach_index_t *index, const vertex_t *a,
+	const vertex_t *b)
+{
+	if (!index || !a || !b)
+		return (0);
+
+	if (a->index >= index->nb_vertices || b->index >= index->nb_vertices)
+		return (0);
+
+	return (comp_reaches(index, index->comp[a->index],
+		index->comp[b->index]));
+}
+
+/**
+ * reach_hubs_meet - Tests whether two ascending hub lists intersect
+ *
+ * @a: First hub list
+ * @na: Size of `a`
+ * @b: Second hub list
+ * @nb: Size of `b`
+ *
+ * Return: 1 if a hub appears in both lists, otherwise 0
+ */
+int
+reach_hubs_meet(const unsigned int *a, size_t na, const unsigned int *b,
+	size_t nb)
+{
+	size_t i = 0, j = 0;
+
+	while (i < na && j < nb)
+	{
+		if (a[i] == b[j])
+			return (1);
+
+		if (a[i] < b[j])
+			++i;
+		else
+			++j;
+	}
+
+	return (0);
+}
+
+/**
+ * reach_index_stats - Reports index size, build time and query latency
+ *
+ * @index: Pointer to reachability index
+ * @stats: Pointer to report structure to fill
+ * @nb_samples: Number of pseudo-random queries to time (0 skips timing)
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int
+reach_index_stats(const reach_index_t *index, reach_stats_t *stats,
+	size_t nb_samples)
+{
+	unsigned long seed = 0x9e3779b97f4a7c15UL, start;
+	size_t i, a, b, hits = 0;
+
+	if (!index || !stats)
+		return (0);
+
+	stats->nb_comps = index->nb_comps;
+	stats->nb_entries = index->nb_entries;
+	stats->size_bytes = sizeof(reach_index_t) +
+		index->nb_vertices * sizeof(size_t) +
+		2 * (index->nb_comps + 1) * sizeof(size_t) +
+		index->nb_entries * sizeof(unsigned int);
+	stats->avg_label = index->nb_comps ? (double)index->nb_entries /
+		(2.0 * (double)index->nb_comps) : 0.0;
+	stats->build_ns = index->build_ns;
+	stats->query_ns = 0.0;
+
+	if (!nb_samples || !index->nb_vertices)
+		return (1);
+
+	start = graph_clock_ns();
+
+	for (i = 0; i < nb_samples; ++i)
+	{
+		/* xorshift: cheap enough not to dominate the timing */
+		seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+		a = (size_t)(seed % index->nb_vertices);
+		b = (size_t)((seed >> 32) % index->nb_vertices);
+		hits += (size_t)comp_reaches(index, index->comp[a],
+			index->comp[b]);
+	}
+
+	stats->query_ns = (double)(graph_clock_ns() - start) /
+		(double)nb_samples;
+	/* Consuming `hits` keeps the timed loop from being optimised away */
+	return (hits <= nb_samples);
+}
+
+/**
+ * comp_reaches - Reachability between two components
+ *
+ * @index: Pointer to reachability index
+ * @a: Source component
+ * @b: Destination component
+ *
+ * Return: 1 if `a` reaches `b`, otherwise 0
+ */
+static int
+comp_reaches(const reach_index_t *index, size_t a, size_t b)
+{
+	size_t oa, ib;
+
+	if (a == b)
+		return (1);
+
+	/* Components are numbered in reverse topological order */
+	if (a < b)
+		return (0);
+
+	oa = index->out_offsets[a];
+	ib = index->in_offsets[b];
+	return (reach_hubs_meet(index->out_hubs + oa,
+		index->out_offsets[a + 1] - oa,
+		index->in_hubs + ib, index->in_offsets[b + 1] - ib));
+}
@@ -0,0 +1,157 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/**
+ * scc_discover - Gives a discovery order to a vertex and pushes its frame
+ *
+ * @ctx: Pointer to Tarjan context
+ * @frame_top: Pointer to number of frames on the call stack
+ * @v: Vertex index
+ */
+static void
+scc_discover(scc_ctx_t *ctx, size_t *frame_top, size_t v);
+
+/**
+ * scc_close - Pops a finished vertex, emitting its component if it is a root
+ *
+ * @ctx: Pointer to Tarjan context
+ * @v: Vertex index
+ */
+static void
+scc_close(scc_ctx_t *ctx, size_t v);
+
+/**
+ * scc_from - Runs Tarjan's algorithm from one undiscovered root
+ *
+ * @ctx: Pointer to Tarjan context
+ * @root: Root vertex index
+ */
+static void
+scc_from(scc_ctx_t *ctx, size_t root);
+
+/**
+ * graph_scc - Labels strongly connected components (iterative Tarjan)
+ *
+ * @csr: Pointer to adjacency snapshot
+ * @comp: Array of `csr->nb_vertices` component ids to fill, by vertex index.
+ *   Components come out in reverse topological order: if component `a`
+ *   reaches component `b != a`, then `b < a`
+ *
+ * Return: Number of components, or 0 on failure
+ */
+size_t
+graph_scc(const graph_csr_t *csr, size_t *comp)
+{
+	scc_ctx_t ctx = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0, 0 };
+	size_t n, v;
+
+	if (!csr || !comp || !csr->nb_vertices)
+		return (0);
+
+	n = csr->nb_vertices;
+	ctx.csr = csr;
+	ctx.comp = comp;
+	ctx.order = calloc(3 * n, sizeof(size_t));
+	ctx.frames = malloc(n * sizeof(scc_frame_t));
+	ctx.on_stack = calloc(n, sizeof(unsigned char));
+
+	if (ctx.order && ctx.frames && ctx.on_stack)
+	{
+		ctx.low = ctx.order + n;
+		ctx.stack = ctx.low + n;
+
+		for (v = 0; v < n; ++v)
+		{
+			if (!ctx.order[v])
+				scc_from(&ctx, v);
+		}
+	}
+
+	free(ctx.order);
+	free(ctx.frames);
+	free(ctx.on_stack);
+	return (ctx.nb_comps);
+}
+
+/**
+ * scc_from - Runs Tarjan's algorithm from one undiscovered root
+ *
+ * @ctx: Pointer to Tarjan context
+ * @root: Root vertex index
+ */
+static void
+scc_from(scc_ctx_t *ctx, size_t root)
+{
+	const graph_csr_t *csr = ctx->csr;
+	size_t frame_top = 0, v, w;
+
+	scc_discover(ctx, &frame_top, root);
+
+	while (frame_top)
+	{
+		v = ctx->frames[frame_top - 1].v;
+
+		if (ctx->frames[frame_top - 1].e < csr->offsets[v + 1])
+		{
+			w = csr->targets[ctx->frames[frame_top - 1].e++];
+
+			if (!ctx->order[w])
+				scc_discover(ctx, &frame_top, w);
+			else if (ctx->on_stack[w])
+				ctx->low[v] = MIN(ctx->low[v], ctx->order[w]);
+
+			continue;
+		}
+
+		scc_close(ctx, v);
+
+		if (--frame_top)
+		{
+			w = ctx->frames[frame_top - 1].v;
+			ctx->low[w] = MIN(ctx->low[w], ctx->low[v]);
+		}
+	}
+}
+
+/**
+ * scc_discover - Gives a discovery order to a vertex and pushes its frame
+ *
+ * @ctx: Pointer to Tarjan context
+ * @frame_top: Pointer to number of frames on the call stack
+ * @v: Vertex index
+ */
+static void
+scc_discover(scc_ctx_t *ctx, size_t *frame_top, size_t v)
+{
+	ctx->order[v] = ctx->low[v] = ++ctx->counter;
+	ctx->stack[ctx->top++] = v;
+	ctx->on_stack[v] = 1;
+	ctx->frames[*frame_top].v = v;
+	ctx->frames[*frame_top].e = ctx->csr->offsets[v];
+	++*frame_top;
+}
+
+/**
+ * scc_close - Pops a finished vertex, emitting its component if it is a root
+ *
+ * @ctx: Pointer to Tarjan context
+ * @v: Vertex index
+ */
+static void
+scc_close(scc_ctx_t *ctx, size_t v)
+{
+	size_t w;
+
+	if (ctx->low[v] != ctx->order[v])
+		return;
+
+	do {
+		w = ctx->stack[--ctx->top];
+		ctx->on_stack[w] = 0;
+		ctx->comp[w] = ctx->nb_comps;
+	} while (w != v);
+
+	++ctx->nb_comps;
+}
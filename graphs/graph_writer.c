@@ -0,0 +1,143 @@
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include "graphs.h"
+
+/**
+ * graph_writer_flush - Hands buffered bytes to the file descriptor
+ *
+ * @w: Pointer to writer
+ */
+void
+graph_writer_flush(graph_writer_t *w)
+{
+	ssize_t n;
+	size_t done = 0;
+
+	if (w->fd < 0)
+		return;
+
+	while (done < w->len && !w->error)
+	{
+		n = write(w->fd, w->buf + done, w->len - done);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+
+		if (n <= 0)
+			w->error = 1;
+		else
+			done += (size_t)n;
+	}
+
+	w->len = 0;
+}
+
+/**
+ * graph_writer_put - Appends bytes to a writer
+ *
+ * @w: Pointer to writer
+ * @str: Bytes to append
+ * @len: Number of bytes
+ */
+void
+graph_writer_put(graph_writer_t *w, const char *str, size_t len)
+{
+	size_t chunk;
+
+	w->total += len;
+
+	while (len && w->cap)
+	{
+		if (w->len == w->cap)
+		{
+			/* Memory output stops filling, but keeps counting */
+			if (w->fd < 0)
+				return;
+
+			graph_writer_flush(w);
+		}
+
+		chunk = w->cap - w->len < len ? w->cap - w->len : len;
+		memcpy(w->buf + w->len, str, chunk);
+		w->len += chunk, str += chunk, len -= chunk;
+	}
+}
+
+/**
+ * graph_writer_put_index - Appends a decimal unsigned integer to a writer
+ *
+ * @w: Pointer to writer
+ * @n: Integer to format
+ */
+void
+graph_writer_put_index(graph_writer_t *w, size_t n)
+{
+	char digits[24], *dst;
+	size_t i = sizeof(digits), len;
+
+	do {
+		digits[--i] = (char)('0' + n % 10);
+		n /= 10;
+	} while (n);
+
+	len = sizeof(digits) - i;
+
+	/* Common case: room left, skip the generic copy loop */
+	if (w->cap - w->len < len)
+	{
+		graph_writer_put(w, digits + i, len);
+		return;
+	}
+
+	for (dst = w->buf + w->len, w->len += len, w->total += len;
+		i < sizeof(digits); ++i)
+		*dst++ = digits[i];
+}
+
+/**
+ * graph_writer_put_escaped - Appends a double-quoted, escaped string
+ * JSON escapes quotes, backslashes and control characters (as \u00XX);
+ * DOT only knows \", so backslashes are doubled for Graphviz labels,
+ * newlines become \n and other control characters are copied raw
+ *
+ * @w: Pointer to writer
+ * @str: String to quote
+ * @format: GRAPH_FORMAT_DOT or GRAPH_FORMAT_JSON
+ */
+void
+graph_writer_put_escaped(graph_writer_t *w, const char *str,
+	graph_format_t format)
+{
+	const char *run = str;
+	char esc[7] = "\\u0000";
+	int json = format == GRAPH_FORMAT_JSON;
+
+	graph_writer_put(w, "\"", 1);
+
+	/* Copy unescaped runs in one go */
+	for (; *str; ++str)
+	{
+		if (*str != '"' && *str != '\\' && *str != '\n' &&
+			((unsigned char)*str >= 0x20 || !json))
+			continue;
+
+		graph_writer_put(w, run, (size_t)(str - run));
+		run = str + 1;
+
+		if (*str == '"' || *str == '\\' || !json)
+		{
+			esc[1] = *str == '\n' ? 'n' : *str;
+			graph_writer_put(w, esc, 2);
+			continue;
+		}
+
+		esc[1] = 'u';
+		esc[4] = "0123456789abcdef"[(unsigned char)*str >> 4];
+		esc[5] = "0123456789abcdef"[*str & 0xf];
+		graph_writer_put(w, esc, 6);
+	}
+
+	graph_writer_put(w, run, (size_t)(str - run));
+	graph_writer_put(w, "\"", 1);
+}
@@ -110,6 +110,303 @@ typedef struct dfs_ctx_s
 	long stack_capacity, top;
 } dfs_ctx_t;
 
+/**
+ * struct graph_csr_s - Contiguous (compressed sparse row) adjacency snapshot
+ *
+ * @nb_vertices: Number of vertices
+ * @nb_edges: Number of edges
+ * @offsets: Edges of vertex `i` are `targets[offsets[i]]` up to (excluding)
+ *   `targets[offsets[i + 1]]`, `nb_vertices + 1` entries
+ * @targets: Destination vertex indices, in edge-list order
+ * @vertices: Vertex pointers, by index
+ */
+typedef struct graph_csr_s
+{
+	size_t nb_vertices, nb_edges;
+	size_t *offsets, *targets;
+	vertex_t **vertices;
+} graph_csr_t;
+
+/**
+ * struct scc_frame_s - Frame of the explicit Tarjan call stack
+ *
+ * @v: Vertex index
+ * @e: Cursor into the vertex's edges (absolute CSR offset)
+ */
+typedef struct scc_frame_s
+{
+	size_t v, e;
+} scc_frame_t;
+
+/**
+ * struct scc_ctx_s - Strongly-connected-components (Tarjan) context
+ *
+ * @csr: Pointer to adjacency snapshot
+ * @comp: Output array of component ids, by vertex index
+ * @order: Discovery order of each vertex (0 when undiscovered)
+ * @low: Lowest discovery order reachable from each vertex
+ * @stack: Tarjan vertex stack
+ * @frames: Explicit call stack
+ * @on_stack: Flags for vertices currently on `stack`
+ * @top: Number of vertices on `stack`
+ * @counter: Last discovery order given out
+ * @nb_comps: Number of components found so far
+ */
+typedef struct scc_ctx_s
+{
+	const graph_csr_t *csr;
+	size_t *comp, *order, *low, *stack;
+	scc_frame_t *frames;
+	unsigned char *on_stack;
+	size_t top, counter, nb_comps;
+} scc_ctx_t;
+
+/**
+ * struct reach_label_s - Growable hub list used while building labels
+ *
+ * @hubs: Hub ranks, ascending
+ * @size: Number of hubs
+ * @capacity: Allocated number of hubs
+ */
+typedef struct reach_label_s
+{
+	unsigned int *hubs;
+	size_t size, capacity;
+} reach_label_t;
+
+/**
+ * struct reach_index_s - 2-hop reachability index over the SCC condensation
+ * `a` reaches `b` iff they share a component, or the out-label of a's
+ * component and the in-label of b's component share a hub
+ *
+ * @nb_vertices: Number of vertices of the indexed graph
+ * @nb_comps: Number of strongly connected components
+ * @comp: Component id, by vertex index (reverse topological order)
+ * @out_offsets: Out-label of component `c` is `out_hubs[out_offsets[c]]` up
+ *   to (excluding) `out_hubs[out_offsets[c + 1]]`
+ * @in_offsets: Same as `out_offsets`, for in-labels
+ * @out_hubs: Hub ranks reachable from each component, ascending
+ * @in_hubs: Hub ranks reaching each component, ascending
+ * @nb_entries: Total number of label entries (in + out)
+ * @build_ns: Wall-clock build time, in nanoseconds
+ */
+typedef struct reach_index_s
+{
+	size_t nb_vertices, nb_comps;
+	size_t *comp, *out_offsets, *in_offsets;
+	unsigned int *out_hubs, *in_hubs;
+	size_t nb_entries;
+	unsigned long build_ns;
+} reach_index_t;
+
+/**
+ * struct reach_rank_s - Sort key used to pick hub order
+ *
+ * @key: Hub priority (higher comes first)
+ * @comp: Component id
+ */
+typedef struct reach_rank_s
+{
+	size_t key, comp;
+} reach_rank_t;
+
+/**
+ * struct reach_build_ctx_s - Pruned landmark labelling context
+ *
+ * @dag: Condensation edges, by component
+ * @rdag: Reversed condensation edges, by component
+ * @order: Components, by hub rank
+ * @queue: BFS queue
+ * @stamp: Last BFS that visited each component
+ * @out: Out-labels being built
+ * @in: In-labels being built
+ */
+typedef struct reach_build_ctx_s
+{
+	graph_csr_t *dag, *rdag;
+	size_t *order, *queue;
+	unsigned int *stamp;
+	reach_label_t *out, *in;
+} reach_build_ctx_t;
+
+/**
+ * struct reach_stats_s - Reachability index report
+ *
+ * @nb_comps: Number of strongly connected components
+ * @nb_entries: Total number of label entries
+ * @size_bytes: Memory held by the index
+ * @avg_label: Average label size (entries per component and direction)
+ * @build_ns: Build time, in nanoseconds
+ * @query_ns: Average query latency over the sampled queries, in nanoseconds
+ */
+typedef struct reach_stats_s
+{
+	size_t nb_comps, nb_entries, size_bytes;
+	double avg_label;
+	unsigned long build_ns;
+	double query_ns;
+} reach_stats_t;
+
+/* Marks the unused tail of a walk that reached a vertex without edges */
+#define WALK_END ((size_t)-1)
+
+/**
+ * struct walk_alias_s - Alias-table slot (Vose's alias method)
+ *
+ * @prob: Probability of keeping this slot rather than its alias
+ * @alias: Position of the alias slot among the vertex's edges
+ */
+typedef struct walk_alias_s
+{
+	float prob;
+	unsigned int alias;
+} walk_alias_t;
+
+/**
+ * struct walk_engine_s - Random-walk engine over a contiguous snapshot
+ *
+ * @csr: Adjacency snapshot, each vertex's targets sorted ascending
+ * @p: node2vec return parameter
+ * @q: node2vec in-out parameter
+ * @table_offsets: Alias table used after crossing CSR edge `e` starts at
+ *   `tables[table_offsets[e]]` and has one slot per edge of `e`'s target.
+ *   NULL for uniform walks (`p` == `q` == 1)
+ * @tables: Second-order alias tables
+ */
+typedef struct walk_engine_s
+{
+	graph_csr_t *csr;
+	double p, q;
+	size_t *table_offsets;
+	walk_alias_t *tables;
+} walk_engine_t;
+
+/**
+ * struct walk_alias_ctx_s - Scratch space for building one alias table
+ *
+ * @weight: Scaled weights, one per slot
+ * @small: Work list of under-full slots
+ * @large: Work list of over-full slots
+ */
+typedef struct walk_alias_ctx_s
+{
+	double *weight;
+	size_t *small, *large;
+} walk_alias_ctx_t;
+
+/**
+ * struct walk_thread_s - Per-thread walk job
+ *
+ * @engine: Pointer to walk engine
+ * @starts: Start vertex of each walk (NULL: walk `i` starts at `i % V`)
+ * @first: First walk handled by this thread
+ * @last: One past the last walk handled by this thread
+ * @length: Number of vertices per walk
+ * @rng: xorshift64* seed; the thread's final state once it returns
+ * @out: Output buffer shared by all threads (row `i` holds walk `i`)
+ * @steps: Number of vertices written by this thread, set once it returns
+ */
+typedef struct walk_thread_s
+{
+	const walk_engine_t *engine;
+	const size_t *starts;
+	size_t first, last, length;
+	unsigned long rng;
+	size_t *out, steps;
+} walk_thread_t;
+
+/* Magic bytes opening an on-disk adjacency snapshot */
+#define GRAPH_CSR_MAGIC "GRAPHCSR"
+
+typedef void (*ext_action_t)(size_t index, size_t depth);
+
+/**
+ * struct graph_csr_header_s - Header of an on-disk adjacency snapshot
+ * It is followed by `nb_vertices + 1` offsets, then `nb_edges` targets,
+ * all native size_t values
+ *
+ * @magic: GRAPH_CSR_MAGIC, without its terminating null byte
+ * @nb_vertices: Number of vertices
+ * @nb_edges: Number of edges
+ */
+typedef struct graph_csr_header_s
+{
+	char magic[8];
+	size_t nb_vertices, nb_edges;
+} graph_csr_header_t;
+
+/**
+ * struct ext_graph_s - Semi-external graph: vertex state in RAM,
+ * adjacency streamed from disk through a bounded window
+ *
+ * @fd: File descriptor of the snapshot
+ * @nb_vertices: Number of vertices
+ * @nb_edges: Number of edges
+ * @offsets: In-memory offsets, `nb_vertices + 1` entries
+ * @targets_pos: File position of the first target
+ * @window: Window of targets currently in memory
+ * @window_cap: Capacity of `window`, in targets
+ * @window_first: Edge offset of `window[0]`
+ * @window_count: Number of valid targets in `window`
+ * @bytes_read: Adjacency bytes read from disk so far
+ */
+typedef struct ext_graph_s
+{
+	int fd;
+	size_t nb_vertices, nb_edges;
+	size_t *offsets;
+	long targets_pos;
+	size_t *window;
+	size_t window_cap, window_first, window_count;
+	size_t bytes_read;
+} ext_graph_t;
+
+/**
+ * struct ext_frame_s - Frame of the semi-external depth-first stack
+ *
+ * @v: Vertex index
+ * @e: Next edge offset to follow
+ */
+typedef struct ext_frame_s
+{
+	size_t v, e;
+} ext_frame_t;
+
+/* Size of the staging buffer used when exporting to a file descriptor */
+#define GRAPH_WRITER_BUFSIZE (1 << 16)
+
+/**
+ * enum graph_format_e - Graph export formats
+ *
+ * @GRAPH_FORMAT_EDGES: One "src dest" line of vertex indices per edge
+ * @GRAPH_FORMAT_DOT: Graphviz digraph, vertices labelled with their content
+ * @GRAPH_FORMAT_JSON: {"vertices": [...], "edges": [[src, dest], ...]}
+ */
+typedef enum graph_format_e
+{
+	GRAPH_FORMAT_EDGES = 0,
+	GRAPH_FORMAT_DOT,
+	GRAPH_FORMAT_JSON
+} graph_format_t;
+
+/**
+ * struct graph_writer_s - Buffered output for graph exporters
+ *
+ * @fd: Destination file descriptor, -1 when writing to memory
+ * @buf: Staging buffer (fd) or caller's buffer (memory)
+ * @cap: Capacity of `buf`
+ * @len: Bytes currently in `buf`
+ * @total: Bytes produced so far, including any past a full memory buffer
+ * @error: Set once a write(2) fails
+ */
+typedef struct graph_writer_s
+{
+	int fd;
+	char *buf;
+	size_t cap, len, total;
+	int error;
+} graph_writer_t;
+
 /**
  * graph_create - Graph-structure allocation function
  *
@@ -183,4 +480,310 @@ breadth_first_traverse(const graph_t *graph, action_t action);
 void
 graph_display(const graph_t *graph);
 
+/**
+ * graph_clock_ns - Reads the monotonic clock
+ *
+ * Return: Current monotonic time, in nanoseconds
+ */
+unsigned long
+graph_clock_ns(void);
+
+/**
+ * graph_csr_alloc - Allocates an empty adjacency snapshot
+ *
+ * @nb_vertices: Number of vertices
+ * @nb_edges: Number of edges
+ *
+ * Return: Pointer to snapshot structure or NULL if allocation fails
+ */
+graph_csr_t
+*graph_csr_alloc(size_t nb_vertices, size_t nb_edges);
+
+/**
+ * graph_csr_create - Builds a contiguous adjacency snapshot of a graph
+ *
+ * @graph: Pointer to graph structure
+ *
+ * Return: Pointer to snapshot structure or NULL on failure
+ */
+graph_csr_t
+*graph_csr_create(const graph_t *graph);
+
+/**
+ * graph_csr_delete - Adjacency-snapshot free function
+ *
+ * @csr: Pointer to snapshot structure
+ */
+void
+graph_csr_delete(graph_csr_t *csr);
+
+/**
+ * graph_scc - Labels strongly connected components (iterative Tarjan)
+ *
+ * @csr: Pointer to adjacency snapshot
+ * @comp: Array of `csr->nb_vertices` component ids to fill, by vertex index.
+ *   Components come out in reverse topological order: if component `a`
+ *   reaches component `b != a`, then `b < a`
+ *
+ * Return: Number of components, or 0 on failure
+ */
+size_t
+graph_scc(const graph_csr_t *csr, size_t *comp);
+
+/**
+ * reach_index_create - Builds a 2-hop reachability index of a graph
+ *
+ * @graph: Pointer to graph structure
+ *
+ * Return: Pointer to index structure or NULL on failure
+ */
+reach_index_t
+*reach_index_create(const graph_t *graph);
+
+/**
+ * reach_index_delete - Reachability-index free function
+ *
+ * @index: Pointer to index structure
+ */
+void
+reach_index_delete(reach_index_t *index);
+
+/**
+ * reach_labels_build - Pruned landmark labelling over the condensation
+ *
+ * @index: Pointer to index whose `nb_comps` is set; labels are stored in it
+ * @dag: Condensation edges, by component
+ * @rdag: Reversed condensation edges, by component
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int
+reach_labels_build(reach_index_t *index, graph_csr_t *dag, graph_csr_t *rdag);
+
+/**
+ * reach_hubs_meet - Tests whether two ascending hub lists intersect
+ *
+ * @a: First hub list
+ * @na: Size of `a`
+ * @b: Second hub list
+ * @nb: Size of `b`
+ *
+ * Return: 1 if a hub appears in both lists, otherwise 0
+ */
+int
+reach_hubs_meet(const unsigned int *a, size_t na, const unsigned int *b,
+	size_t nb);
+
+/**
+ * graph_reachable - Answers "can `a` reach `b`?" in O(label size)
+ *
+ * @index: Pointer to reachability index of the graph
+ * @a: Pointer to source vertex
+ * @b: Pointer to destination vertex
+ *
+ * Return: 1 if there is a path from `a` to `b` (a vertex reaches itself),
+ *   0 if not or on failure
+ */
+int
+graph_reachable(const reach_index_t *index, const vertex_t *a,
+	const vertex_t *b);
+
+/**
+ * reach_index_stats - Reports index size, build time and query latency
+ *
+ * @index: Pointer to reachability index
+ * @stats: Pointer to report structure to fill
+ * @nb_samples: Number of pseudo-random queries to time (0 skips timing)
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int
+reach_index_stats(const reach_index_t *index, reach_stats_t *stats,
+	size_t nb_samples);
+
+/**
+ * walk_engine_create - Builds a random-walk engine for a graph
+ *
+ * @graph: Pointer to graph structure
+ * @p: node2vec return parameter (> 0, 1 for DeepWalk)
+ * @q: node2vec in-out parameter (> 0, 1 for DeepWalk)
+ *
+ * Return: Pointer to engine structure or NULL on failure
+ */
+walk_engine_t
+*walk_engine_create(const graph_t *graph, double p, double q);
+
+/**
+ * walk_engine_delete - Walk-engine free function
+ *
+ * @engine: Pointer to engine structure
+ */
+void
+walk_engine_delete(walk_engine_t *engine);
+
+/**
+ * walk_alias_build - Builds one alias table from slot weights
+ *
+ * @ctx: Scratch space, `weight` holding the `n` weights on entry
+ * @n: Number of slots
+ * @table: Alias table of `n` slots to fill
+ */
+void
+walk_alias_build(walk_alias_ctx_t *ctx, size_t n, walk_alias_t *table);
+
+/**
+ * walk_engine_run - Generates random walks in parallel
+ *
+ * @engine: Pointer to engine structure
+ * @starts: Start vertex index of each walk, or NULL to start walk `i` at
+ *   vertex `i % nb_vertices`
+ * @nb_walks: Number of walks
+ * @length: Number of vertices per walk (start included)
+ * @nb_threads: Number of worker threads (0 or 1 runs on the caller's thread)
+ * @seed: Random seed; equal seeds and thread counts give equal walks
+ * @out: Caller-owned buffer of `nb_walks * length` indices. Walks that hit
+ *   a vertex without edges are padded with WALK_END
+ *
+ * Return: Number of vertices written, or 0 on failure
+ */
+size_t
+walk_engine_run(const walk_engine_t *engine, const size_t *starts,
+	size_t nb_walks, size_t length, size_t nb_threads, unsigned long seed,
+	size_t *out);
+
+/**
+ * graph_csr_save - Writes an adjacency snapshot to a file
+ *
+ * @csr: Pointer to snapshot structure
+ * @path: Path of the file to create or truncate
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int
+graph_csr_save(const graph_csr_t *csr, const char *path);
+
+/**
+ * ext_graph_open - Opens an on-disk snapshot for semi-external traversal
+ *
+ * @path: Path of a file written by graph_csr_save
+ * @mem_budget: Bytes allowed for buffered adjacency (at least one page
+ *   is used). Offsets and visited flags are held in RAM on top of it
+ *
+ * Return: Pointer to semi-external graph or NULL on failure
+ */
+ext_graph_t
+*ext_graph_open(const char *path, size_t mem_budget);
+
+/**
+ * ext_graph_close - Semi-external graph free function
+ *
+ * @graph: Pointer to semi-external graph
+ */
+void
+ext_graph_close(ext_graph_t *graph);
+
+/**
+ * ext_graph_edges - Maps a range of targets into the window
+ *
+ * @graph: Pointer to semi-external graph
+ * @first: Edge offset of the first target wanted
+ * @hint_end: Edge offset up to which the caller expects to read next
+ * @count: Pointer to store the number of targets available at the return
+ *   value (at least 1 on success)
+ *
+ * Return: Pointer to the target at `first`, NULL on failure
+ */
+const size_t
+*ext_graph_edges(ext_graph_t *graph, size_t first, size_t hint_end,
+	size_t *count);
+
+/**
+ * ext_depth_first_traverse - Semi-external depth-first traversal
+ *
+ * @graph: Pointer to semi-external graph
+ * @action: Function called for each vertex reached from vertex 0
+ *
+ * Return: The greatest vertex depth or 0UL on failure
+ */
+size_t
+ext_depth_first_traverse(ext_graph_t *graph, ext_action_t action);
+
+/**
+ * ext_breadth_first_traverse - Semi-external breadth-first traversal
+ *
+ * @graph: Pointer to semi-external graph
+ * @action: Function called for each vertex reached from vertex 0
+ *
+ * Return: The greatest vertex depth or 0UL on failure
+ */
+size_t
+ext_breadth_first_traverse(ext_graph_t *graph, ext_action_t action);
+
+/**
+ * graph_writer_flush - Hands buffered bytes to the file descriptor
+ *
+ * @w: Pointer to writer
+ */
+void
+graph_writer_flush(graph_writer_t *w);
+
+/**
+ * graph_writer_put - Appends bytes to a writer
+ *
+ * @w: Pointer to writer
+ * @str: Bytes to append
+ * @len: Number of bytes
+ */
+void
+graph_writer_put(graph_writer_t *w, const char *str, size_t len);
+
+/**
+ * graph_writer_put_index - Appends a decimal unsigned integer to a writer
+ *
+ * @w: Pointer to writer
+ * @n: Integer to format
+ */
+void
+graph_writer_put_index(graph_writer_t *w, size_t n);
+
+/**
+ * graph_writer_put_escaped - Appends a double-quoted, escaped string
+ *
+ * @w: Pointer to writer
+ * @str: String to quote
+ * @format: GRAPH_FORMAT_DOT or GRAPH_FORMAT_JSON, whose escapes to use
+ */
+void
+graph_writer_put_escaped(graph_writer_t *w, const char *str,
+	graph_format_t format);
+
+/**
+ * graph_export_fd - Writes a graph to a file descriptor
+ * Output is staged in a GRAPH_WRITER_BUFSIZE buffer, one write(2) per chunk
+ *
+ * @graph: Pointer to graph structure
+ * @format: Export format
+ * @fd: Destination file descriptor
+ *
+ * Return: Number of bytes written, or -1 on failure
+ */
+long
+graph_export_fd(const graph_t *graph, graph_format_t format, int fd);
+
+/**
+ * graph_export_mem - Writes a graph to a caller-provided buffer
+ * Like snprintf, output is truncated (and null-terminated) to fit `size`
+ *
+ * @graph: Pointer to graph structure
+ * @format: Export format
+ * @buf: Destination buffer (may be NULL if `size` is 0)
+ * @size: Size of `buf`
+ *
+ * Return: Length of the full output, excluding the null byte, or -1 on
+ *   failure. A return value of `size` or more means it was truncated
+ */
+long
+graph_export_mem(const graph_t *graph, graph_format_t format, char *buf,
+	size_t size);
+
 #endif /* SYSTEMALGORITHMS_GRAPHS_H */
@@ -0,0 +1,139 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * condense - Builds the edge set between strongly connected components
+ *
+ * @csr: Pointer to adjacency snapshot
+ * @comp: Component ids, by vertex index
+ * @nb_comps: Number of components
+ * @reverse: Non-0 to build the reversed edges
+ *
+ * Return: Pointer to condensation snapshot or NULL on failure
+ */
+static graph_csr_t
+*condense(const graph_csr_t *csr, const size_t *comp, size_t nb_comps,
+	int reverse);
+
+/**
+ * reach_index_create - Builds a 2-hop reachability index of a graph
+ *
+ * @graph: Pointer to graph structure
+ *
+ * Return: Pointer to index structure or NULL on failure
+ */
+reach_index_t
+*reach_index_create(const graph_t *graph)
+{
+	reach_index_t *index = NULL;
+	graph_csr_t *csr = NULL, *dag = NULL, *rdag = NULL;
+	unsigned long start = graph_clock_ns();
+	int ok = 0;
+
+	csr = graph_csr_create(graph);
+
+	if (!csr)
+		return (NULL);
+
+	index = calloc(1, sizeof(reach_index_t) +
+		csr->nb_vertices * sizeof(size_t));
+
+	if (!index)
+		goto out;
+
+	index->nb_vertices = csr->nb_vertices;
+	index->comp = (size_t *)(index + 1);
+	index->nb_comps = graph_scc(csr, index->comp);
+
+	if (index->nb_comps || !csr->nb_vertices)
+	{
+		dag = condense(csr, index->comp, index->nb_comps, 0);
+		rdag = condense(csr, index->comp, index->nb_comps, 1);
+
+		if (dag && rdag)
+			ok = reach_labels_build(index, dag, rdag);
+	}
+
+	index->build_ns = graph_clock_ns() - start;
+out:
+	graph_csr_delete(csr);
+	graph_csr_delete(dag);
+	graph_csr_delete(rdag);
+
+	if (ok)
+		return (index);
+
+	reach_index_delete(index);
+	return (NULL);
+}
+
+/**
+ * reach_index_delete - Reachability-index free function
+ *
+ * @index: Pointer to index structure
+ */
+void
+reach_index_delete(reach_index_t *index)
+{
+	if (!index)
+		return;
+
+	/* Offsets and hubs share one block, headed by `out_offsets` */
+	free(index->out_offsets);
+	free(index);
+}
+
+/**
+ * condense - Builds the edge set between strongly connected components
+ *
+ * @csr: Pointer to adjacency snapshot
+ * @comp: Component ids, by vertex index
+ * @nb_comps: Number of components
+ * @reverse: Non-0 to build the reversed edges
+ *
+ * Return: Pointer to condensation snapshot or NULL on failure
+ */
+static graph_csr_t
+*condense(const graph_csr_t *csr, const size_t *comp, size_t nb_comps,
+	int reverse)
+{
+	graph_csr_t *dag = NULL;
+	size_t v, e, from, to, nb_edges = 0, *fill = NULL;
+
+	for (v = 0; v < csr->nb_vertices; ++v)
+		for (e = csr->offsets[v]; e < csr->offsets[v + 1]; ++e)
+			nb_edges += comp[v] != comp[csr->targets[e]];
+
+	dag = graph_csr_alloc(nb_comps, nb_edges);
+	fill = calloc(nb_comps + 1, sizeof(size_t));
+
+	if (!dag || !fill)
+	{
+		graph_csr_delete(dag);
+		free(fill);
+		return (NULL);
+	}
+
+	/* Counting pass into `offsets`, then a prefix sum, then a fill pass */
+	for (v = 0; v < csr->nb_vertices; ++v)
+		for (e = csr->offsets[v]; e < csr->offsets[v + 1]; ++e)
+			if (comp[v] != comp[csr->targets[e]])
+				++dag->offsets[1 +
+					comp[reverse ? csr->targets[e] : v]];
+
+	for (v = 0; v < nb_comps; ++v)
+		fill[v + 1] = dag->offsets[v + 1] += dag->offsets[v];
+
+	for (v = 0; v < csr->nb_vertices; ++v)
+		for (e = csr->offsets[v]; e < csr->offsets[v + 1]; ++e)
+		{
+			from = comp[v], to = comp[csr->targets[e]];
+
+			if (from != to)
+				dag->targets[fill[reverse ? to : from]++] =
+					reverse ? from : to;
+		}
+
+	free(fill);
+	return (dag);
+}
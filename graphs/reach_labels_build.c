@@ -0,0 +1,256 @@
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graphs.h"
+
+/**
+ * rank_cmp - qsort comparator putting high-priority hubs first
+ *
+ * @a: Pointer to first reach_rank_t
+ * @b: Pointer to second reach_rank_t
+ *
+ * Return: Negative, 0 or positive, as for qsort
+ */
+static int
+rank_cmp(const void *a, const void *b);
+
+/**
+ * label_push - Appends a hub rank to a growable label
+ *
+ * @label: Pointer to label
+ * @rank: Hub rank
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int
+label_push(reach_label_t *label, unsigned int rank);
+
+/**
+ * pruned_bfs - Labels everything a hub reaches (or is reached by)
+ *
+ * @ctx: Pointer to build context
+ * @rank: Rank of the hub
+ * @backward: 0 to search along edges (in-labels), 1 against them (out-labels)
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int
+pruned_bfs(reach_build_ctx_t *ctx, unsigned int rank, int backward);
+
+/**
+ * labels_flatten - Moves built labels into the index's contiguous arrays
+ *
+ * @index: Pointer to index structure
+ * @ctx: Pointer to build context
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int
+labels_flatten(reach_index_t *index, reach_build_ctx_t *ctx);
+
+/**
+ * reach_labels_build - Pruned landmark labelling over the condensation
+ *
+ * @index: Pointer to index whose `nb_comps` is set; labels are stored in it
+ * @dag: Condensation edges, by component
+ * @rdag: Reversed condensation edges, by component
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int
+reach_labels_build(reach_index_t *index, graph_csr_t *dag, graph_csr_t *rdag)
+{
+	reach_build_ctx_t ctx = { NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+	reach_rank_t *ranks = NULL;
+	size_t n = index->nb_comps, c;
+	int ok = n < UINT_MAX / 2;
+
+	ctx.dag = dag, ctx.rdag = rdag;
+	ctx.order = malloc((2 * n + 1) * sizeof(size_t));
+	ctx.stamp = calloc(n + 1, sizeof(unsigned int));
+	ctx.out = calloc(2 * n + 1, sizeof(reach_label_t));
+	ranks = malloc((n + 1) * sizeof(reach_rank_t));
+	ok = ok && ctx.order && ctx.stamp && ctx.out && ranks;
+
+	if (ok)
+	{
+		/* Hubs on many paths prune the most: rank by degree product */
+		for (c = 0; c < n; ++c)
+		{
+			ranks[c].comp = c;
+			ranks[c].key = 1 + dag->offsets[c + 1] -
+				dag->offsets[c];
+			ranks[c].key *= 1 + rdag->offsets[c + 1] -
+				rdag->offsets[c];
+		}
+
+		qsort(ranks, n, sizeof(reach_rank_t), rank_cmp);
+		ctx.queue = ctx.order + n;
+		ctx.in = ctx.out + n;
+
+		for (c = 0; c < n; ++c)
+			ctx.order[c] = ranks[c].comp;
+
+		for (c = 0; ok && c < n; ++c)
+			ok = pruned_bfs(&ctx, (unsigned int)c, 0) &&
+				pruned_bfs(&ctx, (unsigned int)c, 1);
+
+		ok = ok && labels_flatten(index, &ctx);
+	}
+
+	for (c = 0; ctx.out && c < 2 * n; ++c)
+		free(ctx.out[c].hubs);
+
+	free(ranks), free(ctx.order), free(ctx.stamp), free(ctx.out);
+	return (ok);
+}
+
+/**
+ * rank_cmp - qsort comparator putting high-priority hubs first
+ *
+ * @a: Pointer to first reach_rank_t
+ * @b: Pointer to second reach_rank_t
+ *
+ * Return: Negative, 0 or positive, as for qsort
+ */
+static int
+rank_cmp(const void *a, const void *b)
+{
+	const reach_rank_t *ra = a, *rb = b;
+
+	if (ra->key != rb->key)
+		return (ra->key > rb->key ? -1 : 1);
+
+	return ((ra->comp > rb->comp) - (ra->comp < rb->comp));
+}
+
+/**
+ * label_push - Appends a hub rank to a growable label
+ *
+ * @label: Pointer to label
+ * @rank: Hub rank
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int
+label_push(reach_label_t *label, unsigned int rank)
+{
+	unsigned int *hubs = NULL;
+	size_t capacity;
+
+	if (label->size == label->capacity)
+	{
+		capacity = label->capacity ? label->capacity * 2 : 4;
+		hubs = realloc(label->hubs, capacity * sizeof(unsigned int));
+
+		if (!hubs)
+			return (0);
+
+		label->hubs = hubs;
+		label->capacity = capacity;
+	}
+
+	label->hubs[label->size++] = rank;
+	return (1);
+}
+
+/**
+ * pruned_bfs - Labels everything a hub reaches (or is reached by)
+ *
+ * @ctx: Pointer to build context
+ * @rank: Rank of the hub
+ * @backward: 0 to search along edges (in-labels), 1 against them (out-labels)
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int
+pruned_bfs(reach_build_ctx_t *ctx, unsigned int rank, int backward)
+{
+	const graph_csr_t *g = backward ? ctx->rdag : ctx->dag;
+	reach_label_t *from, *to;
+	unsigned int stamp = 2 * rank + 1 + (unsigned int)backward;
+	size_t hub = ctx->order[rank], head = 0, tail = 0, u, e;
+
+	ctx->queue[tail++] = hub;
+	ctx->stamp[hub] = stamp;
+
+	while (head < tail)
+	{
+		u = ctx->queue[head++];
+		from = backward ? ctx->out + u : ctx->out + hub;
+		to = backward ? ctx->in + hub : ctx->in + u;
+
+		/* Already answered by a higher-ranked hub: prune the subtree */
+		if (u != hub && reach_hubs_meet(from->hubs, from->size,
+			to->hubs, to->size))
+			continue;
+
+		if (!label_push(backward ? from : to, rank))
+			return (0);
+
+		for (e = g->offsets[u]; e < g->offsets[u + 1]; ++e)
+		{
+			if (ctx->stamp[g->targets[e]] != stamp)
+			{
+				ctx->stamp[g->targets[e]] = stamp;
+				ctx->queue[tail++] = g->targets[e];
+			}
+		}
+	}
+
+	return (1);
+}
+
+/**
+ * labels_flatten - Moves built labels into the index's contiguous arrays
+ *
+ * @index: Pointer to index structure
+ * @ctx: Pointer to build context
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int
+labels_flatten(reach_index_t *index, reach_build_ctx_t *ctx)
+{
+	size_t n = index->nb_comps, c, total = 0, out_total = 0;
+	void *block = NULL;
+
+	for (c = 0; c < n; ++c)
+	{
+		out_total += ctx->out[c].size;
+		total += ctx->out[c].size + ctx->in[c].size;
+	}
+
+	block = malloc(2 * (n + 1) * sizeof(size_t) +
+		total * sizeof(unsigned int));
+
+	if (!block)
+		return (0);
+
+	index->out_offsets = block;
+	index->in_offsets = index->out_offsets + n + 1;
+	index->out_hubs = (unsigned int *)(index->in_offsets + n + 1);
+	index->in_hubs = index->out_hubs + out_total;
+	index->out_offsets[0] = index->in_offsets[0] = 0;
+
+	for (c = 0; c < n; ++c)
+	{
+		index->out_offsets[c + 1] = index->out_offsets[c] +
+			ctx->out[c].size;
+		index->in_offsets[c + 1] = index->in_offsets[c] +
+			ctx->in[c].size;
+
+		if (ctx->out[c].size)
+			memcpy(index->out_hubs + index->out_offsets[c],
+				ctx->out[c].hubs,
+				ctx->out[c].size * sizeof(unsigned int));
+
+		if (ctx->in[c].size)
+			memcpy(index->in_hubs + index->in_offsets[c],
+				ctx->in[c].hubs,
+				ctx->in[c].size * sizeof(unsigned int));
+	}
+
+	index->nb_entries = total;
+	return (1);
+}
@@ -0,0 +1,49 @@
+#include "graphs.h"
+
+/**
+ * walk_alias_build - Builds one alias table from slot weights
+ *
+ * @ctx: Scratch space, `weight` holding the `n` weights on entry
+ * @n: Number of slots
+ * @table: Alias table of `n` slots to fill
+ */
+void
+walk_alias_build(walk_alias_ctx_t *ctx, size_t n, walk_alias_t *table)
+{
+	double sum = 0.0;
+	size_t i, nb_small = 0, nb_large = 0, s, l;
+
+	for (i = 0; i < n; ++i)
+		sum += ctx->weight[i];
+
+	/* Scale so that an average slot weighs exactly 1 */
+	for (i = 0; i < n; ++i)
+	{
+		ctx->weight[i] *= (double)n / sum;
+		table[i].alias = (unsigned int)i;
+
+		if (ctx->weight[i] < 1.0)
+			ctx->small[nb_small++] = i;
+		else
+			ctx->large[nb_large++] = i;
+	}
+
+	while (nb_small && nb_large)
+	{
+		s = ctx->small[--nb_small];
+		l = ctx->large[nb_large - 1];
+		table[s].prob = (float)ctx->weight[s];
+		table[s].alias = (unsigned int)l;
+		ctx->weight[l] -= 1.0 - ctx->weight[s];
+
+		if (ctx->weight[l] < 1.0)
+			ctx->small[nb_small++] = l, --nb_large;
+	}
+
+	/* Leftovers are full slots, up to rounding */
+	while (nb_large)
+		table[ctx->large[--nb_large]].prob = 1.0f;
+
+	while (nb_small)
+		table[ctx->small[--nb_small]].prob = 1.0f;
+}
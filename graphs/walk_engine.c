@@ -0,0 +1,193 @@
+#include <stdlib.h>
+#include "graphs.h"
+
+/**
+ * index_cmp - qsort/bsearch comparator for vertex indices
+ *
+ * @a: Pointer to first size_t
+ * @b: Pointer to second size_t
+ *
+ * Return: Negative, 0 or positive, as for qsort
+ */
+static int
+index_cmp(const void *a, const void *b);
+
+/**
+ * has_edge - Tests for an edge in a snapshot with sorted targets
+ *
+ * @csr: Pointer to adjacency snapshot
+ * @from: Source vertex index
+ * @to: Destination vertex index
+ *
+ * Return: 1 if the edge exists, otherwise 0
+ */
+static int
+has_edge(const graph_csr_t *csr, size_t from, size_t to);
+
+/**
+ * build_tables - Builds one node2vec alias table per edge
+ *
+ * @engine: Pointer to engine structure with sorted snapshot and p/q set
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int
+build_tables(walk_engine_t *engine);
+
+/**
+ * walk_engine_create - Builds a random-walk engine for a graph
+ *
+ * @graph: Pointer to graph structure
+ * @p: node2vec return parameter (> 0, 1 for DeepWalk)
+ * @q: node2vec in-out parameter (> 0, 1 for DeepWalk)
+ *
+ * Return: Pointer to engine structure or NULL on failure
+ */
+walk_engine_t
+*walk_engine_create(const graph_t *graph, double p, double q)
+{
+	walk_engine_t *engine = NULL;
+	graph_csr_t *csr = NULL;
+	size_t v;
+
+	if (!graph || !(p > 0.0) || !(q > 0.0))
+		return (NULL);
+
+	engine = calloc(1, sizeof(walk_engine_t));
+	csr = graph_csr_create(graph);
+
+	if (!engine || !csr)
+	{
+		free(engine);
+		graph_csr_delete(csr);
+		return (NULL);
+	}
+
+	/* Sorted targets give O(log d) edge tests while building tables */
+	for (v = 0; v < csr->nb_vertices; ++v)
+		qsort(csr->targets + csr->offsets[v],
+			csr->offsets[v + 1] - csr->offsets[v], sizeof(size_t),
+			index_cmp);
+
+	engine->csr = csr;
+	engine->p = p;
+	engine->q = q;
+
+	if ((p != 1.0 || q != 1.0) && !build_tables(engine))
+	{
+		walk_engine_delete(engine);
+		return (NULL);
+	}
+
+	return (engine);
+}
+
+/**
+ * walk_engine_delete - Walk-engine free function
+ *
+ * @engine: Pointer to engine structure
+ */
+void
+walk_engine_delete(walk_engine_t *engine)
+{
+	if (!engine)
+		return;
+
+	graph_csr_delete(engine->csr);
+	free(engine->table_offsets);
+	free(engine->tables);
+	free(engine);
+}
+
+/**
+ * index_cmp - qsort/bsearch comparator for vertex indices
+ *
+ * @a: Pointer to first size_t
+ * @b: Pointer to second size_t
+ *
+ * Return: Negative, 0 or positive, as for qsort
+ */
+static int
+index_cmp(const void *a, const void *b)
+{
+	size_t ia = *(const size_t *)a, ib = *(const size_t *)b;
+
+	return ((ia > ib) - (ia < ib));
+}
+
+/**
+ * has_edge - Tests for an edge in a snapshot with sorted targets
+ *
+ * @csr: Pointer to adjacency snapshot
+ * @from: Source vertex index
+ * @to: Destination vertex index
+ *
+ * Return: 1 if the edge exists, otherwise 0
+ */
+static int
+has_edge(const graph_csr_t *csr, size_t from, size_t to)
+{
+	return (bsearch(&to, csr->targets + csr->offsets[from],
+		csr->offsets[from + 1] - csr->offsets[from], sizeof(size_t),
+		index_cmp) != NULL);
+}
+
+/**
+ * build_tables - Builds one node2vec alias table per edge
+ *
+ * @engine: Pointer to engine structure with sorted snapshot and p/q set
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int
+build_tables(walk_engine_t *engine)
+{
+	const graph_csr_t *csr = engine->csr;
+	walk_alias_ctx_t ctx = { NULL, NULL, NULL };
+	size_t t, e, v, x, deg, max_deg = 0, total = 0;
+	const size_t *adj = NULL;
+
+	engine->table_offsets = malloc((csr->nb_edges + 1) * sizeof(size_t));
+
+	if (!engine->table_offsets)
+		return (0);
+
+	/* Crossing edge t->v leaves a choice among v's edges */
+	for (e = 0; e < csr->nb_edges; ++e)
+	{
+		v = csr->targets[e];
+		deg = csr->offsets[v + 1] - csr->offsets[v];
+		engine->table_offsets[e] = total;
+		total += deg;
+		max_deg = deg > max_deg ? deg : max_deg;
+	}
+
+	engine->table_offsets[csr->nb_edges] = total;
+	engine->tables = malloc((total + 1) * sizeof(walk_alias_t));
+	ctx.weight = malloc((max_deg + 1) * sizeof(double));
+	ctx.small = malloc(2 * (max_deg + 1) * sizeof(size_t));
+	ctx.large = ctx.small ? ctx.small + max_deg + 1 : NULL;
+
+	for (t = 0; engine->tables && ctx.weight && ctx.small &&
+		t < csr->nb_vertices; ++t)
+	{
+		for (e = csr->offsets[t]; e < csr->offsets[t + 1]; ++e)
+		{
+			v = csr->targets[e];
+			adj = csr->targets + csr->offsets[v];
+			deg = csr->offsets[v + 1] - csr->offsets[v];
+
+			for (x = 0; x < deg; ++x)
+				ctx.weight[x] = adj[x] == t ? 1.0 / engine->p
+					: has_edge(csr, t, adj[x])
+					? 1.0 : 1.0 / engine->q;
+
+			walk_alias_build(&ctx, deg, engine->tables +
+				engine->table_offsets[e]);
+		}
+	}
+
+	free(ctx.weight);
+	free(ctx.small);
+	return (engine->tables && ctx.weight && ctx.small);
+}
@@ -0,0 +1,166 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "graphs.h"
+
+/* Uniform index below `n` (n < 2^32) from the high bits of a random word */
+#define RNG_BELOW(r, n) ((size_t)((((r) >> 32) * (unsigned long)(n)) >> 32))
+/* Uniform float in [0, 1) from 24 random bits */
+#define RNG_UNIT(r) ((float)((r) >> 40) * (1.0f / 16777216.0f))
+
+/**
+ * rng_next - Advances a xorshift64* generator
+ *
+ * @state: Pointer to generator state (never 0)
+ *
+ * Return: Next pseudo-random word
+ */
+static unsigned long
+rng_next(unsigned long *state);
+
+/**
+ * walk_worker - Thread body generating a contiguous range of walks
+ *
+ * @arg: Pointer to walk_thread_t job
+ *
+ * Return: `arg`
+ */
+static void
+*walk_worker(void *arg);
+
+/**
+ * walk_engine_run - Generates random walks in parallel
+ *
+ * @engine: Pointer to engine structure
+ * @starts: Start vertex index of each walk (each below nb_vertices), or
+ *   NULL to start walk `i` at vertex `i % nb_vertices`
+ * @nb_walks: Number of walks
+ * @length: Number of vertices per walk (start included)
+ * @nb_threads: Number of worker threads (0 or 1 runs on the caller's thread)
+ * @seed: Random seed; equal seeds and thread counts give equal walks
+ * @out: Caller-owned buffer of `nb_walks * length` indices. Walks that hit
+ *   a vertex without edges are padded with WALK_END
+ *
+ * Return: Number of vertices written, or 0 on failure
+ */
+size_t
+walk_engine_run(const walk_engine_t *engine, const size_t *starts,
+	size_t nb_walks, size_t length, size_t nb_threads, unsigned long seed,
+	size_t *out)
+{
+	walk_thread_t *jobs = NULL;
+	pthread_t *tids = NULL;
+	size_t i, started = 0, steps = 0;
+
+	if (!engine || !out || !length || !engine->csr->nb_vertices)
+		return (0);
+
+	for (i = 0; starts && i < nb_walks; ++i)
+		if (starts[i] >= engine->csr->nb_vertices)
+			return (0);
+
+	nb_threads = nb_threads ? nb_threads : 1;
+	nb_threads = nb_threads > nb_walks ? nb_walks : nb_threads;
+	jobs = calloc(nb_threads + 1, sizeof(walk_thread_t));
+	tids = calloc(nb_threads + 1, sizeof(pthread_t));
+
+	for (i = 0; jobs && tids && i < nb_threads; ++i)
+	{
+		jobs[i].engine = engine, jobs[i].starts = starts;
+		jobs[i].first = nb_walks * i / nb_threads;
+		jobs[i].last = nb_walks * (i + 1) / nb_threads;
+		jobs[i].length = length, jobs[i].out = out;
+		/* splitmix spread: neighbouring threads do not correlate */
+		jobs[i].rng = (seed + (i + 1) * 0x9e3779b97f4a7c15UL) | 1UL;
+
+		/* A chunk whose thread cannot start runs here instead */
+		if (nb_threads == 1 || pthread_create(tids + started, NULL,
+			walk_worker, jobs + i))
+			walk_worker(jobs + i);
+		else
+			++started;
+	}
+
+	for (i = 0; i < started; ++i)
+		pthread_join(tids[i], NULL);
+
+	for (i = 0; jobs && tids && i < nb_threads; ++i)
+		steps += jobs[i].steps;
+
+	free(jobs);
+	free(tids);
+	return (steps);
+}
+
+/**
+ * rng_next - Advances a xorshift64* generator
+ *
+ * @state: Pointer to generator state (never 0)
+ *
+ * Return: Next pseudo-random word
+ */
+static unsigned long
+rng_next(unsigned long *state)
+{
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return (*state * 0x2545f4914f6cdd1dUL);
+}
+
+/**
+ * walk_worker - Thread body generating a contiguous range of walks
+ *
+ * @arg: Pointer to walk_thread_t job
+ *
+ * Return: `arg`
+ */
+static void
+*walk_worker(void *arg)
+{
+	walk_thread_t *job = arg;
+	const walk_engine_t *engine = job->engine;
+	const graph_csr_t *csr = engine->csr;
+	const walk_alias_t *table = NULL;
+	size_t w, s, v, deg, pick, *row, edge = WALK_END, steps = 0;
+	unsigned long r, rng = job->rng;
+
+	for (w = job->first; w < job->last; ++w)
+	{
+		row = job->out + w * job->length;
+		v = job->starts ? job->starts[w] : w % csr->nb_vertices;
+
+		for (s = 0, edge = WALK_END; s < job->length; ++s)
+		{
+			row[s] = v;
+			deg = csr->offsets[v + 1] - csr->offsets[v];
+
+			if (s + 1 == job->length || !deg)
+				break;
+
+			r = rng_next(&rng);
+			pick = RNG_BELOW(r, deg);
+
+			/* Second-order step: alias table of the edge crossed */
+			if (engine->tables && edge != WALK_END)
+			{
+				table = engine->tables +
+					engine->table_offsets[edge];
+				pick = RNG_UNIT(r << 32) < table[pick].prob
+					? pick : table[pick].alias;
+			}
+
+			edge = csr->offsets[v] + pick;
+			v = csr->targets[edge];
+		}
+
+		steps += s + 1;
+
+		while (++s < job->length)
+			row[s] = WALK_END;
+	}
+
+	/* Jobs share cache lines: write them once, not on every step */
+	job->rng = rng;
+	job->steps = steps;
+	return (arg);
+}
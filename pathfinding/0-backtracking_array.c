@@ -1,14 +1,24 @@
-#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "pathfinding.h"
 
 #define OUT_OF_RANGE(ctx, x, y) (\
 	(x) < 0 || (x) >= (ctx)->cols || \
-	(y) < 0 || (y) >= (ctx)->cols\
+	(y) < 0 || (y) >= (ctx)->rows\
 )
 
-#define VISITED(ctx, x, y) ((ctx)->visited[((y) * (ctx)->rows) + (x)])
-#define IS_ACCESSIBLE(ctx, x, y) ((ctx)->map[y][x] == '0')
+#define CELL(ctx, x, y) ((size_t)(y) * (size_t)(ctx)->cols + (size_t)(x))
+#define VISITED(ctx, x, y) ((ctx)->seen ? GRID_OPEN((ctx)->seen, x, y) : \
+	SP_VISITED_SEEN((ctx)->visited, CELL(ctx, x, y)))
+#define MARK_VISITED(ctx, x, y) ((ctx)->seen ? \
+	(void)(GRID_WORD((ctx)->seen, x, y) |= GRID_BIT(x)) : \
+	(void)SP_VISITED_MARK((ctx)->visited, CELL(ctx, x, y)))
+#define IS_ACCESSIBLE(ctx, x, y) (\
+	(ctx)->grid ? GRID_OPEN((ctx)->grid, x, y) : (ctx)->map[y][x] == '0'\
+)
+#define TRACE_CELL(kind, x, y) SP_TRACE(\
+	kind, SP_TRACE_ARRAY, NULL, NULL, x, y, 0\
+)
 
 #define END_OF_THE_LINE(ctx, x, y) (\
 	OUT_OF_RANGE(ctx, x, y) || \
@@ -21,19 +31,12 @@
 	((ctx)->target->y == (y))\
 )
 
-#define ON_PATH_TO_TARGET(ctx, x, y) (\
-	backtrack_r((ctx), (x) + 1, (y)) || \
-	backtrack_r((ctx), (x), (y) + 1) || \
-	backtrack_r((ctx), (x) - 1, (y)) || \
-	backtrack_r((ctx), (x), (y) - 1)\
-)
-
 /* STATIC FUNCTIONS */
 
-static point_t *backtrack_r(array_backtrack_ctx_t *ctx, int x, int y);
-static point_t *path_push_front(array_backtrack_ctx_t *ctx, int x, int y);
-static array_backtrack_ctx_t *array_backtrack_ctx_create(char **map, int rows,
-	int cols, const point_t *target);
+static int array_backtrack_search(array_backtrack_ctx_t *ctx,
+	const point_t *start);
+static int array_backtrack_enter(array_backtrack_ctx_t *ctx, int x, int y);
+static int array_backtrack_path(array_backtrack_ctx_t *ctx);
 
 /* API IMPLEMENTATION */
 
@@ -51,122 +54,225 @@ static array_backtrack_ctx_t *array_backtrack_ctx_create(char **map, int rows,
 queue_t *backtracking_array(char **map, int rows, int cols,
 	point_t const *start, point_t const *target)
 {
-	array_backtrack_ctx_t *ctx = NULL;
+	sp_visited_t *visited = NULL;
 	queue_t *path = NULL;
 
-	if (!map || !start || !target)
+	if (!map || !start || !target || rows <= 0 || cols <= 0)
 		return (NULL);
 
-	ctx = array_backtrack_ctx_create(map, rows, cols, target);
+	visited = sp_visited_create((size_t)rows * (size_t)cols);
 
-	if (!ctx)
+	if (!visited)
 		return (NULL);
 
-	if (!backtrack_r(ctx, start->x, start->y))
-	{
-		queue_delete(ctx->path);
-		free(ctx);
-		return (NULL);
-	}
-
-	path = ctx->path;
-	free(ctx);
+	path = backtracking_array_workspace(visited, map, rows, cols, start,
+		target, 0);
+	sp_visited_delete(visited);
 	return (path);
 }
 
-/* STATIC FUNCTIONS */
+/**
+ * backtracking_array_workspace - backtracking_array reusing a caller's
+ * visited marks
+ *
+ * @visited: Visited marks with room for rows * cols cells
+ * @map: Pointer to 2D maze
+ * @rows: Number of rows in matrix
+ * @cols: Number of columns in matrix
+ * @start: Pointer to point_t for the start coordinates
+ * @target: Pointer to point_t for the target coordinates
+ * @max_steps: Cells that may be checked before giving up (0 for no limit)
+ *
+ * Return: Pointer to queue_t representing the path, NULL on failure, if
+ *   there is no path or if the step limit was hit
+ */
+queue_t *backtracking_array_workspace(sp_visited_t *visited, char **map,
+	int rows, int cols, point_t const *start, point_t const *target,
+	size_t max_steps)
+{
+	array_backtrack_ctx_t ctx = {
+		NULL, NULL, NULL, NULL, 0, 0, NULL, NULL, NULL, 0, 0, 0, 0
+	};
+
+	if (!visited || !map || !start || !target || rows <= 0 || cols <= 0 ||
+		visited->capacity / (size_t)cols < (size_t)rows)
+		return (NULL);
+
+	ctx.map = map;
+	ctx.visited = visited;
+	ctx.rows = rows;
+	ctx.cols = cols;
+	ctx.target = target;
+	ctx.max_steps = max_steps;
+	return (array_backtrack_run(&ctx, start));
+}
 
 /**
- * backtrack_r - Recursive backtracking function
+ * array_backtrack_run - Runs a backtracking search over the maze of a
+ * filled-in context (map and visited marks or grid and visited bitset,
+ * target and step limit)
+ * A visited bitset is cleared first, a word per GRID_WORD_BITS cells
  *
  * @ctx: Pointer to array_backtrack_ctx_t struct
- * @x: Current X coordinate
- * @y: Current Y coordinate
+ * @start: Pointer to point_t for the start coordinates
  *
- * Return: Pointer to point_t added to front of queue, NULL on failure
+ * Return: Pointer to queue_t representing the path, NULL on failure, if
+ *   there is no path or if the step limit was hit
  */
-static point_t *backtrack_r(array_backtrack_ctx_t *ctx, int x, int y)
+queue_t *array_backtrack_run(array_backtrack_ctx_t *ctx,
+	point_t const *start)
 {
-	if (END_OF_THE_LINE(ctx, x, y))
+	point_t *point = NULL;
+	int found;
+
+	ctx->path = queue_create();
+
+	if (!ctx->path)
 		return (NULL);
 
-	printf("Checking coordinates [%d, %d]\n", x, y);
+	if (ctx->seen)
+		memset(ctx->seen->bits, 0, (size_t)ctx->rows *
+			ctx->seen->stride * sizeof(unsigned long));
+	else
+		sp_visited_reset(ctx->visited);
+	ctx->size = 0;
+	ctx->steps = 0;
+	found = array_backtrack_search(ctx, start);
+	SP_TRACE_FLUSH();
 
-	if (TARGET_FOUND(ctx, x, y))
-		return (path_push_front(ctx, x, y));
+	if (found == 1)
+		found = array_backtrack_path(ctx);
 
-	VISITED(ctx, x, y) = 1;
+	if (found != 1)
+	{
+		while ((point = dequeue(ctx->path)))
+			free(point);
+		queue_delete(ctx->path);
+		ctx->path = NULL;
+	}
 
-	if (ON_PATH_TO_TARGET(ctx, x, y))
-		return (path_push_front(ctx, x, y));
+	free(ctx->stack);
+	ctx->stack = NULL;
+	ctx->cap = 0;
+	return (ctx->path);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * array_backtrack_search - Depth-first backtracking with an explicit stack
+ * Neighbours are tried right, down, left then up, and the search stops at
+ * the first one leading to the target, as the recursive version did
+ *
+ * @ctx: Pointer to array_backtrack_ctx_t struct
+ * @start: Pointer to point_t for the start coordinates
+ *
+ * Return: 1 if the target was reached, the frames left on the stack
+ *   leading to it, 0 if there is no path, -1 on failure
+ */
+static int array_backtrack_search(array_backtrack_ctx_t *ctx,
+	const point_t *start)
+{
+	static const int dx[] = { 1, 0, -1, 0 }, dy[] = { 0, 1, 0, -1 };
+	array_backtrack_frame_t *top = NULL;
+	int found = array_backtrack_enter(ctx, start->x, start->y);
+
+	while (!found && ctx->size)
+	{
+		top = &ctx->stack[ctx->size - 1];
+
+		if (top->dir < 4)
+		{
+			++top->dir;
+			found = array_backtrack_enter(ctx,
+				top->x + dx[top->dir - 1],
+				top->y + dy[top->dir - 1]);
+		}
+		else
+		{
+			--ctx->size;
+			TRACE_CELL(SP_TRACE_POP, top->x, top->y);
+		}
+	}
 
-	return (NULL);
+	return (found);
 }
 
 /**
- * path_push_front - Create point_t struct and put in front of queue
+ * array_backtrack_enter - Checks a cell, and pushes a frame to explore it
+ * unless it is blocked, visited or the target
  *
  * @ctx: Pointer to array_backtrack_ctx_t struct
- * @x: Current X coordinate
- * @y: Current Y coordinate
+ * @x: X coordinate
+ * @y: Y coordinate
  *
- * Return: Pointer to point_t added to front of queue, NULL on failure
+ * Return: 1 if it is the target, 0 otherwise, -1 on failure or once the
+ *   step limit is reached
  */
-static point_t *path_push_front(array_backtrack_ctx_t *ctx, int x, int y)
+static int array_backtrack_enter(array_backtrack_ctx_t *ctx, int x, int y)
 {
-	point_t *point = NULL;
+	array_backtrack_frame_t *stack = NULL;
+
+	if (END_OF_THE_LINE(ctx, x, y))
+		return (0);
 
-	point = calloc(1, sizeof(point_t));
+	if (ctx->max_steps && ++ctx->steps > ctx->max_steps)
+		return (-1);
 
-	if (!point)
-		return (NULL);
+	TRACE_CELL(SP_TRACE_EXPAND, x, y);
+
+	if (TARGET_FOUND(ctx, x, y))
+		return (1);
 
-	point->x = x;
-	point->y = y;
+	MARK_VISITED(ctx, x, y);
 
-	if (!queue_push_front(ctx->path, point))
+	if (ctx->size == ctx->cap)
 	{
-		free(point);
-		return (NULL);
+		stack = realloc(ctx->stack,
+			(ctx->cap * 2 + 16) * sizeof(array_backtrack_frame_t));
+		if (!stack)
+			return (-1);
+		ctx->stack = stack;
+		ctx->cap = ctx->cap * 2 + 16;
 	}
 
-	return (point);
+	stack = &ctx->stack[ctx->size++];
+	stack->x = x;
+	stack->y = y;
+	stack->dir = 0;
+	TRACE_CELL(SP_TRACE_PUSH, x, y);
+	return (0);
 }
 
 /**
- * array_backtrack_ctx_create - Allocate/initialize backtracking context
+ * array_backtrack_path - Queues the target, then the cells of the frames
+ * left on the stack, from the top down, each in front of the previous one
  *
- * @map: Pointer to 2D maze
- * @rows: Number of rows in matrix
- * @cols: Number of columns in matrix
- * @target: Pointer to point_t for the target coordinates
+ * @ctx: Pointer to array_backtrack_ctx_t struct
  *
- * Return: Pointer to array_backtrack_ctx_create structure
+ * Return: 1 on success, -1 on failure
  */
-static array_backtrack_ctx_t *array_backtrack_ctx_create(char **map, int rows,
-	int cols, const point_t *target)
+static int array_backtrack_path(array_backtrack_ctx_t *ctx)
 {
-	array_backtrack_ctx_t *ctx = NULL;
-	queue_t *path = NULL;
+	point_t *point = NULL;
+	size_t i = ctx->size + 1;
 
-	path = queue_create();
+	while (i--)
+	{
+		point = calloc(1, sizeof(point_t));
 
-	if (!path)
-		return (NULL);
+		if (!point)
+			return (-1);
 
-	ctx = calloc(1, sizeof(array_backtrack_ctx_t) + (size_t)(rows * cols));
+		point->x = i == ctx->size ? ctx->target->x : ctx->stack[i].x;
+		point->y = i == ctx->size ? ctx->target->y : ctx->stack[i].y;
 
-	if (!ctx)
-	{
-		queue_delete(path);
-		return (NULL);
+		if (!queue_push_front(ctx->path, point))
+		{
+			free(point);
+			return (-1);
+		}
 	}
 
-	ctx->map = map,
-	ctx->visited = (unsigned char *)(ctx + 1);
-	ctx->rows = rows;
-	ctx->cols = cols;
-	ctx->target = target;
-	ctx->path = path;
-	return (ctx);
+	return (1);
 }
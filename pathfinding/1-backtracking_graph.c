@@ -1,17 +1,17 @@
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "pathfinding.h"
 
-#define VISITED(ctx, v) ((ctx)->visited[(v)->index])
+#define VISITED(ctx, v) SP_VISITED_SEEN((ctx)->visited, (v)->index)
+#define TRACE_VERTEX(kind, v) SP_TRACE(kind, SP_TRACE_GRAPH, v, NULL, 0, 0, 0)
 
 /* STATIC FUNCTIONS */
 
-const vertex_t *graph_backtrack_r(graph_backtrack_ctx_t *ctx,
-	const vertex_t *vertex);
+static int graph_backtrack_run(graph_backtrack_ctx_t *ctx,
+	const vertex_t *start);
 
-graph_backtrack_ctx_t *graph_backtrack_ctx_create(graph_t *graph,
-	const vertex_t *target);
+static int graph_backtrack_enter(graph_backtrack_ctx_t *ctx,
+	const vertex_t *vertex, int weight);
 
 /* API IMPLEMENTATION */
 
@@ -27,107 +27,192 @@ graph_backtrack_ctx_t *graph_backtrack_ctx_create(graph_t *graph,
 queue_t *backtracking_graph(graph_t *graph, vertex_t const *start,
 	vertex_t const *target)
 {
-	graph_backtrack_ctx_t *ctx = NULL;
+	sp_visited_t *visited = NULL;
 	queue_t *path = NULL;
 
 	if (!graph || !start || !target)
 		return (NULL);
 
-	ctx = graph_backtrack_ctx_create(graph, target);
+	visited = sp_visited_create(graph->nb_vertices);
 
-	if (!ctx)
+	if (!visited)
 		return (NULL);
 
-	if (!graph_backtrack_r(ctx, start))
-	{
-		queue_delete(ctx->path);
-		free(ctx);
-		return (NULL);
-	}
-
-	path = ctx->path;
-	free(ctx);
+	path = backtracking_graph_workspace(visited, graph, start, target);
+	sp_visited_delete(visited);
 	return (path);
 }
 
-/* STATIC FUNCTIONS */
-
 /**
- * graph_backtrack_r - Recursive graph backtracking function
+ * backtracking_graph_workspace - backtracking_graph reusing a caller's
+ * visited marks
  *
- * @ctx: Pointer to graph_backtrack_ctx_t structure
- * @vertex: Pointer to current vertex structure
+ * @visited: Visited marks with room for every vertex of @graph
+ * @graph: Pointer to graph_t structure
+ * @start: Key string of starting vertex
+ * @target: Key string of target vertex
  *
- * Return: Pointer to vertex_t structure if added to path, NULL on failure
+ * Return: Pointer to queue_t structure representing the path
  */
-const vertex_t *graph_backtrack_r(graph_backtrack_ctx_t *ctx,
-	const vertex_t *vertex)
+queue_t *backtracking_graph_workspace(sp_visited_t *visited, graph_t *graph,
+	vertex_t const *start, vertex_t const *target)
 {
-	edge_t *edge_pos = NULL;
-	int on_target_path = 0;
+	sp_path_t path = { NULL, 0, 0, 0, 0 };
+	queue_t *queue = NULL;
 
-	if (VISITED(ctx, vertex))
-		return (NULL);
-
-	printf("Checking %s\n", vertex->content);
+	if (backtracking_graph_path(visited, graph, start, target, &path, 0))
+		queue = sp_path_to_queue(&path);
 
-	if (vertex == ctx->target)
-	{
-		if (!queue_push_front(ctx->path, strdup(vertex->content)))
-			return (NULL);
+	sp_path_release(&path);
+	return (queue);
+}
 
-		return (vertex);
-	}
+/**
+ * backtracking_graph_path - Finds a path via backtracking into a vertex
+ * array
+ *
+ * @visited: Visited marks with room for every vertex of @graph
+ * @graph: Pointer to graph_t structure
+ * @start: Key string of starting vertex
+ * @target: Key string of target vertex
+ * @path: Receives the path and the weight of the edges followed
+ * @max_steps: Vertices that may be checked before giving up (0 for no
+ *   limit)
+ *
+ * Return: 1 on success, 0 if there is no path, it does not fit the
+ *   caller's buffer, the step limit was hit, or on failure
+ */
+int backtracking_graph_path(sp_visited_t *visited, graph_t *graph,
+	vertex_t const *start, vertex_t const *target, sp_path_t *path,
+	size_t max_steps)
+{
+	graph_backtrack_ctx_t ctx;
+	int found;
+
+	if (!visited || !graph || !start || !target || !path ||
+		visited->capacity < graph->nb_vertices)
+		return (0);
+
+	sp_visited_reset(visited);
+	path->length = 0;
+	path->cost = 0;
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.graph = graph;
+	ctx.visited = visited;
+	ctx.target = target;
+	ctx.path = path;
+	ctx.max_steps = max_steps;
+	found = graph_backtrack_run(&ctx, start) == 1 &&
+		path->length <= path->capacity;
+	SP_TRACE_FLUSH();
+	free(ctx.stack);
+
+	if (found)
+		sp_path_reverse(path);
+
+	return (found);
+}
 
-	VISITED(ctx, vertex) = 1;
+/* STATIC FUNCTIONS */
 
-	for (edge_pos = vertex->edges; edge_pos; edge_pos = edge_pos->next)
-	{
-		if (graph_backtrack_r(ctx, edge_pos->dest))
-			on_target_path = 1;
-	}
+/**
+ * graph_backtrack_run - Depth-first backtracking with an explicit stack
+ * Mirrors the recursive search: every edge of a vertex is tried in list
+ * order, and a vertex joins the path when any of them led to the target
+ *
+ * @ctx: Pointer to graph_backtrack_ctx_t structure
+ * @start: Pointer to starting vertex
+ *
+ * Return: 1 if the target was reached, 0 if not, -1 on failure
+ */
+static int graph_backtrack_run(graph_backtrack_ctx_t *ctx,
+	const vertex_t *start)
+{
+	graph_backtrack_frame_t *top = NULL;
+	const edge_t *edge = NULL;
+	int found = graph_backtrack_enter(ctx, start, 0);
 
-	if (on_target_path)
+	while (found >= 0 && ctx->size)
 	{
-		if (!queue_push_front(ctx->path, strdup(vertex->content)))
-			return (NULL);
-
-		return (vertex);
+		top = &ctx->stack[ctx->size - 1];
+
+		if (top->edge)
+		{
+			edge = top->edge;
+			top->edge = edge->next;
+			found = graph_backtrack_enter(ctx, edge->dest,
+				edge->weight);
+
+			if (found == 1)
+			{
+				ctx->stack[ctx->size - 1].on_path = 1;
+				ctx->path->cost += (unsigned long)edge->weight;
+			}
+			continue;
+		}
+
+		/* Every edge tried: the frame hands its result to its parent */
+		found = top->on_path;
+		--ctx->size;
+		TRACE_VERTEX(SP_TRACE_POP, top->vertex);
+
+		if (found && !sp_path_push(ctx->path, top->vertex))
+			return (-1);
+
+		if (found && ctx->size)
+		{
+			ctx->stack[ctx->size - 1].on_path = 1;
+			ctx->path->cost += (unsigned long)top->weight;
+		}
 	}
 
-	return (NULL);
+	return (found);
 }
 
 /**
- * graph_backtrack_ctx_create - Constructs graph_backtrack_ctx_t structure
+ * graph_backtrack_enter - Checks a vertex, and pushes a frame to explore
+ * it unless it was visited already or is the target
  *
- * @graph: Pointer to graph structure
- * @target: Pointer to target vertex
+ * @ctx: Pointer to graph_backtrack_ctx_t structure
+ * @vertex: Pointer to vertex
+ * @weight: Weight of the edge leading to it
  *
- * Return: Pointer to new graph_backtrack_ctx_t, NULL on failure
+ * Return: 1 if it is the target, 0 if it was visited, 2 if a frame was
+ *   pushed, -1 on failure or once the step limit is reached
  */
-graph_backtrack_ctx_t *graph_backtrack_ctx_create(graph_t *graph,
-	const vertex_t *target)
+static int graph_backtrack_enter(graph_backtrack_ctx_t *ctx,
+	const vertex_t *vertex, int weight)
 {
-	graph_backtrack_ctx_t *ctx = NULL;
-	queue_t *path = NULL;
+	graph_backtrack_frame_t *stack = NULL;
 
-	path = queue_create();
+	if (VISITED(ctx, vertex))
+		return (0);
 
-	if (!path)
-		return (NULL);
+	if (ctx->max_steps && ++ctx->steps > ctx->max_steps)
+		return (-1);
+
+	TRACE_VERTEX(SP_TRACE_EXPAND, vertex);
 
-	ctx = calloc(1, sizeof(graph_backtrack_ctx_t) + graph->nb_vertices);
+	if (vertex == ctx->target)
+		return (sp_path_push(ctx->path, vertex) ? 1 : -1);
 
-	if (!ctx)
+	SP_VISITED_MARK(ctx->visited, vertex->index);
+
+	if (ctx->size == ctx->cap)
 	{
-		queue_delete(path);
-		return (NULL);
+		stack = realloc(ctx->stack,
+			(ctx->cap * 2 + 16) * sizeof(graph_backtrack_frame_t));
+		if (!stack)
+			return (-1);
+		ctx->stack = stack;
+		ctx->cap = ctx->cap * 2 + 16;
 	}
 
-	ctx->graph = graph;
-	ctx->visited = (unsigned char *)(ctx + 1);
-	ctx->target = target;
-	ctx->path = path;
-	return (ctx);
+	stack = &ctx->stack[ctx->size++];
+	stack->vertex = vertex;
+	stack->edge = vertex->edges;
+	stack->weight = weight;
+	stack->on_path = 0;
+	TRACE_VERTEX(SP_TRACE_PUSH, vertex);
+	return (2);
 }
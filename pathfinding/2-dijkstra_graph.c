@@ -1,33 +1,22 @@
-#include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 #include "pathfinding.h"
 
 #define INFINITY (~0u >> 1) /* max value for unsigned 31-bit integer */
-#define FRONTIER(ctx, v) ((ctx)->entries[(v)->index].frontier)
-#define DISTANCE(ctx, v) ((ctx)->entries[(v)->index].distance)
-#define NEAREST_PREV(ctx, v) ((ctx)->entries[(v)->index].prev)
-#define HEAP_LEFT(i) (((i) << 1) + 1)
-#define HEAP_RIGHT(i) (((i) << 1) + 2)
-#define HEAP_PARENT(i) (((i) - 1) >> 1)
-
-#define LOG_VERTEX(ctx, v) printf(\
-	"Checking %s, distance from %s is %u\n",\
-	(v)->content,\
-	(ctx)->start->content,\
-	DISTANCE(ctx, v)\
+#define DISTANCE(ctx, v) (dijkstra_entry((ctx), (v))->distance)
+#define NEAREST_PREV(ctx, v) (dijkstra_entry((ctx), (v))->prev)
+#define BOUND(ctx, v) ((ctx)->alt ? \
+	alt_bound((ctx)->alt, (v)->index, (ctx)->target->index) : 0UL)
+
+#define TRACE_VERTEX(ctx, kind, v) SP_TRACE(\
+	kind, SP_TRACE_DIJKSTRA, v, (ctx)->start, 0, 0, DISTANCE(ctx, v)\
 )
 
 /* STATIC FUNCTIONS */
 
 static int populate_distances(dijkstra_ctx_t *ctx);
 
-static const vertex_t *pq_insert(dijkstra_ctx_t *ctx, const vertex_t *vertex);
-
-static const vertex_t *pq_extract(dijkstra_ctx_t *ctx);
-
-static dijkstra_ctx_t *dijkstra_ctx_create(graph_t *graph,
-	const vertex_t *start, const vertex_t *target);
+static dijkstra_entry_t *dijkstra_entry(dijkstra_ctx_t *ctx,
+	const vertex_t *v);
 
 /* API IMPLEMENTATION */
 
@@ -43,36 +32,98 @@ static dijkstra_ctx_t *dijkstra_ctx_create(graph_t *graph,
 queue_t *dijkstra_graph(graph_t *graph, vertex_t const *start,
 	vertex_t const *target)
 {
-	dijkstra_ctx_t *ctx = NULL;
+	return (dijkstra_graph_heap(graph, start, target, SP_HEAP_AUTO));
+}
+
+/**
+ * dijkstra_graph_heap - dijkstra_graph with a chosen priority queue
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @kind: Priority queue implementation, or SP_HEAP_AUTO
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *dijkstra_graph_heap(graph_t *graph, vertex_t const *start,
+	vertex_t const *target, sp_heap_kind_t kind)
+{
+	sp_workspace_t *ws = NULL;
 	queue_t *path = NULL;
-	const vertex_t *pos = NULL;
 
 	if (!graph || !start || !target)
 		return (NULL);
 
-	ctx = dijkstra_ctx_create(graph, start, target);
+	ws = sp_workspace_create_for(graph, kind);
 
-	if (!ctx)
+	if (!ws)
 		return (NULL);
 
-	if (!populate_distances(ctx))
-		goto on_fail;
+	path = dijkstra_graph_workspace(ws, graph, start, target);
+	sp_workspace_delete(ws);
+	return (path);
+}
+
+/**
+ * dijkstra_graph_alt - dijkstra_graph_path guided by landmark lower bounds
+ * Vertices come out in order of distance plus ALT bound, which is A* with
+ * a consistent heuristic: the target is still settled at its true distance,
+ * usually after far fewer vertices. Vertices the tables prove cannot reach
+ * the target are never queued
+ *
+ * @ws: Workspace with room for every vertex of @graph (not shared between
+ *   threads, and not using a bucket queue when @alt is set, since bounds
+ *   make keys jump by more than an edge weight)
+ * @graph: Pointer to graph_t structure
+ * @alt: Landmark tables built on @graph, or NULL for plain Dijkstra
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @path: Receives the path and its cost (see sp_path_t)
+ *
+ * Return: 1 on success, 0 if there is no path, it does not fit the
+ *   caller's buffer, or on failure
+ */
+int dijkstra_graph_alt(sp_workspace_t *ws, graph_t *graph, alt_t const *alt,
+	vertex_t const *start, vertex_t const *target, sp_path_t *path)
+{
+	dijkstra_ctx_t ctx;
+	const vertex_t *pos = NULL;
+	size_t i;
+	int found;
+
+	if (!ws || !graph || !start || !target || !path ||
+		ws->capacity < graph->nb_vertices ||
+		(alt && (alt->nb_vertices != graph->nb_vertices ||
+		ws->pq->kind == SP_HEAP_BUCKET)))
+		return (0);
 
-	path = ctx->path;
+	sp_workspace_reset(ws);
+	ctx.graph = graph;
+	ctx.ws = ws;
+	ctx.start = start;
+	ctx.target = target;
+	ctx.alt = alt;
+	DISTANCE(&ctx, start) = 0;
+	path->length = 0;
 
-	for (pos = target; pos; pos = NEAREST_PREV(ctx, pos))
-	{
-		if (!queue_push_front(path, strdup(pos->content)))
-			goto on_fail;
-	}
+	found = populate_distances(&ctx);
+	SP_TRACE_FLUSH();
 
-	free(ctx);
-	return (path);
+	if (!found)
+		return (0);
+
+	for (pos = target; pos; pos = NEAREST_PREV(&ctx, pos))
+		++path->length;
+
+	path->cost = DISTANCE(&ctx, target);
 
-on_fail:
-	queue_delete(ctx->path);
-	free(ctx);
-	return (NULL);
+	if (!sp_path_reserve(path, path->length))
+		return (0);
+
+	for (pos = target, i = path->length; pos; pos = NEAREST_PREV(&ctx, pos))
+		path->vertices[--i] = pos;
+
+	return (1);
 }
 
 /* STATIC FUNCTIONS */
@@ -86,20 +137,24 @@ on_fail:
  */
 static int populate_distances(dijkstra_ctx_t *ctx)
 {
+	sp_heap_t *pq = ctx->ws->pq;
 	const vertex_t *pos = NULL;
 	edge_t *edge = NULL;
 	unsigned int dist;
+	unsigned long bound;
+	size_t id;
 
-	pq_insert(ctx, ctx->start);
-
-	while (ctx->pq_size)
-	{
-		pos = pq_extract(ctx);
+	if (BOUND(ctx, ctx->start) == SP_UNREACHABLE)
+		return (0);
 
-		if (!pos)
-			return (0);
+	sp_heap_push(pq, ctx->start->index, BOUND(ctx, ctx->start));
+	TRACE_VERTEX(ctx, SP_TRACE_PUSH, ctx->start);
 
-		LOG_VERTEX(ctx, pos);
+	while ((id = sp_heap_pop(pq, NULL)) != SP_HEAP_NONE)
+	{
+		pos = ctx->ws->entries[id].vertex;
+		TRACE_VERTEX(ctx, SP_TRACE_POP, pos);
+		TRACE_VERTEX(ctx, SP_TRACE_EXPAND, pos);
 
 		if (pos == ctx->target)
 			return (1);
@@ -110,11 +165,19 @@ static int populate_distances(dijkstra_ctx_t *ctx)
 
 			if (dist < DISTANCE(ctx, edge->dest))
 			{
+				bound = BOUND(ctx, edge->dest);
+
+				if (bound == SP_UNREACHABLE)
+					continue;
+
 				DISTANCE(ctx, edge->dest) = dist;
 				NEAREST_PREV(ctx, edge->dest) = pos;
-
-				if (!FRONTIER(ctx, edge->dest))
-					pq_insert(ctx, edge->dest);
+				TRACE_VERTEX(ctx, SP_TRACE_RELAX, edge->dest);
+				/* Inserts, or sifts up if already queued */
+				bound += dist;
+				if (!sp_heap_push(pq, edge->dest->index, bound))
+					return (0);
+				TRACE_VERTEX(ctx, SP_TRACE_PUSH, edge->dest);
 			}
 		}
 	}
@@ -123,134 +186,26 @@ static int populate_distances(dijkstra_ctx_t *ctx)
 }
 
 /**
- * pq_insert - Inserts vertex into priority queue
- *
- * @ctx: Pointer to Dijkstra's algorithm context structure
- * @vertex: Pointer to vertex being inserted
- *
- * Return: Pointer to inserted vertex, NULL on failure
- */
-static const vertex_t *pq_insert(dijkstra_ctx_t *ctx, const vertex_t *vertex)
-{
-	const vertex_t *pos = NULL, *parent = NULL, *tmp = NULL;
-	size_t i, j;
-
-	if (ctx->pq_size == ctx->graph->nb_vertices)
-		return (NULL);
-
-	i = ctx->pq_size++;
-	ctx->pq[i] = vertex;
-
-	while (i > 0)
-	{
-		j = HEAP_PARENT(i);
-		pos = ctx->pq[i];
-		parent = ctx->pq[j];
-
-		if (DISTANCE(ctx, parent) <= DISTANCE(ctx, pos))
-			break;
-
-		tmp = ctx->pq[i];
-		ctx->pq[i] = ctx->pq[j];
-		ctx->pq[j] = tmp;
-
-		i = j;
-	}
-
-	FRONTIER(ctx, vertex) = 1;
-	return (vertex);
-}
-
-/**
- * pq_extract - Extracts vertex from priority queue
- *
- * @ctx: Pointer to Dijkstra's algorithm context structure
- *
- * Return: Pointer to extracted vertex, NULL on failure
- */
-static const vertex_t *pq_extract(dijkstra_ctx_t *ctx)
-{
-	const vertex_t *root = NULL, *tmp1 = NULL, *tmp2 = NULL;
-	size_t i, j;
-
-	if (!ctx->pq_size)
-		return (NULL);
-
-	root = ctx->pq[0];
-	ctx->pq[0] = ctx->pq[--ctx->pq_size];
-
-	for (i = 0; HEAP_LEFT(i) < ctx->pq_size; i = j)
-	{
-		if (HEAP_RIGHT(i) < ctx->pq_size)
-		{
-			tmp1 = ctx->pq[HEAP_LEFT(i)];
-			tmp2 = ctx->pq[HEAP_RIGHT(i)];
-			j = (DISTANCE(ctx, tmp1) <= DISTANCE(ctx, tmp2))
-				? HEAP_LEFT(i)
-				: HEAP_RIGHT(i);
-		}
-		else
-		{
-			j = HEAP_LEFT(i);
-		}
-
-		tmp1 = ctx->pq[i];
-		tmp2 = ctx->pq[j];
-
-		if (DISTANCE(ctx, tmp1) <= DISTANCE(ctx, tmp2))
-			break;
-
-		tmp1 = ctx->pq[i];
-		ctx->pq[i] = ctx->pq[j];
-		ctx->pq[j] = tmp1;
-	}
-
-	FRONTIER(ctx, root) = 0;
-	return (root);
-}
-
-/**
- * dijkstra_ctx_create - Allocates/initializes dijkstra_ctx_t structure
+ * dijkstra_entry - Looks up a vertex's entry, resetting it on first use in
+ * the current query
  *
- * @graph: Pointer to graph structure
- * @start: Pointer to start vertex
- * @target: Pointer to target vertex
+ * @ctx: Pointer to context structure
+ * @v: Pointer to vertex
  *
- * Return: Pointer to new dijkstra_ctx_t instance, NULL on failure
+ * Return: Pointer to the vertex's entry
  */
-static dijkstra_ctx_t *dijkstra_ctx_create(graph_t *graph,
-	const vertex_t *start, const vertex_t *target)
+static dijkstra_entry_t *dijkstra_entry(dijkstra_ctx_t *ctx,
+	const vertex_t *v)
 {
-	dijkstra_ctx_t *ctx = NULL;
-	queue_t *path = NULL;
-	size_t alloc_size, i;
-
-	path = queue_create();
+	dijkstra_entry_t *entry = &ctx->ws->entries[v->index];
 
-	if (!path)
-		return (NULL);
-
-	alloc_size = sizeof(dijkstra_ctx_t);
-	alloc_size += graph->nb_vertices * sizeof(dijkstra_entry_t);
-	alloc_size += graph->nb_vertices * sizeof(const vertex_t *);
-	ctx = calloc(1, alloc_size);
-
-	if (!ctx)
+	if (!SP_WORKSPACE_SEEN(ctx->ws, v->index))
 	{
-		queue_delete(path);
-		return (NULL);
+		SP_WORKSPACE_MARK(ctx->ws, v->index);
+		entry->prev = NULL;
+		entry->vertex = v;
+		entry->distance = INFINITY;
 	}
 
-	ctx->graph = graph;
-	ctx->entries = (dijkstra_entry_t *)(ctx + 1);
-
-	for (i = 0; i < graph->nb_vertices; ++i)
-		ctx->entries[i].distance = INFINITY;
-
-	ctx->entries[start->index].distance = 0L;
-	ctx->pq = (const vertex_t **)(ctx->entries + graph->nb_vertices);
-	ctx->start = start;
-	ctx->target = target;
-	ctx->path = path;
-	return (ctx);
+	return (entry);
 }
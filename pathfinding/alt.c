@@ -0,0 +1,260 @@
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "pathfinding.h"
+
+/* Subtree weight of a vertex whose subtree already holds a landmark */
+#define COVERED (~0UL)
+
+/* STATIC FUNCTIONS */
+
+static size_t alt_farthest(alt_build_ctx_t *ctx, size_t l);
+static size_t alt_avoid(alt_build_ctx_t *ctx, size_t l);
+
+/* API IMPLEMENTATION */
+
+/**
+ * alt_create - Chooses landmarks and computes their distance tables
+ * Two full Dijkstra searches per landmark (forward, and backward over the
+ * incoming edges); the avoid strategy runs one more to choose each
+ *
+ * @graph: Pointer to graph_t structure (non-negative weights)
+ * @nb_landmarks: Number of landmarks (at most the number of vertices; 8 to
+ *   16 suit most road-like graphs)
+ * @select: Landmark selection strategy
+ *
+ * Return: Pointer to alt_t structure, NULL on failure
+ */
+alt_t *alt_create(graph_t const *graph, size_t nb_landmarks,
+	alt_select_t select)
+{
+	alt_build_ctx_t ctx;
+	alt_t *alt = NULL;
+	size_t n, l, landmark;
+	int ok;
+
+	if (!graph || !graph->nb_vertices || !nb_landmarks ||
+		nb_landmarks > graph->nb_vertices)
+		return (NULL);
+
+	n = graph->nb_vertices;
+	alt = calloc(1, sizeof(alt_t) + nb_landmarks * (sizeof(unsigned long) +
+		2 * n * sizeof(unsigned int)));
+
+	if (!alt)
+		return (NULL);
+
+	alt->nb_vertices = n;
+	alt->landmarks = (unsigned long *)(alt + 1);
+	alt->forward = (unsigned int *)(alt->landmarks + nb_landmarks);
+	alt->backward = alt->forward + nb_landmarks * n;
+	ctx.graph = graph;
+	ctx.alt = alt;
+	ctx.in = sp_in_edges_create(graph);
+	ctx.pq = sp_heap_create(SP_HEAP_DEFAULT, n);
+	ctx.order = malloc(n * (3 * sizeof(size_t) + sizeof(unsigned long)));
+	ok = ctx.in && ctx.pq && ctx.order;
+
+	if (ok)
+	{
+		ctx.parent = ctx.order + n;
+		ctx.leaf = ctx.parent + n;
+		ctx.size = (unsigned long *)(ctx.leaf + n);
+	}
+
+	for (l = 0; ok && l < nb_landmarks; ++l)
+	{
+		landmark = select == ALT_AVOID ? alt_avoid(&ctx, l) :
+			alt_farthest(&ctx, l);
+		alt->landmarks[l] = landmark;
+		ok = landmark != SP_HEAP_NONE &&
+			alt_sssp(&ctx, landmark, 0, alt->forward + l * n) &&
+			alt_sssp(&ctx, landmark, 1, alt->backward + l * n);
+		alt->nb_landmarks = l + 1;
+	}
+
+	sp_in_edges_delete(ctx.in);
+	sp_heap_delete(ctx.pq);
+	free(ctx.order);
+
+	if (!ok)
+	{
+		alt_delete(alt);
+		return (NULL);
+	}
+
+	return (alt);
+}
+
+/**
+ * alt_delete - Deallocates landmark tables, or unmaps them
+ *
+ * @alt: Pointer to alt_t structure
+ */
+void alt_delete(alt_t *alt)
+{
+	if (!alt)
+		return;
+
+	if (alt->mapping)
+		munmap(alt->mapping, alt->mapping_size);
+
+	free(alt);
+}
+
+/**
+ * alt_bound - Lower bound on the distance between two vertices
+ * The best of both triangle inequalities over every landmark; it is
+ * consistent, so A* keyed on it settles each vertex once
+ *
+ * @alt: Pointer to alt_t structure
+ * @v: Index of the vertex the distance is from
+ * @target: Index of the vertex the distance is to
+ *
+ * Return: Lower bound on d(v, target), SP_UNREACHABLE if a landmark proves
+ *   there is no path
+ */
+unsigned long alt_bound(alt_t const *alt, size_t v, size_t target)
+{
+	const unsigned int *forward = alt->forward, *backward = alt->backward;
+	unsigned long bound = 0;
+	size_t l;
+
+	if (v == target)
+		return (0);
+
+	for (l = 0; l < alt->nb_landmarks; ++l)
+	{
+		/* L reaches v but not target: v does not reach it either */
+		if (forward[v] != ALT_UNREACHABLE)
+		{
+			if (forward[target] == ALT_UNREACHABLE)
+				return (SP_UNREACHABLE);
+			if (forward[target] > forward[v] &&
+				forward[target] - forward[v] > bound)
+				bound = forward[target] - forward[v];
+		}
+
+		/* target reaches L but v does not: v does not reach target */
+		if (backward[target] != ALT_UNREACHABLE)
+		{
+			if (backward[v] == ALT_UNREACHABLE)
+				return (SP_UNREACHABLE);
+			if (backward[v] > backward[target] &&
+				backward[v] - backward[target] > bound)
+				bound = backward[v] - backward[target];
+		}
+
+		forward += alt->nb_vertices;
+		backward += alt->nb_vertices;
+	}
+
+	return (bound);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * alt_farthest - Chooses the vertex farthest from the landmarks so far
+ * Vertices none of them reach come first; the first landmark is the one
+ * farthest from vertex 0
+ *
+ * @ctx: Pointer to alt_build_ctx_t structure
+ * @l: Number of landmarks already chosen
+ *
+ * Return: Index of the vertex, SP_HEAP_NONE on failure
+ */
+static size_t alt_farthest(alt_build_ctx_t *ctx, size_t l)
+{
+	const alt_t *alt = ctx->alt;
+	size_t n = alt->nb_vertices, v, i, best = 0;
+	unsigned long min, far = 0;
+
+	/* Row l is free until the new landmark's search fills it */
+	if (!l && !alt_sssp(ctx, 0, 0, alt->forward))
+		return (SP_HEAP_NONE);
+
+	for (v = 0; v < n; ++v)
+	{
+		min = l ? ALT_UNREACHABLE : alt->forward[v];
+
+		for (i = 0; i < l; ++i)
+			if (alt->forward[i * n + v] < min)
+				min = alt->forward[i * n + v];
+
+		if (min > far)
+		{
+			far = min;
+			best = v;
+		}
+	}
+
+	return (best);
+}
+
+/**
+ * alt_avoid - Chooses a landmark where the current ones bound worst
+ * Each vertex of the shortest-path tree of a root weighs the gap between
+ * its distance from the root and the bound on it; of the subtrees holding
+ * no landmark, the heaviest one gives its deepest heaviest leaf
+ *
+ * @ctx: Pointer to alt_build_ctx_t structure
+ * @l: Number of landmarks already chosen
+ *
+ * Return: Index of the vertex, SP_HEAP_NONE on failure
+ */
+static size_t alt_avoid(alt_build_ctx_t *ctx, size_t l)
+{
+	const alt_t *alt = ctx->alt;
+	size_t n = alt->nb_vertices, root, v, p, i, best = SP_HEAP_NONE;
+	unsigned int *dist = alt->forward + l * n;
+
+	if (!l)
+		return (alt_farthest(ctx, l));
+
+	root = (size_t)((l * 2654435761UL) % n);
+
+	if (!alt_sssp(ctx, root, 0, dist))
+		return (SP_HEAP_NONE);
+
+	for (i = 0; i < ctx->nb_settled; ++i)
+	{
+		v = ctx->order[i];
+		ctx->size[v] = dist[v] - alt_bound(alt, root, v);
+		ctx->leaf[v] = SP_HEAP_NONE;
+	}
+
+	for (i = 0; i < l; ++i)
+		if (dist[alt->landmarks[i]] != ALT_UNREACHABLE)
+			ctx->size[alt->landmarks[i]] = COVERED;
+
+	/* Children settle after their parent: sweep the tree bottom-up */
+	for (i = ctx->nb_settled; i--;)
+	{
+		v = ctx->order[i];
+		p = ctx->parent[v];
+		ctx->leaf[v] = ctx->leaf[v] == SP_HEAP_NONE ? v :
+			ctx->leaf[ctx->leaf[v]];
+
+		if (ctx->size[v] != COVERED && (best == SP_HEAP_NONE ||
+			ctx->size[v] > ctx->size[best]))
+			best = v;
+
+		if (p == SP_HEAP_NONE || ctx->size[p] == COVERED)
+			continue;
+
+		if (ctx->size[v] == COVERED)
+			ctx->size[p] = COVERED;
+		else
+		{
+			ctx->size[p] += ctx->size[v];
+			if (ctx->leaf[p] == SP_HEAP_NONE ||
+				ctx->size[v] > ctx->size[ctx->leaf[p]])
+				ctx->leaf[p] = v;
+		}
+	}
+
+	if (best == SP_HEAP_NONE)
+		return (alt_farthest(ctx, l));
+
+	return (ctx->leaf[best]);
+}
@@ -0,0 +1,144 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int alt_file_check(alt_file_header_t const *header, size_t size);
+
+/* API IMPLEMENTATION */
+
+/**
+ * alt_load - Maps a landmark file written by alt_save
+ * Nothing is copied or recomputed: pages are read in as queries touch them,
+ * and processes loading the same file share them
+ *
+ * @path: Path of the landmark file
+ *
+ * Return: Pointer to a read-only alt_t structure, NULL on failure
+ */
+alt_t *alt_load(char const *path)
+{
+	alt_t *alt = NULL;
+	struct stat st;
+	void *mapping = MAP_FAILED;
+	int fd;
+
+	if (!path)
+		return (NULL);
+
+	fd = open(path, O_RDONLY);
+
+	if (fd == -1)
+		return (NULL);
+
+	if (!fstat(fd, &st) && st.st_size >= ALT_FILE_HEADER)
+		mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED,
+			fd, 0);
+
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return (NULL);
+
+	alt = calloc(1, sizeof(alt_t));
+
+	if (!alt || !alt_file_check(mapping, (size_t)st.st_size))
+	{
+		munmap(mapping, (size_t)st.st_size);
+		free(alt);
+		return (NULL);
+	}
+
+	alt->nb_vertices = ((alt_file_header_t *)mapping)->nb_vertices;
+	alt->nb_landmarks = ((alt_file_header_t *)mapping)->nb_landmarks;
+	alt->landmarks = (unsigned long *)((char *)mapping + ALT_FILE_HEADER);
+	alt->forward = (unsigned int *)(alt->landmarks + alt->nb_landmarks);
+	alt->backward = alt->forward + alt->nb_landmarks * alt->nb_vertices;
+	alt->mapping = mapping;
+	alt->mapping_size = (size_t)st.st_size;
+	return (alt);
+}
+
+/**
+ * alt_save - Writes landmark tables to a file alt_load can map
+ *
+ * @alt: Pointer to alt_t structure
+ * @path: Path of the file to create or truncate
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int alt_save(alt_t const *alt, char const *path)
+{
+	char header[ALT_FILE_HEADER];
+	alt_file_header_t fields;
+	size_t k, n;
+	FILE *file = NULL;
+	int ok;
+
+	if (!alt || !path)
+		return (0);
+
+	memset(header, 0, sizeof(header));
+	memset(&fields, 0, sizeof(fields));
+	memcpy(fields.magic, ALT_FILE_MAGIC, sizeof(ALT_FILE_MAGIC));
+	fields.nb_vertices = alt->nb_vertices;
+	fields.nb_landmarks = alt->nb_landmarks;
+	memcpy(header, &fields, sizeof(fields));
+	k = alt->nb_landmarks;
+	n = k * alt->nb_vertices;
+	file = fopen(path, "wb");
+
+	if (!file)
+		return (0);
+
+	ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+		fwrite(alt->landmarks, sizeof(unsigned long), k, file) == k &&
+		fwrite(alt->forward, sizeof(unsigned int), n, file) == n &&
+		fwrite(alt->backward, sizeof(unsigned int), n, file) == n;
+	return (fclose(file) == 0 && ok);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * alt_file_check - Validates the header of a mapped landmark file
+ *
+ * @header: Start of the mapping
+ * @size: Size of the mapping
+ *
+ * Return: 1 if the file holds tables this host can use, 0 otherwise
+ */
+static int alt_file_check(alt_file_header_t const *header, size_t size)
+{
+	const unsigned long *landmarks = NULL;
+	size_t n = header->nb_vertices, k = header->nb_landmarks, l;
+
+	if (memcmp(header->magic, ALT_FILE_MAGIC, sizeof(ALT_FILE_MAGIC)) ||
+		!n || !k || k > n)
+		return (0);
+
+	size -= ALT_FILE_HEADER;
+
+	if (k > size / sizeof(unsigned long))
+		return (0);
+
+	size -= k * sizeof(unsigned long);
+
+	if (n > size / sizeof(unsigned int) / 2 / k)
+		return (0);
+
+	landmarks = (const unsigned long *)((char const *)header +
+		ALT_FILE_HEADER);
+
+	for (l = 0; l < k; ++l)
+		if (landmarks[l] >= n)
+			return (0);
+
+	return (1);
+}
@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int alt_relax(alt_build_ctx_t *ctx, unsigned int *dist, size_t from,
+	size_t to, int weight);
+
+/* API IMPLEMENTATION */
+
+/**
+ * alt_sssp - Full Dijkstra search from (or, backward, to) a vertex
+ * Settle order and tree parents are kept for the avoid strategy
+ *
+ * @ctx: Pointer to alt_build_ctx_t structure
+ * @source: Index of the vertex searched from
+ * @backward: Nonzero to follow edges against their direction, computing
+ *   distances to @source
+ * @dist: Receives the distance of every vertex, by index (ALT_UNREACHABLE
+ *   if there is no path)
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int alt_sssp(alt_build_ctx_t *ctx, size_t source, int backward,
+	unsigned int *dist)
+{
+	const sp_in_edges_t *in = ctx->in;
+	const edge_t *edge = NULL;
+	size_t v, i;
+	int ok = 1;
+
+	for (v = 0; v < in->nb_vertices; ++v)
+	{
+		dist[v] = ALT_UNREACHABLE;
+		ctx->parent[v] = SP_HEAP_NONE;
+	}
+
+	sp_heap_clear(ctx->pq);
+	ctx->nb_settled = 0;
+	dist[source] = 0;
+
+	ok = sp_heap_push(ctx->pq, source, 0);
+
+	while (ok && (v = sp_heap_pop(ctx->pq, NULL)) != SP_HEAP_NONE)
+	{
+		ctx->order[ctx->nb_settled++] = v;
+
+		if (backward)
+		{
+			for (i = in->offsets[v]; i < in->offsets[v + 1]; ++i)
+				ok = ok && alt_relax(ctx, dist, v,
+					in->sources[i]->index, in->weights[i]);
+			continue;
+		}
+
+		for (edge = in->vertices[v]->edges; edge; edge = edge->next)
+			ok = ok && alt_relax(ctx, dist, v, edge->dest->index,
+				edge->weight);
+	}
+
+	return (ok);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * alt_relax - Relaxes one edge of a landmark search
+ *
+ * @ctx: Pointer to alt_build_ctx_t structure
+ * @dist: Distances so far
+ * @from: Index of the vertex being settled
+ * @to: Index of the vertex at the other end of the edge
+ * @weight: Weight of the edge
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int alt_relax(alt_build_ctx_t *ctx, unsigned int *dist, size_t from,
+	size_t to, int weight)
+{
+	unsigned long d = (unsigned long)dist[from] + (unsigned long)weight;
+
+	/* Distances at or past ALT_UNREACHABLE cannot be stored */
+	if (d >= dist[to])
+		return (1);
+
+	dist[to] = (unsigned int)d;
+	ctx->parent[to] = from;
+	return (sp_heap_push(ctx->pq, to, d));
+}
@@ -0,0 +1,240 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+#define ENTRY(ctx, v) ((ctx)->entries[(v)->index])
+#define H(ctx, v) ((ctx)->heuristic \
+	? (unsigned long)(ctx)->heuristic((v), (ctx)->target) : 0UL)
+#define HEAP_LEFT(i) (((i) << 1) + 1)
+#define HEAP_PARENT(i) (((i) - 1) >> 1)
+#define UNREACHED (~0UL)
+
+/* STATIC FUNCTIONS */
+
+static int astar_search(astar_ctx_t *ctx);
+
+static int open_push(astar_ctx_t *ctx, const vertex_t *vertex,
+	unsigned long f);
+
+static const vertex_t *open_pop(astar_ctx_t *ctx);
+
+static astar_ctx_t *astar_ctx_create(graph_t *graph, const vertex_t *start,
+	const vertex_t *target, astar_heuristic_t heuristic);
+
+/* API IMPLEMENTATION */
+
+/**
+ * astar_graph - Retrieves minimum cost path using A* search
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @heuristic: Admissible heuristic (astar_euclidean, astar_manhattan or a
+ *   custom one); NULL expands exactly like Dijkstra's algorithm
+ * @stats: If not NULL, receives the search's work counters
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *astar_graph(graph_t *graph, vertex_t const *start,
+	vertex_t const *target, astar_heuristic_t heuristic, sp_stats_t *stats)
+{
+	astar_ctx_t *ctx = NULL;
+	queue_t *path = NULL;
+	const vertex_t *pos = NULL;
+
+	if (!graph || !start || !target)
+		return (NULL);
+
+	ctx = astar_ctx_create(graph, start, target, heuristic);
+
+	if (!ctx)
+		return (NULL);
+
+	if (astar_search(ctx))
+		path = queue_create();
+
+	for (pos = target; path && pos; pos = ENTRY(ctx, pos).prev)
+	{
+		if (!queue_push_front(path, strdup(pos->content)))
+		{
+			queue_delete(path);
+			path = NULL;
+		}
+	}
+
+	if (stats)
+		*stats = ctx->stats;
+
+	free(ctx->open);
+	free(ctx);
+	return (path);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * astar_search - Expands vertices by f = g + h until the target is closed
+ *
+ * @ctx: Pointer to context structure
+ *
+ * Return: 1 if the target was reached, 0 otherwise
+ */
+static int astar_search(astar_ctx_t *ctx)
+{
+	const vertex_t *pos = NULL;
+	edge_t *edge = NULL;
+	unsigned long g;
+
+	if (!open_push(ctx, ctx->start, H(ctx, ctx->start)))
+		return (0);
+
+	while ((pos = open_pop(ctx)))
+	{
+		++ctx->stats.expanded;
+
+		if (pos == ctx->target)
+			return (1);
+
+		for (edge = pos->edges; edge; edge = edge->next)
+		{
+			g = ENTRY(ctx, pos).g + (unsigned long)edge->weight;
+
+			if (ENTRY(ctx, edge->dest).closed ||
+				g >= ENTRY(ctx, edge->dest).g)
+				continue;
+
+			ENTRY(ctx, edge->dest).g = g;
+			ENTRY(ctx, edge->dest).prev = pos;
+			++ctx->stats.relaxed;
+
+			if (!open_push(ctx, edge->dest, g + H(ctx, edge->dest)))
+				return (0);
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * open_push - Inserts a node into the open list
+ * A vertex whose cost improves is pushed again rather than sifted up;
+ * its older copy is discarded when popped
+ *
+ * @ctx: Pointer to context structure
+ * @vertex: Pointer to vertex
+ * @f: Estimated total cost through `vertex`
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int open_push(astar_ctx_t *ctx, const vertex_t *vertex,
+	unsigned long f)
+{
+	astar_node_t *open = NULL, node;
+	size_t i;
+
+	if (ctx->open_size == ctx->open_cap)
+	{
+		open = realloc(ctx->open,
+			2 * ctx->open_cap * sizeof(astar_node_t));
+
+		if (!open)
+			return (0);
+
+		ctx->open = open;
+		ctx->open_cap *= 2;
+	}
+
+	node.f = f, node.vertex = vertex;
+
+	for (i = ctx->open_size++; i && ctx->open[HEAP_PARENT(i)].f > f;
+		i = HEAP_PARENT(i))
+		ctx->open[i] = ctx->open[HEAP_PARENT(i)];
+
+	ctx->open[i] = node;
+	return (1);
+}
+
+/**
+ * open_pop - Extracts the open node with the smallest f, skipping stale ones
+ *
+ * @ctx: Pointer to context structure
+ *
+ * Return: Pointer to the vertex to expand, NULL when the open list is empty
+ */
+static const vertex_t *open_pop(astar_ctx_t *ctx)
+{
+	astar_node_t root, last;
+	size_t i, j;
+
+	while (ctx->open_size)
+	{
+		root = ctx->open[0];
+		last = ctx->open[--ctx->open_size];
+
+		for (i = 0; (j = HEAP_LEFT(i)) < ctx->open_size; i = j)
+		{
+			if (j + 1 < ctx->open_size &&
+				ctx->open[j + 1].f < ctx->open[j].f)
+				++j;
+
+			if (last.f <= ctx->open[j].f)
+				break;
+
+			ctx->open[i] = ctx->open[j];
+		}
+
+		ctx->open[i] = last;
+
+		if (!ENTRY(ctx, root.vertex).closed)
+		{
+			ENTRY(ctx, root.vertex).closed = 1;
+			return (root.vertex);
+		}
+	}
+
+	return (NULL);
+}
+
+/**
+ * astar_ctx_create - Allocates/initializes astar_ctx_t structure
+ *
+ * @graph: Pointer to graph structure
+ * @start: Pointer to start vertex
+ * @target: Pointer to target vertex
+ * @heuristic: Heuristic function, may be NULL
+ *
+ * Return: Pointer to new astar_ctx_t instance, NULL on failure
+ */
+static astar_ctx_t *astar_ctx_create(graph_t *graph, const vertex_t *start,
+	const vertex_t *target, astar_heuristic_t heuristic)
+{
+	astar_ctx_t *ctx = NULL;
+	size_t i;
+
+	ctx = calloc(1, sizeof(astar_ctx_t) +
+		graph->nb_vertices * sizeof(astar_entry_t));
+
+	if (!ctx)
+		return (NULL);
+
+	ctx->open_cap = 64;
+	ctx->open = malloc(ctx->open_cap * sizeof(astar_node_t));
+
+	if (!ctx->open)
+	{
+		free(ctx);
+		return (NULL);
+	}
+
+	ctx->graph = graph;
+	ctx->entries = (astar_entry_t *)(ctx + 1);
+
+	for (i = 0; i < graph->nb_vertices; ++i)
+		ctx->entries[i].g = UNREACHED;
+
+	ctx->entries[start->index].g = 0;
+	ctx->start = start;
+	ctx->target = target;
+	ctx->heuristic = heuristic;
+	return (ctx);
+}
@@ -0,0 +1,70 @@
+#include "pathfinding.h"
+
+#define ABS_DIFF(a, b) ((a) > (b) \
+	? (unsigned long)((long)(a) - (long)(b)) \
+	: (unsigned long)((long)(b) - (long)(a)))
+
+/* STATIC FUNCTIONS */
+
+static unsigned long isqrt(unsigned long n);
+
+/* API IMPLEMENTATION */
+
+/**
+ * astar_euclidean - Straight-line distance heuristic, rounded down
+ * Admissible when no edge weighs less than the distance it spans
+ *
+ * @v: Pointer to current vertex
+ * @target: Pointer to target vertex
+ *
+ * Return: floor(sqrt(dx^2 + dy^2))
+ */
+unsigned int astar_euclidean(const vertex_t *v, const vertex_t *target)
+{
+	unsigned long dx = ABS_DIFF(v->x, target->x);
+	unsigned long dy = ABS_DIFF(v->y, target->y);
+
+	return ((unsigned int)isqrt(dx * dx + dy * dy));
+}
+
+/**
+ * astar_manhattan - Taxicab distance heuristic
+ * Admissible on 4-connected layouts (moves along one axis at a time)
+ *
+ * @v: Pointer to current vertex
+ * @target: Pointer to target vertex
+ *
+ * Return: |dx| + |dy|
+ */
+unsigned int astar_manhattan(const vertex_t *v, const vertex_t *target)
+{
+	return ((unsigned int)(ABS_DIFF(v->x, target->x) +
+		ABS_DIFF(v->y, target->y)));
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * isqrt - Integer square root (Newton's method), no libm needed
+ *
+ * @n: Radicand
+ *
+ * Return: floor(sqrt(n))
+ */
+static unsigned long isqrt(unsigned long n)
+{
+	unsigned long x = n, y;
+
+	if (n < 2)
+		return (n);
+
+	y = (x + 1) / 2;
+
+	while (y < x)
+	{
+		x = y;
+		y = (x + n / x) / 2;
+	}
+
+	return (x);
+}
@@ -0,0 +1,68 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * backtracking_grid - backtracking_array over a packed grid
+ *
+ * @grid: Pointer to grid_t structure
+ * @start: Pointer to point_t for the start coordinates
+ * @target: Pointer to point_t for the target coordinates
+ *
+ * Return: Pointer to queue_t representing the path, NULL on failure
+ */
+queue_t *backtracking_grid(grid_t const *grid, point_t const *start,
+	point_t const *target)
+{
+	grid_t *seen = NULL;
+	queue_t *path = NULL;
+
+	if (!grid || !start || !target)
+		return (NULL);
+
+	seen = grid_create(grid->rows, grid->cols);
+
+	if (!seen)
+		return (NULL);
+
+	path = backtracking_grid_workspace(seen, grid, start, target, 0);
+	grid_delete(seen);
+	return (path);
+}
+
+/**
+ * backtracking_grid_workspace - backtracking_grid reusing a caller's
+ * visited bitset
+ * The bitset is a grid of its own, a bit per cell set once visited, so it
+ * costs no more memory than the maze
+ *
+ * @seen: Grid from grid_create with the maze's rows and columns, which the
+ *   search overwrites
+ * @grid: Pointer to grid_t structure
+ * @start: Pointer to point_t for the start coordinates
+ * @target: Pointer to point_t for the target coordinates
+ * @max_steps: Cells that may be checked before giving up (0 for no limit)
+ *
+ * Return: Pointer to queue_t representing the path, NULL on failure, if
+ *   there is no path or if the step limit was hit
+ */
+queue_t *backtracking_grid_workspace(grid_t *seen, grid_t const *grid,
+	point_t const *start, point_t const *target, size_t max_steps)
+{
+	array_backtrack_ctx_t ctx = {
+		NULL, NULL, NULL, NULL, 0, 0, NULL, NULL, NULL, 0, 0, 0, 0
+	};
+
+	if (!seen || !grid || !start || !target || seen->mapping ||
+		seen->rows != grid->rows || seen->cols != grid->cols)
+		return (NULL);
+
+	ctx.grid = grid;
+	ctx.seen = seen;
+	ctx.rows = grid->rows;
+	ctx.cols = grid->cols;
+	ctx.target = target;
+	ctx.max_steps = max_steps;
+	return (array_backtrack_run(&ctx, start));
+}
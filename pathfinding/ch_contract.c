@@ -0,0 +1,231 @@
+#include <stdlib.h>
+#include <limits.h>
+#include "pathfinding.h"
+
+#define ARC(ctx, a) ((ctx)->ch->arcs[a])
+#define LIVE(ctx, v) ((ctx)->ch->rank[v] == CH_NONE)
+#define WITNESS(ctx, v) (SP_WORKSPACE_SEEN((ctx)->ws, v) \
+	? (unsigned long)(ctx)->ws->entries[v].distance : ULONG_MAX)
+
+/* STATIC FUNCTIONS */
+
+static long ch_contract_in(ch_build_ctx_t *ctx, unsigned int v,
+	unsigned int in_arc, unsigned long max_out, int apply);
+
+static void ch_witness(ch_build_ctx_t *ctx, unsigned int source,
+	unsigned int skip, unsigned long limit);
+
+static int adj_push(ch_adj_t *adj, unsigned int arc);
+
+/* API IMPLEMENTATION */
+
+/**
+ * ch_contract - Simulates or performs the contraction of a vertex
+ *
+ * @ctx: Pointer to ch_build_ctx_t structure
+ * @v: Index of an uncontracted vertex
+ * @apply: 0 to only count shortcuts, non-0 to add them
+ *
+ * Return: Edge difference (shortcuts needed minus arcs removed),
+ *   LONG_MIN on failure
+ */
+long ch_contract(ch_build_ctx_t *ctx, unsigned int v, int apply)
+{
+	const ch_adj_t *in = &ctx->in[v], *out = &ctx->out[v];
+	unsigned long max_out = 0;
+	long diff = 0, added;
+	size_t i;
+
+	for (i = 0; i < out->size; ++i)
+	{
+		if (!LIVE(ctx, ARC(ctx, out->arcs[i]).head))
+			continue;
+		--diff;
+		if (ARC(ctx, out->arcs[i]).weight > max_out)
+			max_out = ARC(ctx, out->arcs[i]).weight;
+		ctx->deleted[ARC(ctx, out->arcs[i]).head] += apply != 0;
+	}
+
+	for (i = 0; i < in->size; ++i)
+	{
+		if (!LIVE(ctx, ARC(ctx, in->arcs[i]).tail))
+			continue;
+		--diff;
+		ctx->deleted[ARC(ctx, in->arcs[i]).tail] += apply != 0;
+		added = ch_contract_in(ctx, v, in->arcs[i], max_out, apply);
+		if (added < 0)
+			return (LONG_MIN);
+		diff += added;
+	}
+
+	return (diff);
+}
+
+/**
+ * ch_arc_add - Appends an arc to the hierarchy and its endpoints' lists
+ *
+ * @ctx: Pointer to ch_build_ctx_t structure
+ * @tail: Index of the source vertex
+ * @head: Index of the destination vertex
+ * @weight: Cost of the arc
+ * @child: Arcs a shortcut replaces, NULL for an original edge
+ *
+ * Return: Id of the new arc, CH_NONE on failure (or weight overflow)
+ */
+unsigned int ch_arc_add(ch_build_ctx_t *ctx, unsigned int tail,
+	unsigned int head, unsigned long weight, const unsigned int *child)
+{
+	ch_t *ch = ctx->ch;
+	ch_arc_t *arcs = NULL;
+	unsigned int id = (unsigned int)ch->nb_arcs;
+
+	if (weight >= CH_NONE || ch->nb_arcs >= CH_NONE - 1)
+		return (CH_NONE);
+
+	if (ch->nb_arcs == ctx->arcs_cap)
+	{
+		arcs = realloc(ch->arcs,
+			(ctx->arcs_cap * 2 + 64) * sizeof(ch_arc_t));
+		if (!arcs)
+			return (CH_NONE);
+		ch->arcs = arcs;
+		ctx->arcs_cap = ctx->arcs_cap * 2 + 64;
+	}
+
+	ch->arcs[id].tail = tail;
+	ch->arcs[id].head = head;
+	ch->arcs[id].weight = (unsigned int)weight;
+	ch->arcs[id].child[0] = child ? child[0] : CH_NONE;
+	ch->arcs[id].child[1] = child ? child[1] : CH_NONE;
+	ch->nb_shortcuts += child != NULL;
+	++ch->nb_arcs;
+
+	if (!adj_push(&ctx->out[tail], id) || !adj_push(&ctx->in[head], id))
+		return (CH_NONE);
+
+	return (id);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * ch_contract_in - Finds the shortcuts a contraction needs from one
+ * in-neighbour, and adds them if asked to
+ *
+ * @ctx: Pointer to ch_build_ctx_t structure
+ * @v: Index of the vertex being contracted
+ * @in_arc: Live arc (u, v)
+ * @max_out: Largest weight of v's live out-arcs
+ * @apply: Non-0 to add the shortcuts
+ *
+ * Return: Number of shortcuts needed, -1 on failure
+ */
+static long ch_contract_in(ch_build_ctx_t *ctx, unsigned int v,
+	unsigned int in_arc, unsigned long max_out, int apply)
+{
+	const ch_adj_t *out = &ctx->out[v];
+	unsigned int u = ARC(ctx, in_arc).tail, x, child[2];
+	unsigned long via;
+	long added = 0;
+	size_t j;
+
+	ch_witness(ctx, u, v, ARC(ctx, in_arc).weight + max_out);
+	child[0] = in_arc;
+
+	for (j = 0; j < out->size; ++j)
+	{
+		x = ARC(ctx, out->arcs[j]).head;
+		via = (unsigned long)ARC(ctx, in_arc).weight +
+			ARC(ctx, out->arcs[j]).weight;
+
+		if (x == u || !LIVE(ctx, x) || WITNESS(ctx, x) <= via)
+			continue;
+
+		++added;
+		child[1] = out->arcs[j];
+
+		if (!apply)
+			continue;
+
+		if (ch_arc_add(ctx, u, x, via, child) == CH_NONE)
+			return (-1);
+
+		/* The shortcut covers any parallel, heavier (v, x) arc */
+		SP_WORKSPACE_MARK(ctx->ws, x);
+		ctx->ws->entries[x].distance = (unsigned int)via;
+	}
+
+	return (added);
+}
+
+/**
+ * ch_witness - Bounded Dijkstra search from a vertex, avoiding another
+ * one and every contracted vertex; distances found (possibly not final,
+ * but each backed by a real path) are left in the workspace
+ *
+ * @ctx: Pointer to ch_build_ctx_t structure
+ * @source: Index of the search's source
+ * @skip: Index of the vertex being contracted
+ * @limit: Distance past which paths are no use as witnesses
+ */
+static void ch_witness(ch_build_ctx_t *ctx, unsigned int source,
+	unsigned int skip, unsigned long limit)
+{
+	sp_workspace_t *ws = ctx->ws;
+	unsigned long key, dist;
+	unsigned int head;
+	size_t id, i, settled = 0;
+
+	/* Distances are kept in 32 bits, as are arc weights */
+	if (limit >= CH_NONE)
+		limit = CH_NONE - 1;
+
+	sp_workspace_reset(ws);
+	SP_WORKSPACE_MARK(ws, source);
+	ws->entries[source].distance = 0;
+	sp_heap_push(ws->pq, source, 0);
+
+	while ((id = sp_heap_pop(ws->pq, &key)) != SP_HEAP_NONE &&
+		key <= limit && ++settled <= CH_WITNESS_SETTLE_LIMIT)
+	{
+		for (i = 0; i < ctx->out[id].size; ++i)
+		{
+			head = ARC(ctx, ctx->out[id].arcs[i]).head;
+			dist = key + ARC(ctx, ctx->out[id].arcs[i]).weight;
+
+			if (head == skip || !LIVE(ctx, head) || dist > limit ||
+				dist >= WITNESS(ctx, head))
+				continue;
+
+			SP_WORKSPACE_MARK(ws, head);
+			ws->entries[head].distance = (unsigned int)dist;
+			sp_heap_push(ws->pq, head, dist);
+		}
+	}
+}
+
+/**
+ * adj_push - Appends an arc id to a growable list
+ *
+ * @adj: Pointer to ch_adj_t structure
+ * @arc: Arc id
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int adj_push(ch_adj_t *adj, unsigned int arc)
+{
+	unsigned int *arcs = NULL;
+
+	if (adj->size == adj->cap)
+	{
+		arcs = realloc(adj->arcs,
+			(adj->cap * 2 + 4) * sizeof(unsigned int));
+		if (!arcs)
+			return (0);
+		adj->arcs = arcs;
+		adj->cap = adj->cap * 2 + 4;
+	}
+
+	adj->arcs[adj->size++] = arc;
+	return (1);
+}
@@ -0,0 +1,197 @@
+#include <stdlib.h>
+#include <limits.h>
+#include "pathfinding.h"
+
+/* Keeps contraction priorities (edge differences may be negative) unsigned */
+#define PRIORITY_BIAS (1UL << 31)
+#define PRIORITY(ctx, v, ed) \
+	(PRIORITY_BIAS + (unsigned long)((ed) + (long)(ctx)->deleted[v]))
+
+/* STATIC FUNCTIONS */
+
+static ch_build_ctx_t *ch_build_create(graph_t const *graph);
+
+static int ch_build_arcs(ch_build_ctx_t *ctx, graph_t const *graph);
+
+static void ch_build_delete(ch_build_ctx_t *ctx);
+
+static int ch_order(ch_build_ctx_t *ctx);
+
+/* API IMPLEMENTATION */
+
+/**
+ * ch_create - Preprocesses a graph into a Contraction Hierarchy
+ * Vertices are contracted in increasing order of edge difference (shortcuts
+ * added minus arcs removed) plus contracted neighbours, with priorities
+ * updated lazily; shortcuts are added only where a bounded witness search
+ * finds no path at least as short avoiding the contracted vertex
+ *
+ * @graph: Pointer to graph_t structure (non-negative weights)
+ *
+ * Return: Pointer to ch_t structure, NULL on failure
+ */
+ch_t *ch_create(graph_t const *graph)
+{
+	ch_build_ctx_t *ctx = NULL;
+	ch_t *ch = NULL;
+
+	if (!graph || graph->nb_vertices >= CH_NONE)
+		return (NULL);
+
+	ctx = ch_build_create(graph);
+
+	if (!ctx)
+		return (NULL);
+
+	if (ch_order(ctx) && ch_csr_build(ctx->ch))
+	{
+		ch = ctx->ch;
+		ctx->ch = NULL;
+	}
+
+	ch_build_delete(ctx);
+	return (ch);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * ch_build_create - Allocates preprocessing state, with one arc per edge
+ *
+ * @graph: Pointer to graph_t structure
+ *
+ * Return: Pointer to ch_build_ctx_t structure, NULL on failure
+ */
+static ch_build_ctx_t *ch_build_create(graph_t const *graph)
+{
+	ch_build_ctx_t *ctx = NULL;
+	size_t n = graph->nb_vertices;
+
+	ctx = calloc(1, sizeof(ch_build_ctx_t) + 2 * n * sizeof(ch_adj_t) +
+		n * sizeof(unsigned int));
+
+	if (!ctx)
+		return (NULL);
+
+	ctx->nb_vertices = n;
+	ctx->out = (ch_adj_t *)(ctx + 1);
+	ctx->in = ctx->out + n;
+	ctx->deleted = (unsigned int *)(ctx->in + n);
+	ctx->ch = calloc(1, sizeof(ch_t) + n * (sizeof(const vertex_t *) +
+		sizeof(unsigned int)));
+	ctx->ws = sp_workspace_create(n, SP_HEAP_DEFAULT);
+	ctx->order = sp_heap_create(SP_HEAP_DEFAULT, n);
+
+	if (!ctx->ch || !ctx->ws || !ctx->order || !ch_build_arcs(ctx, graph))
+	{
+		ch_build_delete(ctx);
+		return (NULL);
+	}
+
+	return (ctx);
+}
+
+/**
+ * ch_build_arcs - Turns every edge (but self-loops) into an original arc
+ *
+ * @ctx: Pointer to ch_build_ctx_t structure
+ * @graph: Pointer to graph_t structure
+ *
+ * Return: 1 on success, 0 on failure (or a negative weight)
+ */
+static int ch_build_arcs(ch_build_ctx_t *ctx, graph_t const *graph)
+{
+	ch_t *ch = ctx->ch;
+	const vertex_t *v = NULL;
+	const edge_t *e = NULL;
+
+	ch->nb_vertices = ctx->nb_vertices;
+	ch->vertices = (const vertex_t **)(ch + 1);
+	ch->rank = (unsigned int *)(ch->vertices + ctx->nb_vertices);
+
+	for (v = graph->vertices; v; v = v->next)
+	{
+		ch->vertices[v->index] = v;
+		ch->rank[v->index] = CH_NONE;
+
+		for (e = v->edges; e; e = e->next)
+		{
+			if (e->weight < 0)
+				return (0);
+
+			if (e->dest != v && ch_arc_add(ctx,
+				(unsigned int)v->index,
+				(unsigned int)e->dest->index,
+				(unsigned long)e->weight, NULL) == CH_NONE)
+				return (0);
+		}
+	}
+
+	return (1);
+}
+
+/**
+ * ch_build_delete - Frees preprocessing state (and the hierarchy, unless
+ * it was handed over)
+ *
+ * @ctx: Pointer to ch_build_ctx_t structure
+ */
+static void ch_build_delete(ch_build_ctx_t *ctx)
+{
+	size_t i;
+
+	for (i = 0; i < ctx->nb_vertices; ++i)
+	{
+		free(ctx->out[i].arcs);
+		free(ctx->in[i].arcs);
+	}
+
+	ch_delete(ctx->ch);
+	sp_workspace_delete(ctx->ws);
+	sp_heap_delete(ctx->order);
+	free(ctx);
+}
+
+/**
+ * ch_order - Contracts every vertex, cheapest first, assigning ranks
+ *
+ * @ctx: Pointer to ch_build_ctx_t structure
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int ch_order(ch_build_ctx_t *ctx)
+{
+	unsigned int v, next_rank = 0;
+	unsigned long key, top;
+	long ed;
+	size_t i;
+
+	for (v = 0; v < ctx->ch->nb_vertices; ++v)
+	{
+		ed = ch_contract(ctx, v, 0);
+		if (ed == LONG_MIN)
+			return (0);
+		sp_heap_push(ctx->order, v, PRIORITY(ctx, v, ed));
+	}
+
+	while ((i = sp_heap_pop(ctx->order, &key)) != SP_HEAP_NONE)
+	{
+		v = (unsigned int)i;
+		/* Lazy update: re-queue if its priority passed the next */
+		ed = ch_contract(ctx, v, 0);
+		if (ed == LONG_MIN)
+			return (0);
+		key = PRIORITY(ctx, v, ed);
+		if (sp_heap_peek(ctx->order, &top) != SP_HEAP_NONE && key > top)
+		{
+			sp_heap_push(ctx->order, v, key);
+			continue;
+		}
+
+		if (ch_contract(ctx, v, 1) == LONG_MIN)
+			return (0);
+		ctx->ch->rank[v] = next_rank++;
+	}
+
+	return (1);
+}
@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static ch_edge_t *ch_csr_fill(ch_t *ch, size_t **offsets, int upward);
+
+/* API IMPLEMENTATION */
+
+/**
+ * ch_csr_build - Renumbers a contracted hierarchy by rank, and lays out
+ * its arcs as the upward and downward CSR graphs a query climbs
+ *
+ * @ch: Pointer to ch_t structure with every vertex ranked
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int ch_csr_build(ch_t *ch)
+{
+	const vertex_t **by_rank = NULL;
+	size_t i;
+
+	by_rank = malloc((ch->nb_vertices + 1) * sizeof(const vertex_t *));
+	if (!by_rank)
+		return (0);
+
+	/* Renumbers by rank: the top of the hierarchy, which every query */
+	/* reaches, ends up packed at the end of each array */
+	for (i = 0; i < ch->nb_vertices; ++i)
+		by_rank[ch->rank[i]] = ch->vertices[i];
+	memcpy(ch->vertices, by_rank,
+		ch->nb_vertices * sizeof(const vertex_t *));
+	free(by_rank);
+
+	for (i = 0; i < ch->nb_arcs; ++i)
+	{
+		ch->arcs[i].tail = ch->rank[ch->arcs[i].tail];
+		ch->arcs[i].head = ch->rank[ch->arcs[i].head];
+	}
+
+	ch->up = ch_csr_fill(ch, &ch->up_offsets, 1);
+	ch->down = ch_csr_fill(ch, &ch->down_offsets, 0);
+
+	return (ch->up && ch->down);
+}
+
+/**
+ * ch_delete - Deallocates a Contraction Hierarchy
+ *
+ * @ch: Pointer to ch_t structure
+ */
+void ch_delete(ch_t *ch)
+{
+	if (!ch)
+		return;
+
+	free(ch->arcs);
+	free(ch->up_offsets);
+	free(ch->up);
+	free(ch->down_offsets);
+	free(ch->down);
+	free(ch);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * ch_csr_fill - Buckets the arcs going up the hierarchy by tail (upward),
+ * or the arcs coming down it by head (downward)
+ *
+ * @ch: Pointer to ch_t structure
+ * @offsets: Receives the allocated offsets array
+ * @upward: Non-0 for the upward graph
+ *
+ * Return: CSR entries, NULL on failure
+ */
+static ch_edge_t *ch_csr_fill(ch_t *ch, size_t **offsets, int upward)
+{
+	const ch_arc_t *arc = NULL;
+	ch_edge_t *edges = NULL;
+	size_t *fill = NULL, a, n = ch->nb_vertices, i;
+	unsigned int low, high;
+
+	*offsets = calloc(2 * n + 1, sizeof(size_t));
+	if (!*offsets)
+		return (NULL);
+	fill = *offsets + n + 1;
+
+	/* Every arc joins two distinct ranks: it is upward or downward */
+	for (a = 0; a < ch->nb_arcs; ++a)
+	{
+		arc = &ch->arcs[a];
+		low = upward ? arc->tail : arc->head;
+		high = upward ? arc->head : arc->tail;
+		if (low < high)
+			++(*offsets)[low + 1];
+	}
+
+	for (i = 0; i < n; ++i)
+	{
+		(*offsets)[i + 1] += (*offsets)[i];
+		fill[i] = (*offsets)[i];
+	}
+
+	edges = malloc(((*offsets)[n] + 1) * sizeof(ch_edge_t));
+	for (a = 0; edges && a < ch->nb_arcs; ++a)
+	{
+		arc = &ch->arcs[a];
+		low = upward ? arc->tail : arc->head;
+		high = upward ? arc->head : arc->tail;
+		if (low > high)
+			continue;
+		i = fill[low]++;
+		edges[i].vertex = high;
+		edges[i].weight = arc->weight;
+		edges[i].arc = (unsigned int)a;
+	}
+
+	return (edges);
+}
@@ -0,0 +1,199 @@
+#include <stdlib.h>
+#include <limits.h>
+#include "pathfinding.h"
+
+#define FORWARD 0
+#define BACKWARD 1
+
+/* STATIC FUNCTIONS */
+
+static int ch_search(ch_query_t *query, unsigned int start,
+	unsigned int target);
+
+static void ch_relax(ch_query_t *query, int side, unsigned int from,
+	const ch_edge_t *edge);
+
+static int ch_stalled(ch_query_t *query, int side, unsigned int v);
+
+static ch_query_entry_t *ch_entry(ch_query_t *query, unsigned int v);
+
+/* API IMPLEMENTATION */
+
+/**
+ * ch_query_distance - Computes a shortest-path distance on a hierarchy
+ * Both searches only climb (forward on upward arcs from start, backward on
+ * downward arcs from target); the best path turns at its highest vertex
+ *
+ * @query: Pointer to ch_query_t structure (see ch_query_create)
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @dist: If not NULL, receives the distance
+ *
+ * Return: 1 if target is reachable, 0 otherwise
+ */
+int ch_query_distance(ch_query_t *query, vertex_t const *start,
+	vertex_t const *target, unsigned long *dist)
+{
+	if (!query || !start || !target ||
+		start->index >= query->ch->nb_vertices ||
+		target->index >= query->ch->nb_vertices)
+		return (0);
+
+	if (!ch_search(query, query->ch->rank[start->index],
+		query->ch->rank[target->index]))
+		return (0);
+
+	if (dist)
+		*dist = query->best;
+
+	return (1);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * ch_search - Runs both upward searches, each until its smallest key can
+ * no longer improve on the best meeting found
+ *
+ * @query: Pointer to ch_query_t structure
+ * @start: Rank of source vertex
+ * @target: Rank of destination vertex
+ *
+ * Return: 1 if a path was found, 0 otherwise
+ */
+static int ch_search(ch_query_t *query, unsigned int start,
+	unsigned int target)
+{
+	const ch_t *ch = query->ch;
+	unsigned long top[2];
+	int live[2], side;
+	size_t id, i, end;
+
+	sp_heap_clear(query->pq[FORWARD]);
+	sp_heap_clear(query->pq[BACKWARD]);
+	if (!++query->epoch)
+	{
+		for (i = 0; i < ch->nb_vertices; ++i)
+			query->entries[i].epoch = 0;
+		query->epoch = 1;
+	}
+	query->stats.expanded = query->stats.relaxed = 0;
+	query->best = start == target ? 0 : ULONG_MAX;
+	query->meet = start == target ? start : CH_NONE;
+	ch_entry(query, start)->dist[FORWARD] = 0;
+	ch_entry(query, target)->dist[BACKWARD] = 0;
+	sp_heap_push(query->pq[FORWARD], start, 0);
+	sp_heap_push(query->pq[BACKWARD], target, 0);
+
+	for (;;)
+	{
+		live[FORWARD] = sp_heap_peek(query->pq[FORWARD],
+			&top[FORWARD]) != SP_HEAP_NONE &&
+			top[FORWARD] < query->best;
+		live[BACKWARD] = sp_heap_peek(query->pq[BACKWARD],
+			&top[BACKWARD]) != SP_HEAP_NONE &&
+			top[BACKWARD] < query->best;
+		if (!live[FORWARD] && !live[BACKWARD])
+			break;
+		side = !live[FORWARD] ||
+			(live[BACKWARD] && top[BACKWARD] < top[FORWARD]);
+		id = sp_heap_pop(query->pq[side], NULL);
+		if (ch_stalled(query, side, (unsigned int)id))
+			continue;
+		++query->stats.expanded;
+		i = side == FORWARD ? ch->up_offsets[id] : ch->down_offsets[id];
+		end = side == FORWARD ? ch->up_offsets[id + 1]
+			: ch->down_offsets[id + 1];
+		for (; i < end; ++i)
+			ch_relax(query, side, (unsigned int)id,
+				side == FORWARD ? &ch->up[i] : &ch->down[i]);
+	}
+
+	return (query->meet != CH_NONE);
+}
+
+/**
+ * ch_relax - Relaxes one upward (forward) or downward (backward) arc, and
+ * records the meeting point if the path through it beats the best one
+ *
+ * @query: Pointer to ch_query_t structure
+ * @side: FORWARD or BACKWARD
+ * @from: Rank of the vertex being settled
+ * @edge: CSR entry leading to a higher-ranked vertex
+ */
+static void ch_relax(ch_query_t *query, int side, unsigned int from,
+	const ch_edge_t *edge)
+{
+	ch_query_entry_t *entry = ch_entry(query, edge->vertex);
+	unsigned long dist = query->entries[from].dist[side] + edge->weight;
+
+	if (dist >= entry->dist[side])
+		return;
+
+	entry->dist[side] = dist;
+	entry->arc[side] = edge->arc;
+	++query->stats.relaxed;
+	sp_heap_push(query->pq[side], edge->vertex, dist);
+
+	if (entry->dist[!side] != ULONG_MAX &&
+		dist + entry->dist[!side] < query->best)
+	{
+		query->best = dist + entry->dist[!side];
+		query->meet = edge->vertex;
+	}
+}
+
+/**
+ * ch_stalled - Stall-on-demand: a vertex reached more cheaply through a
+ * higher-ranked neighbour (which an upward search cannot follow) is not on
+ * a shortest path, so its arcs need not be relaxed
+ *
+ * @query: Pointer to ch_query_t structure
+ * @side: FORWARD or BACKWARD
+ * @v: Rank of the vertex just popped
+ *
+ * Return: 1 if the vertex can be skipped, 0 otherwise
+ */
+static int ch_stalled(ch_query_t *query, int side, unsigned int v)
+{
+	const ch_t *ch = query->ch;
+	const ch_edge_t *edges = side == FORWARD ? ch->down : ch->up;
+	const size_t *offsets = side == FORWARD ? ch->down_offsets
+		: ch->up_offsets;
+	unsigned long dist = query->entries[v].dist[side], via;
+	size_t i;
+
+	/* Forward: arcs (w, v) from above; backward: arcs (v, w) to above */
+	for (i = offsets[v]; i < offsets[v + 1]; ++i)
+	{
+		via = ch_entry(query, edges[i].vertex)->dist[side];
+
+		if (via != ULONG_MAX && via + edges[i].weight < dist)
+			return (1);
+	}
+
+	return (0);
+}
+
+/**
+ * ch_entry - Looks up a vertex's entry, resetting it on first use in the
+ * current query
+ *
+ * @query: Pointer to ch_query_t structure
+ * @v: Rank of vertex
+ *
+ * Return: Pointer to the vertex's entry
+ */
+static ch_query_entry_t *ch_entry(ch_query_t *query, unsigned int v)
+{
+	ch_query_entry_t *entry = &query->entries[v];
+
+	if (entry->epoch != query->epoch)
+	{
+		entry->epoch = query->epoch;
+		entry->dist[FORWARD] = entry->dist[BACKWARD] = ULONG_MAX;
+		entry->arc[FORWARD] = entry->arc[BACKWARD] = CH_NONE;
+	}
+
+	return (entry);
+}
@@ -0,0 +1,181 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+#define ENTRY(query, v) ((query)->entries[v])
+
+/* STATIC FUNCTIONS */
+
+static int ch_unpack(ch_query_t *query, unsigned int arc, queue_t *path,
+	int front);
+
+/* API IMPLEMENTATION */
+
+/**
+ * ch_query_create - Allocates reusable query state for a hierarchy
+ *
+ * @ch: Pointer to ch_t structure
+ *
+ * Return: Pointer to ch_query_t structure, NULL on failure
+ */
+ch_query_t *ch_query_create(ch_t const *ch)
+{
+	ch_query_t *query = NULL;
+
+	if (!ch)
+		return (NULL);
+
+	query = calloc(1, sizeof(ch_query_t) + ch->nb_vertices *
+		sizeof(ch_query_entry_t) + (ch->nb_vertices + 1) *
+		sizeof(unsigned int));
+
+	if (!query)
+		return (NULL);
+
+	query->ch = ch;
+	query->entries = (ch_query_entry_t *)(query + 1);
+	query->stack = (unsigned int *)(query->entries + ch->nb_vertices);
+	query->pq[0] = sp_heap_create(SP_HEAP_DEFAULT, ch->nb_vertices);
+	query->pq[1] = sp_heap_create(SP_HEAP_DEFAULT, ch->nb_vertices);
+
+	if (!query->pq[0] || !query->pq[1])
+	{
+		ch_query_delete(query);
+		return (NULL);
+	}
+
+	return (query);
+}
+
+/**
+ * ch_query_delete - Deallocates query state
+ *
+ * @query: Pointer to ch_query_t structure
+ */
+void ch_query_delete(ch_query_t *query)
+{
+	if (!query)
+		return;
+
+	sp_heap_delete(query->pq[0]);
+	sp_heap_delete(query->pq[1]);
+	free(query);
+}
+
+/**
+ * ch_query_path - Retrieves a minimum cost path from a hierarchy, with
+ * every shortcut unpacked into the original vertices
+ *
+ * @query: Pointer to ch_query_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *ch_query_path(ch_query_t *query, vertex_t const *start,
+	vertex_t const *target)
+{
+	const ch_arc_t *arcs = NULL;
+	queue_t *path = NULL;
+	unsigned int v, arc;
+
+	if (!ch_query_distance(query, start, target, NULL))
+		return (NULL);
+
+	arcs = query->ch->arcs;
+	path = queue_create();
+
+	if (!path || !queue_push_back(path,
+		strdup(query->ch->vertices[query->meet]->content)))
+		goto on_fail;
+
+	for (v = query->meet; (arc = ENTRY(query, v).arc[0]) != CH_NONE;
+		v = arcs[arc].tail)
+		if (!ch_unpack(query, arc, path, 1))
+			goto on_fail;
+
+	for (v = query->meet; (arc = ENTRY(query, v).arc[1]) != CH_NONE;
+		v = arcs[arc].head)
+		if (!ch_unpack(query, arc, path, 0))
+			goto on_fail;
+
+	return (path);
+
+on_fail:
+	if (path)
+		queue_delete(path);
+	return (NULL);
+}
+
+/**
+ * ch_graph - Retrieves a minimum cost path from a hierarchy, with
+ * temporary query state
+ *
+ * @ch: Pointer to ch_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *ch_graph(ch_t const *ch, vertex_t const *start,
+	vertex_t const *target)
+{
+	ch_query_t *query = ch_query_create(ch);
+	queue_t *path = NULL;
+
+	if (!query)
+		return (NULL);
+
+	path = ch_query_path(query, start, target);
+	ch_query_delete(query);
+	return (path);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * ch_unpack - Expands an arc into original edges, adding their far
+ * endpoints to the path: tails at the front (walking back to start) or
+ * heads at the back (walking on to target)
+ *
+ * @query: Pointer to ch_query_t structure (its stack is used)
+ * @arc: Arc id
+ * @path: Path under construction
+ * @front: Non-0 to extend the front, 0 to extend the back
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int ch_unpack(ch_query_t *query, unsigned int arc, queue_t *path,
+	int front)
+{
+	const ch_arc_t *cur = NULL;
+	size_t top = 0;
+	char *content = NULL;
+
+	query->stack[top++] = arc;
+
+	while (top)
+	{
+		cur = &query->ch->arcs[query->stack[--top]];
+
+		if (cur->child[0] != CH_NONE)
+		{
+			/* (tail, mid) is last walking backwards, else first */
+			query->stack[top++] = cur->child[!front];
+			query->stack[top++] = cur->child[!!front];
+			continue;
+		}
+
+		content = strdup(query->ch->vertices[front
+			? cur->tail : cur->head]->content);
+
+		if (!content || !(front ? queue_push_front(path, content)
+			: queue_push_back(path, content)))
+		{
+			free(content);
+			return (0);
+		}
+	}
+
+	return (1);
+}
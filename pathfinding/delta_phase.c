@@ -0,0 +1,210 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int delta_lower(unsigned long *slot, unsigned long key);
+static int delta_push(delta_bucket_t *bucket, size_t v);
+static size_t delta_gather(delta_ctx_t *ctx, size_t slot);
+
+/* API IMPLEMENTATION */
+
+/**
+ * delta_relax - Relaxes the edges of one vertex that the phase calls for
+ * In a light phase, stale entries (a vertex since lowered to another
+ * distance, or already expanded at this one) are skipped
+ *
+ * @job: Pointer to the calling thread's delta_job_t structure
+ * @v: Index of the vertex
+ */
+void delta_relax(delta_job_t *job, size_t v)
+{
+	delta_ctx_t *ctx = job->ctx;
+	int light = ctx->phase == DELTA_LIGHT;
+	unsigned long d, to, key;
+	const edge_t *edge = NULL;
+	size_t bucket;
+	unsigned int old;
+
+	d = __atomic_load_n(ctx->key + v, __ATOMIC_RELAXED) >> 32;
+
+	if (light)
+	{
+		if (d / ctx->delta != ctx->bucket)
+			return;
+
+		old = __atomic_exchange_n(ctx->done + v, (unsigned int)d,
+			__ATOMIC_RELAXED);
+		if (old == d)
+			return;
+		if (old == ~0u)
+			ctx->settled[__atomic_fetch_add(&ctx->nb_settled, 1,
+				__ATOMIC_RELAXED)] = v;
+	}
+
+	for (edge = ctx->vertices[v]->edges; edge; edge = edge->next)
+	{
+		to = d + (unsigned long)edge->weight;
+		key = DELTA_KEY(to, v);
+
+		if (((unsigned long)edge->weight <= ctx->delta) != light ||
+			to >= DELTA_NONE ||
+			!delta_lower(ctx->key + edge->dest->index, key))
+			continue;
+
+		bucket = (size_t)(to / ctx->delta) % ctx->nb_buckets;
+
+		if (!delta_push(job->buckets + bucket, edge->dest->index))
+			__atomic_store_n(&ctx->failed, 1, __ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * delta_next - Serial step between phases: the current bucket again while
+ * light edges keep refilling it, then its heavy edges, then the next
+ * non-empty bucket
+ *
+ * @ctx: Pointer to delta_ctx_t structure
+ */
+void delta_next(delta_ctx_t *ctx)
+{
+	size_t i;
+
+	ctx->next = 0;
+
+	if (ctx->failed)
+	{
+		ctx->phase = DELTA_DONE;
+		return;
+	}
+
+	if (ctx->phase == DELTA_LIGHT)
+	{
+		ctx->nb_work = delta_gather(ctx, ctx->bucket % ctx->nb_buckets);
+		ctx->work = ctx->frontier.items;
+		if (ctx->nb_work)
+			return;
+
+		ctx->phase = DELTA_HEAVY;
+		ctx->work = ctx->settled;
+		ctx->nb_work = ctx->nb_settled;
+		if (ctx->nb_work)
+			return;
+	}
+
+	ctx->nb_settled = 0;
+
+	for (i = 1; i < ctx->nb_buckets; ++i)
+	{
+		ctx->nb_work = delta_gather(ctx,
+			(ctx->bucket + i) % ctx->nb_buckets);
+		ctx->work = ctx->frontier.items;
+
+		if (ctx->nb_work)
+		{
+			ctx->bucket += i;
+			ctx->phase = DELTA_LIGHT;
+			return;
+		}
+	}
+
+	ctx->phase = DELTA_DONE;
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * delta_lower - Replaces a shared key with `key` if its distance is smaller
+ * Equal distances keep the predecessor already there: switching between
+ * them could close a loop of predecessors over zero-weight edges
+ *
+ * @slot: Pointer to shared key
+ * @key: Candidate key
+ *
+ * Return: 1 if the key was replaced, 0 otherwise
+ */
+static int delta_lower(unsigned long *slot, unsigned long key)
+{
+	unsigned long cur = __atomic_load_n(slot, __ATOMIC_RELAXED);
+
+	while ((key >> 32) < (cur >> 32))
+	{
+		if (__atomic_compare_exchange_n(slot, &cur, key, 1,
+			__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return (1);
+	}
+
+	return (0);
+}
+
+/**
+ * delta_push - Appends a vertex to a bucket, growing it as needed
+ *
+ * @bucket: Pointer to delta_bucket_t structure (owned by the caller's
+ *   thread)
+ * @v: Index of the vertex
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int delta_push(delta_bucket_t *bucket, size_t v)
+{
+	size_t capacity = bucket->capacity ? 2 * bucket->capacity : 16;
+	size_t *items = NULL;
+
+	if (bucket->size == bucket->capacity)
+	{
+		items = realloc(bucket->items, capacity * sizeof(size_t));
+		if (!items)
+			return (0);
+		bucket->items = items;
+		bucket->capacity = capacity;
+	}
+
+	bucket->items[bucket->size++] = v;
+	return (1);
+}
+
+/**
+ * delta_gather - Moves every thread's share of a bucket to the frontier
+ *
+ * @ctx: Pointer to delta_ctx_t structure
+ * @slot: Index of the bucket in the cyclic array
+ *
+ * Return: Number of entries gathered, 0 on failure
+ */
+static size_t delta_gather(delta_ctx_t *ctx, size_t slot)
+{
+	delta_bucket_t *bucket = NULL, *frontier = &ctx->frontier;
+	size_t i, size = 0, *items = NULL;
+
+	for (i = 0; i < ctx->nb_jobs; ++i)
+		size += ctx->jobs[i].buckets[slot].size;
+
+	if (size > frontier->capacity)
+	{
+		items = realloc(frontier->items, size * sizeof(size_t));
+		if (!items)
+		{
+			ctx->failed = 1;
+			return (0);
+		}
+		frontier->items = items;
+		frontier->capacity = size;
+	}
+
+	frontier->size = 0;
+
+	for (i = 0; i < ctx->nb_jobs; ++i)
+	{
+		bucket = ctx->jobs[i].buckets + slot;
+		if (!bucket->size)
+			continue;
+		memcpy(frontier->items + frontier->size, bucket->items,
+			bucket->size * sizeof(size_t));
+		frontier->size += bucket->size;
+		bucket->size = 0;
+	}
+
+	return (frontier->size);
+}
@@ -0,0 +1,230 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int delta_setup(delta_ctx_t *ctx, graph_t const *graph,
+	unsigned long delta, size_t nb_threads);
+static void delta_teardown(delta_ctx_t *ctx, size_t nb_threads);
+static void *delta_worker(void *arg);
+
+/* API IMPLEMENTATION */
+
+/**
+ * delta_stepping - Single-source shortest paths to every vertex, with
+ * parallel delta-stepping (Meyer and Sanders)
+ * Tentative distances are sorted into buckets delta wide. The vertices of
+ * the lowest bucket relax their light edges in parallel, over and over
+ * until the bucket stays empty; their heavy edges, which cannot land back
+ * in it, are then relaxed once. Distances are lowered with atomic min, so
+ * threads never lock
+ *
+ * @graph: Pointer to graph_t structure (non-negative weights, fewer than
+ *   DELTA_NONE vertices)
+ * @source: Pointer to source vertex
+ * @delta: Bucket width (0 picks the heaviest edge over the mean degree);
+ *   1 behaves like Dijkstra, the heaviest edge like Bellman-Ford
+ * @nb_threads: Number of threads (0 means one per online CPU)
+ * @dist: Caller-owned array receiving the distance of every vertex, by
+ *   vertex_t.index (SP_UNREACHABLE if there is no path)
+ * @pred: Caller-owned array receiving the index of every vertex's
+ *   predecessor on a shortest path (SP_HEAP_NONE for the source and
+ *   unreached vertices), or NULL
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int delta_stepping(graph_t const *graph, vertex_t const *source,
+	unsigned long delta, size_t nb_threads, unsigned long *dist,
+	size_t *pred)
+{
+	long nb_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	pthread_t *tids = NULL;
+	delta_ctx_t ctx;
+	size_t i, started = 0;
+	unsigned long key;
+	int ok;
+
+	if (!graph || !source || !dist || graph->nb_vertices >= DELTA_NONE ||
+		source->index >= graph->nb_vertices)
+		return (0);
+
+	if (!nb_threads)
+		nb_threads = nb_cpus > 0 ? (size_t)nb_cpus : 1;
+	tids = malloc(nb_threads * sizeof(pthread_t));
+	ok = tids && delta_setup(&ctx, graph, delta, nb_threads);
+
+	if (ok)
+	{
+		ctx.key[source->index] = DELTA_KEY(0, DELTA_NONE);
+		ctx.jobs[0].buckets[0].items[0] = source->index;
+		ctx.jobs[0].buckets[0].size = 1;
+		ctx.nb_jobs = 1;
+		delta_next(&ctx);
+
+		pthread_mutex_lock(&ctx.gate);
+		for (i = 1; i < nb_threads; ++i)
+			started += !pthread_create(tids + started, NULL,
+				delta_worker, ctx.jobs + 1 + started);
+
+		/* Threads that failed to start only leave fewer to share */
+		ctx.nb_jobs = started + 1;
+		ok = !pthread_barrier_init(&ctx.barrier, NULL,
+			(unsigned int)ctx.nb_jobs);
+		if (!ok)
+			ctx.failed = 1, ctx.phase = DELTA_DONE;
+		pthread_mutex_unlock(&ctx.gate);
+
+		delta_worker(ctx.jobs);
+
+		for (i = 0; i < started; ++i)
+			pthread_join(tids[i], NULL);
+		if (ok)
+			pthread_barrier_destroy(&ctx.barrier);
+		ok = !ctx.failed;
+	}
+
+	for (i = 0; ok && i < ctx.nb_vertices; ++i)
+	{
+		key = ctx.key[i];
+		dist[i] = key == ~0UL ? SP_UNREACHABLE : key >> 32;
+		if (pred)
+			pred[i] = (key & DELTA_NONE) == DELTA_NONE ?
+				SP_HEAP_NONE : (size_t)(key & DELTA_NONE);
+	}
+
+	if (tids)
+		delta_teardown(&ctx, nb_threads);
+	free(tids);
+	return (ok);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * delta_setup - Allocates the shared state and every thread's buckets
+ *
+ * @ctx: Pointer to delta_ctx_t structure to fill
+ * @graph: Pointer to graph_t structure
+ * @delta: Bucket width, or 0 to pick one
+ * @nb_threads: Number of threads
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int delta_setup(delta_ctx_t *ctx, graph_t const *graph,
+	unsigned long delta, size_t nb_threads)
+{
+	size_t n = graph->nb_vertices, m = 0, i;
+	unsigned long heaviest = 1;
+	const vertex_t *v = NULL;
+	const edge_t *edge = NULL;
+	int ok;
+
+	memset(ctx, 0, sizeof(*ctx));
+	pthread_mutex_init(&ctx->gate, NULL);
+	ctx->nb_vertices = n;
+	ctx->key = malloc(n * (sizeof(unsigned long) + sizeof(vertex_t *) +
+		sizeof(size_t) + sizeof(unsigned int)));
+	ctx->jobs = calloc(nb_threads, sizeof(delta_job_t));
+	ok = ctx->key && ctx->jobs;
+
+	if (!ok)
+		return (0);
+
+	ctx->vertices = (const vertex_t **)(ctx->key + n);
+	ctx->settled = (size_t *)(ctx->vertices + n);
+	ctx->done = (unsigned int *)(ctx->settled + n);
+
+	for (v = graph->vertices; v; v = v->next)
+	{
+		ctx->vertices[v->index] = v;
+		ctx->key[v->index] = ~0UL;
+		ctx->done[v->index] = ~0u;
+
+		for (edge = v->edges, m += v->nb_edges; edge; edge = edge->next)
+			if ((unsigned long)edge->weight > heaviest)
+				heaviest = (unsigned long)edge->weight;
+	}
+
+	ctx->delta = delta ? delta : m ? heaviest * n / m : 1;
+	ctx->delta = ctx->delta ? ctx->delta : 1;
+	ctx->nb_buckets = (size_t)(heaviest / ctx->delta) + 2;
+
+	for (i = 0; ok && i < nb_threads; ++i)
+	{
+		ctx->jobs[i].ctx = ctx;
+		ctx->jobs[i].buckets = calloc(ctx->nb_buckets,
+			sizeof(delta_bucket_t));
+		ok = ctx->jobs[i].buckets != NULL;
+	}
+
+	if (!ok)
+		return (0);
+
+	/* Room for the source */
+	ctx->jobs[0].buckets[0].items = malloc(sizeof(size_t));
+	ctx->jobs[0].buckets[0].capacity = 1;
+	return (ctx->jobs[0].buckets[0].items != NULL);
+}
+
+/**
+ * delta_teardown - Frees what delta_setup allocated
+ *
+ * @ctx: Pointer to delta_ctx_t structure
+ * @nb_threads: Number of threads it was set up for
+ */
+static void delta_teardown(delta_ctx_t *ctx, size_t nb_threads)
+{
+	size_t i, b;
+
+	for (i = 0; ctx->jobs && i < nb_threads; ++i)
+	{
+		for (b = 0; ctx->jobs[i].buckets && b < ctx->nb_buckets; ++b)
+			free(ctx->jobs[i].buckets[b].items);
+		free(ctx->jobs[i].buckets);
+	}
+
+	free(ctx->jobs);
+	free(ctx->key);
+	free(ctx->frontier.items);
+	pthread_mutex_destroy(&ctx->gate);
+}
+
+/**
+ * delta_worker - Thread body: claims chunks of each phase's vertices, then
+ * waits for the others; one thread sets up the next phase in between
+ *
+ * @arg: Pointer to delta_job_t structure
+ *
+ * Return: `arg`
+ */
+static void *delta_worker(void *arg)
+{
+	delta_job_t *job = arg;
+	delta_ctx_t *ctx = job->ctx;
+	size_t i, end;
+
+	pthread_mutex_lock(&ctx->gate);
+	pthread_mutex_unlock(&ctx->gate);
+
+	/* Only the serial step changes the phase, so all threads agree on it */
+	while (ctx->phase != DELTA_DONE)
+	{
+		while ((i = __atomic_fetch_add(&ctx->next, DELTA_CHUNK,
+			__ATOMIC_RELAXED)) < ctx->nb_work)
+		{
+			end = i + DELTA_CHUNK < ctx->nb_work ? i + DELTA_CHUNK :
+				ctx->nb_work;
+			for (; i < end; ++i)
+				delta_relax(job, ctx->work[i]);
+		}
+
+		if (pthread_barrier_wait(&ctx->barrier) ==
+			PTHREAD_BARRIER_SERIAL_THREAD)
+			delta_next(ctx);
+		pthread_barrier_wait(&ctx->barrier);
+	}
+
+	return (arg);
+}
@@ -0,0 +1,60 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * dijkstra_bidi_ctx_create - Allocates/initializes dijkstra_bidi_ctx_t
+ *
+ * @in: Incoming-edge view of the graph searched
+ * @start: Pointer to start vertex
+ * @target: Pointer to target vertex
+ *
+ * Return: Pointer to new dijkstra_bidi_ctx_t instance, NULL on failure
+ */
+dijkstra_bidi_ctx_t *dijkstra_bidi_ctx_create(sp_in_edges_t const *in,
+	const vertex_t *start, const vertex_t *target)
+{
+	dijkstra_bidi_ctx_t *ctx = NULL;
+	size_t i;
+
+	ctx = calloc(1, sizeof(dijkstra_bidi_ctx_t) +
+		in->nb_vertices * sizeof(dijkstra_bidi_entry_t));
+
+	if (!ctx)
+		return (NULL);
+
+	ctx->pq[0] = sp_heap_create(SP_HEAP_DEFAULT, in->nb_vertices);
+	ctx->pq[1] = sp_heap_create(SP_HEAP_DEFAULT, in->nb_vertices);
+
+	if (!ctx->pq[0] || !ctx->pq[1])
+	{
+		dijkstra_bidi_ctx_delete(ctx);
+		return (NULL);
+	}
+
+	ctx->in = in;
+	ctx->entries = (dijkstra_bidi_entry_t *)(ctx + 1);
+
+	for (i = 0; i < in->nb_vertices; ++i)
+		ctx->entries[i].dist[0] = ctx->entries[i].dist[1] = ~0UL;
+
+	ctx->entries[start->index].dist[0] = 0;
+	ctx->entries[target->index].dist[1] = 0;
+	ctx->start = start;
+	ctx->target = target;
+	ctx->best = ~0UL;
+	return (ctx);
+}
+
+/**
+ * dijkstra_bidi_ctx_delete - Frees dijkstra_bidi_ctx_t resources
+ *
+ * @ctx: Pointer to dijkstra_bidi_ctx_t structure
+ */
+void dijkstra_bidi_ctx_delete(dijkstra_bidi_ctx_t *ctx)
+{
+	sp_heap_delete(ctx->pq[0]);
+	sp_heap_delete(ctx->pq[1]);
+	free(ctx);
+}
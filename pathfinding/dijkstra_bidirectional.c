@@ -0,0 +1,207 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+#define FORWARD 0
+#define BACKWARD 1
+#define ENTRY(ctx, v) ((ctx)->entries[(v)->index])
+#define UNREACHED (~0UL)
+
+/* STATIC FUNCTIONS */
+
+static int bidi_search(dijkstra_bidi_ctx_t *ctx);
+
+static void bidi_relax(dijkstra_bidi_ctx_t *ctx, int side,
+	const vertex_t *from, const vertex_t *to, int weight);
+
+static queue_t *bidi_path(dijkstra_bidi_ctx_t *ctx);
+
+/* API IMPLEMENTATION */
+
+/**
+ * dijkstra_bidirectional_graph - Retrieves minimum cost path by growing
+ * Dijkstra searches from both ends until they meet
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *dijkstra_bidirectional_graph(graph_t *graph, vertex_t const *start,
+	vertex_t const *target)
+{
+	sp_in_edges_t *in = NULL;
+	queue_t *path = NULL;
+
+	if (!graph || !start || !target)
+		return (NULL);
+
+	in = sp_in_edges_create(graph);
+
+	if (!in)
+		return (NULL);
+
+	path = dijkstra_bidirectional_in(in, start, target, NULL);
+	sp_in_edges_delete(in);
+	return (path);
+}
+
+/**
+ * dijkstra_bidirectional_in - dijkstra_bidirectional_graph reusing an
+ * incoming-edge view built once for many queries
+ *
+ * @in: Incoming-edge view of the graph (see sp_in_edges_create)
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @stats: If not NULL, receives the search's work counters
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *dijkstra_bidirectional_in(sp_in_edges_t const *in,
+	vertex_t const *start, vertex_t const *target, sp_stats_t *stats)
+{
+	dijkstra_bidi_ctx_t *ctx = NULL;
+	queue_t *path = NULL;
+
+	if (!in || !start || !target)
+		return (NULL);
+
+	ctx = dijkstra_bidi_ctx_create(in, start, target);
+
+	if (!ctx)
+		return (NULL);
+
+	if (bidi_search(ctx))
+		path = bidi_path(ctx);
+
+	if (stats)
+		*stats = ctx->stats;
+
+	dijkstra_bidi_ctx_delete(ctx);
+	return (path);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * bidi_search - Settles vertices from whichever frontier is closer
+ * Once the two smallest frontier keys add up to at least the best
+ * start-target cost seen, no unseen path can be shorter (any such path
+ * would cross an unsettled vertex on both sides), so the search stops
+ *
+ * @ctx: Pointer to context structure
+ *
+ * Return: 1 if a path exists, 0 otherwise
+ */
+static int bidi_search(dijkstra_bidi_ctx_t *ctx)
+{
+	const sp_in_edges_t *in = ctx->in;
+	const vertex_t *pos = NULL;
+	const edge_t *edge = NULL;
+	unsigned long top[2];
+	size_t id, i;
+	int side;
+
+	if (ctx->start == ctx->target)
+	{
+		ctx->meet = ctx->start;
+		return (1);
+	}
+
+	sp_heap_push(ctx->pq[FORWARD], ctx->start->index, 0);
+	sp_heap_push(ctx->pq[BACKWARD], ctx->target->index, 0);
+
+	while (sp_heap_peek(ctx->pq[FORWARD], &top[FORWARD]) != SP_HEAP_NONE &&
+		sp_heap_peek(ctx->pq[BACKWARD], &top[BACKWARD]) != SP_HEAP_NONE)
+	{
+		if (ctx->best != UNREACHED &&
+			top[FORWARD] + top[BACKWARD] >= ctx->best)
+			break;
+
+		side = top[BACKWARD] < top[FORWARD] ? BACKWARD : FORWARD;
+		id = sp_heap_pop(ctx->pq[side], NULL);
+		pos = in->vertices[id];
+		++ctx->stats.expanded;
+
+		if (side == FORWARD)
+		{
+			for (edge = pos->edges; edge; edge = edge->next)
+				bidi_relax(ctx, FORWARD, pos, edge->dest,
+					edge->weight);
+			continue;
+		}
+
+		for (i = in->offsets[id]; i < in->offsets[id + 1]; ++i)
+			bidi_relax(ctx, BACKWARD, pos, in->sources[i],
+				in->weights[i]);
+	}
+
+	return (ctx->meet != NULL);
+}
+
+/**
+ * bidi_relax - Relaxes one edge for one direction, and records the
+ * start-target path through its end if that beats the best one so far
+ *
+ * @ctx: Pointer to context structure
+ * @side: FORWARD or BACKWARD
+ * @from: Vertex being settled
+ * @to: Neighbour in the search direction
+ * @weight: Edge weight
+ */
+static void bidi_relax(dijkstra_bidi_ctx_t *ctx, int side,
+	const vertex_t *from, const vertex_t *to, int weight)
+{
+	dijkstra_bidi_entry_t *entry = &ENTRY(ctx, to);
+	unsigned long dist = ENTRY(ctx, from).dist[side];
+
+	dist += (unsigned long)weight;
+	if (dist >= entry->dist[side])
+		return;
+
+	entry->dist[side] = dist;
+	entry->next[side] = from;
+	++ctx->stats.relaxed;
+	sp_heap_push(ctx->pq[side], to->index, dist);
+
+	if (entry->dist[!side] != UNREACHED &&
+		dist + entry->dist[!side] < ctx->best)
+	{
+		ctx->best = dist + entry->dist[!side];
+		ctx->meet = to;
+	}
+}
+
+/**
+ * bidi_path - Stitches the forward half (start to meet) and the backward
+ * half (meet to target) into one path
+ *
+ * @ctx: Pointer to context structure
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+static queue_t *bidi_path(dijkstra_bidi_ctx_t *ctx)
+{
+	queue_t *path = queue_create();
+	const vertex_t *pos = NULL;
+
+	for (pos = ctx->meet; path && pos; pos = ENTRY(ctx, pos).next[FORWARD])
+	{
+		if (!queue_push_front(path, strdup(pos->content)))
+			goto on_fail;
+	}
+
+	for (pos = ENTRY(ctx, ctx->meet).next[BACKWARD]; path && pos;
+		pos = ENTRY(ctx, pos).next[BACKWARD])
+	{
+		if (!queue_push_back(path, strdup(pos->content)))
+			goto on_fail;
+	}
+
+	return (path);
+
+on_fail:
+	queue_delete(path);
+	return (NULL);
+}
@@ -0,0 +1,112 @@
+#include "sp_kernel.h"
+
+/* STATIC FUNCTIONS */
+
+SP_KERNEL_DEFINE(kernel_f32, float, 4, SP_KERNEL_POSITIVE)
+SP_KERNEL_DEFINE(kernel_f64, double, 4, SP_KERNEL_POSITIVE)
+
+/* API IMPLEMENTATION */
+
+/**
+ * dijkstra_graph_f32 - dijkstra_graph on the single precision kernel
+ * Same results as dijkstra_graph, the float kernel being exact on the
+ * integer costs below 2^24
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *dijkstra_graph_f32(graph_t *graph, vertex_t const *start,
+	vertex_t const *target)
+{
+	sp_path_t path = { NULL, 0, 0, 0, 0 };
+	queue_t *queue = NULL;
+
+	if (dijkstra_graph_f32_weighted(graph, start, target, NULL, NULL,
+		&path, NULL))
+		queue = sp_path_to_queue(&path);
+
+	sp_path_release(&path);
+	return (queue);
+}
+
+/**
+ * dijkstra_graph_f32_weighted - Minimum cost path with single precision
+ * weights and distances
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @weight: Weight of each edge (negative or NaN ones are skipped), or NULL
+ *   to use edge_t.weight
+ * @data: Passed to @weight
+ * @path: Receives the path, and its cost rounded down (see sp_path_t)
+ * @cost: Receives the cost of the path, or NULL
+ *
+ * Return: 1 on success, 0 if there is no path or on failure
+ */
+int dijkstra_graph_f32_weighted(graph_t const *graph, vertex_t const *start,
+	vertex_t const *target, sp_weight_f32_t weight, void *data,
+	sp_path_t *path, float *cost)
+{
+	if (!graph || !start || !target || !path ||
+		start->index >= graph->nb_vertices ||
+		target->index >= graph->nb_vertices)
+		return (0);
+
+	return (kernel_f32(graph, start, target, weight, data, path, cost));
+}
+
+/**
+ * dijkstra_graph_f64 - dijkstra_graph on the double precision kernel
+ * Same results as dijkstra_graph, the double kernel being exact on the
+ * integer costs below 2^53
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *dijkstra_graph_f64(graph_t *graph, vertex_t const *start,
+	vertex_t const *target)
+{
+	sp_path_t path = { NULL, 0, 0, 0, 0 };
+	queue_t *queue = NULL;
+
+	if (dijkstra_graph_f64_weighted(graph, start, target, NULL, NULL,
+		&path, NULL))
+		queue = sp_path_to_queue(&path);
+
+	sp_path_release(&path);
+	return (queue);
+}
+
+/**
+ * dijkstra_graph_f64_weighted - Minimum cost path with double precision
+ * weights and distances
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @weight: Weight of each edge (negative or NaN ones are skipped), or NULL
+ *   to use edge_t.weight
+ * @data: Passed to @weight
+ * @path: Receives the path, and its cost rounded down (see sp_path_t)
+ * @cost: Receives the cost of the path, or NULL
+ *
+ * Return: 1 on success, 0 if there is no path or on failure
+ */
+int dijkstra_graph_f64_weighted(graph_t const *graph, vertex_t const *start,
+	vertex_t const *target, sp_weight_f64_t weight, void *data,
+	sp_path_t *path, double *cost)
+{
+	if (!graph || !start || !target || !path ||
+		start->index >= graph->nb_vertices ||
+		target->index >= graph->nb_vertices)
+		return (0);
+
+	return (kernel_f64(graph, start, target, weight, data, path, cost));
+}
@@ -0,0 +1,108 @@
+#include "sp_kernel.h"
+
+/* STATIC FUNCTIONS */
+
+SP_KERNEL_DEFINE(kernel_u32, unsigned int, 4, SP_KERNEL_ANY)
+SP_KERNEL_DEFINE(kernel_u64, unsigned long, 4, SP_KERNEL_ANY)
+
+/* API IMPLEMENTATION */
+
+/**
+ * dijkstra_graph_u32 - dijkstra_graph on the 32-bit unsigned kernel
+ * Paths whose cost would pass UINT_MAX are not followed
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *dijkstra_graph_u32(graph_t *graph, vertex_t const *start,
+	vertex_t const *target)
+{
+	sp_path_t path = { NULL, 0, 0, 0, 0 };
+	queue_t *queue = NULL;
+
+	if (dijkstra_graph_u32_weighted(graph, start, target, NULL, NULL,
+		&path, NULL))
+		queue = sp_path_to_queue(&path);
+
+	sp_path_release(&path);
+	return (queue);
+}
+
+/**
+ * dijkstra_graph_u32_weighted - Minimum cost path with 32-bit unsigned
+ * weights and distances
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @weight: Weight of each edge, or NULL to use edge_t.weight
+ * @data: Passed to @weight
+ * @path: Receives the path and its cost (see sp_path_t)
+ * @cost: Receives the cost of the path, or NULL
+ *
+ * Return: 1 on success, 0 if there is no path or on failure
+ */
+int dijkstra_graph_u32_weighted(graph_t const *graph, vertex_t const *start,
+	vertex_t const *target, sp_weight_u32_t weight, void *data,
+	sp_path_t *path, unsigned int *cost)
+{
+	if (!graph || !start || !target || !path ||
+		start->index >= graph->nb_vertices ||
+		target->index >= graph->nb_vertices)
+		return (0);
+
+	return (kernel_u32(graph, start, target, weight, data, path, cost));
+}
+
+/**
+ * dijkstra_graph_u64 - dijkstra_graph on the 64-bit unsigned kernel
+ * Distances no longer overflow on long routes
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *dijkstra_graph_u64(graph_t *graph, vertex_t const *start,
+	vertex_t const *target)
+{
+	sp_path_t path = { NULL, 0, 0, 0, 0 };
+	queue_t *queue = NULL;
+
+	if (dijkstra_graph_u64_weighted(graph, start, target, NULL, NULL,
+		&path, NULL))
+		queue = sp_path_to_queue(&path);
+
+	sp_path_release(&path);
+	return (queue);
+}
+
+/**
+ * dijkstra_graph_u64_weighted - Minimum cost path with 64-bit unsigned
+ * weights and distances
+ *
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @weight: Weight of each edge, or NULL to use edge_t.weight
+ * @data: Passed to @weight
+ * @path: Receives the path and its cost (see sp_path_t)
+ * @cost: Receives the cost of the path, or NULL
+ *
+ * Return: 1 on success, 0 if there is no path or on failure
+ */
+int dijkstra_graph_u64_weighted(graph_t const *graph, vertex_t const *start,
+	vertex_t const *target, sp_weight_u64_t weight, void *data,
+	sp_path_t *path, unsigned long *cost)
+{
+	if (!graph || !start || !target || !path ||
+		start->index >= graph->nb_vertices ||
+		target->index >= graph->nb_vertices)
+		return (0);
+
+	return (kernel_u64(graph, start, target, weight, data, path, cost));
+}
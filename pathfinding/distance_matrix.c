@@ -0,0 +1,218 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+#define INFINITY (~0u >> 1) /* max value for unsigned 31-bit integer */
+
+/* STATIC FUNCTIONS */
+
+static void *matrix_worker(void *arg);
+
+static int matrix_row(distance_matrix_ctx_t *ctx, sp_workspace_t *ws,
+	size_t row);
+
+static int matrix_targets(distance_matrix_ctx_t *ctx,
+	vertex_t const * const *targets);
+
+/* API IMPLEMENTATION */
+
+/**
+ * distance_matrix - Computes shortest-path distances from every source to
+ * every target, using one thread per online CPU
+ *
+ * @graph: Pointer to graph_t structure
+ * @sources: Source vertices
+ * @n: Number of sources
+ * @targets: Target vertices
+ * @m: Number of targets
+ * @out: Caller-owned array of n * m distances, row-major
+ *   (out[i * m + j] is from sources[i] to targets[j], SP_UNREACHABLE if
+ *   there is no path)
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int distance_matrix(graph_t *graph, vertex_t const * const *sources,
+	size_t n, vertex_t const * const *targets, size_t m, unsigned long *out)
+{
+	long nb_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (distance_matrix_threads(graph, sources, n, targets, m, out,
+		nb_cpus > 0 ? (size_t)nb_cpus : 1));
+}
+
+/**
+ * distance_matrix_threads - distance_matrix with a chosen number of threads
+ * Each source runs one search that stops once every target is settled;
+ * threads claim sources one at a time and own a workspace each
+ *
+ * @graph: Pointer to graph_t structure
+ * @sources: Source vertices
+ * @n: Number of sources
+ * @targets: Target vertices
+ * @m: Number of targets
+ * @out: Caller-owned array of n * m distances, row-major
+ * @nb_threads: Number of threads (0 means 1, never more than n)
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int distance_matrix_threads(graph_t *graph, vertex_t const * const *sources,
+	size_t n, vertex_t const * const *targets, size_t m, unsigned long *out,
+	size_t nb_threads)
+{
+	distance_matrix_ctx_t ctx = { NULL, NULL, 0, 0, 0, NULL, NULL, NULL,
+		0, 0 };
+	distance_matrix_job_t *jobs = NULL;
+	pthread_t *tids = NULL;
+	size_t i, started = 0;
+
+	if (!graph || (n && (!sources || !out)) || (m && !targets))
+		return (0);
+	nb_threads = nb_threads < n ? nb_threads : n;
+	nb_threads = nb_threads ? nb_threads : 1;
+	ctx.graph = graph, ctx.sources = sources, ctx.out = out;
+	ctx.nb_sources = n, ctx.nb_targets = m;
+	jobs = calloc(nb_threads, sizeof(distance_matrix_job_t));
+	tids = malloc(nb_threads * sizeof(pthread_t));
+	ctx.failed = !jobs || !tids || !matrix_targets(&ctx, targets);
+
+	for (i = 0; !ctx.failed && i < nb_threads; ++i)
+	{
+		jobs[i].ctx = &ctx;
+		jobs[i].ws = sp_workspace_create_for(graph, SP_HEAP_AUTO);
+		ctx.failed = !jobs[i].ws;
+	}
+
+	for (i = 1; !ctx.failed && i < nb_threads; ++i)
+		started += !pthread_create(tids + started, NULL, matrix_worker,
+			jobs + i);
+
+	/* Sources are claimed dynamically: threads that failed to start */
+	/* simply leave their share to the others */
+	if (!ctx.failed)
+		matrix_worker(jobs);
+
+	for (i = 0; i < started; ++i)
+		pthread_join(tids[i], NULL);
+
+	for (i = 0; jobs && i < nb_threads; ++i)
+		sp_workspace_delete(jobs[i].ws);
+	free(jobs), free(tids), free(ctx.first);
+	return (!ctx.failed);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * matrix_worker - Thread body: computes rows until none is left
+ *
+ * @arg: Pointer to distance_matrix_job_t structure
+ *
+ * Return: `arg`
+ */
+static void *matrix_worker(void *arg)
+{
+	distance_matrix_job_t *job = arg;
+	distance_matrix_ctx_t *ctx = job->ctx;
+	size_t row;
+
+	while ((row = __atomic_fetch_add(&ctx->next_source, 1,
+		__ATOMIC_RELAXED)) < ctx->nb_sources)
+	{
+		if (!matrix_row(ctx, job->ws, row))
+			__atomic_store_n(&ctx->failed, 1, __ATOMIC_RELAXED);
+	}
+
+	return (arg);
+}
+
+/**
+ * matrix_row - One-to-many Dijkstra search from one source, stopped as
+ * soon as every distinct target has been settled
+ *
+ * @ctx: Pointer to shared state
+ * @ws: Thread's workspace
+ * @row: Index of the source
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int matrix_row(distance_matrix_ctx_t *ctx, sp_workspace_t *ws,
+	size_t row)
+{
+	unsigned long *out = ctx->out + row * ctx->nb_targets;
+	size_t left = ctx->nb_distinct, id, col;
+	dijkstra_entry_t *entry = NULL;
+	const edge_t *edge = NULL;
+	unsigned long key;
+
+	for (col = 0; col < ctx->nb_targets; ++col)
+		out[col] = SP_UNREACHABLE;
+	sp_workspace_reset(ws);
+	id = ctx->sources[row]->index;
+	SP_WORKSPACE_MARK(ws, id);
+	ws->entries[id].distance = 0;
+	ws->entries[id].vertex = ctx->sources[row];
+	sp_heap_push(ws->pq, id, 0);
+
+	while (left && (id = sp_heap_pop(ws->pq, &key)) != SP_HEAP_NONE)
+	{
+		for (col = ctx->first[id], left -= col != SP_HEAP_NONE;
+			col != SP_HEAP_NONE; col = ctx->next[col])
+			out[col] = key;
+
+		for (edge = ws->entries[id].vertex->edges; edge;
+			edge = edge->next)
+		{
+			entry = &ws->entries[edge->dest->index];
+			key = ws->entries[id].distance +
+				(unsigned int)edge->weight;
+			if (SP_WORKSPACE_SEEN(ws, edge->dest->index) &&
+				key >= entry->distance)
+				continue;
+			SP_WORKSPACE_MARK(ws, edge->dest->index);
+			entry->distance = (unsigned int)key;
+			entry->vertex = edge->dest;
+			if (!sp_heap_push(ws->pq, edge->dest->index, key))
+				return (0);
+		}
+	}
+
+	return (1);
+}
+
+/**
+ * matrix_targets - Indexes target columns by vertex, so a settled vertex
+ * finds its columns (targets may repeat) in O(1)
+ *
+ * @ctx: Pointer to shared state
+ * @targets: Target vertices
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int matrix_targets(distance_matrix_ctx_t *ctx,
+	vertex_t const * const *targets)
+{
+	size_t n = ctx->graph->nb_vertices, i, col, v;
+
+	ctx->first = malloc((n + ctx->nb_targets + 1) * sizeof(size_t));
+
+	if (!ctx->first)
+		return (0);
+
+	ctx->next = ctx->first + n;
+
+	for (i = 0; i < n; ++i)
+		ctx->first[i] = SP_HEAP_NONE;
+
+	for (col = ctx->nb_targets; col--;)
+	{
+		v = targets[col]->index;
+		if (v >= n)
+			return (0);
+		ctx->nb_distinct += ctx->first[v] == SP_HEAP_NONE;
+		ctx->next[col] = ctx->first[v];
+		ctx->first[v] = col;
+	}
+
+	return (1);
+}
@@ -0,0 +1,227 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static queue_t *dstar_path(dstar_t const *dstar);
+static int dstar_path_push(queue_t *path, int x, int y);
+
+/* API IMPLEMENTATION */
+
+/**
+ * dstar_create - Creates a D* Lite planner and plans a first path (read
+ * it with dstar_update, nothing changed)
+ * Keys pack two 32-bit halves into an unsigned long, so costs to the target
+ * must stay below 2^32 (as for flow fields)
+ *
+ * @terrain: Pointer to grid_terrain_t structure (copied, but the arrays it
+ *   points to are not: keep them alive, and report changes to them through
+ *   dstar_update)
+ * @start: Pointer to point_t for the agent's coordinates
+ * @target: Pointer to point_t for the target coordinates
+ * @connectivity: 4 or 8 (diagonal steps never cut a blocked corner)
+ *
+ * Return: Pointer to dstar_t structure, NULL on failure
+ */
+dstar_t *dstar_create(grid_terrain_t const *terrain, point_t const *start,
+	point_t const *target, int connectivity)
+{
+	dstar_t *dstar = NULL;
+	size_t cells, i;
+
+	if (!terrain || !start || !target ||
+		(connectivity != 4 && connectivity != 8) ||
+		terrain->rows <= 0 || terrain->cols <= 0 ||
+		!GRID_IN(terrain, start->x, start->y) ||
+		!GRID_IN(terrain, target->x, target->y))
+		return (NULL);
+
+	cells = (size_t)terrain->rows * (size_t)terrain->cols;
+	dstar = calloc(1, sizeof(dstar_t) + 2 * cells * sizeof(unsigned int));
+
+	if (!dstar)
+		return (NULL);
+
+	dstar->pq = sp_heap_create(SP_HEAP_DEFAULT, cells);
+
+	if (!dstar->pq)
+	{
+		free(dstar);
+		return (NULL);
+	}
+
+	dstar->terrain = *terrain;
+	dstar->connectivity = connectivity;
+	dstar->start = *start;
+	dstar->last = *start;
+	dstar->target = *target;
+	dstar->g = (unsigned int *)(dstar + 1);
+	dstar->rhs = dstar->g + cells;
+
+	for (i = 0; i < cells; ++i)
+		dstar->g[i] = DSTAR_INFINITY, dstar->rhs[i] = DSTAR_INFINITY;
+
+	i = GRID_CELL(terrain, target->x, target->y);
+	dstar->rhs[i] = 0;
+	sp_heap_push(dstar->pq, i, DSTAR_KEY(dstar_estimate(dstar, target->x,
+		target->y), 0));
+	dstar_compute(dstar);
+	return (dstar);
+}
+
+/**
+ * dstar_delete - Deallocates a D* Lite planner
+ *
+ * @dstar: Pointer to dstar_t structure
+ */
+void dstar_delete(dstar_t *dstar)
+{
+	if (!dstar)
+		return;
+
+	sp_heap_delete(dstar->pq);
+	free(dstar);
+}
+
+/**
+ * dstar_update - Moves the agent, repairs the plan around the cells that
+ * changed, and returns the new path
+ * Only the moves between a changed cell and its eight neighbours can have
+ * changed, so only the rhs of those 3x3 blocks is recomputed; the repair
+ * then spreads only as far as costs to the target actually changed
+ *
+ * @dstar: Pointer to dstar_t structure
+ * @start: Agent's new coordinates, or NULL if it did not move
+ * @changed: Coordinates of the cells whose cost changed since the last
+ *   plan (out of range ones are ignored)
+ * @nb_changed: Number of cells in @changed
+ *
+ * Return: Pointer to queue_t of point_t from the agent to the target, NULL
+ *   on failure or if there is no path
+ */
+queue_t *dstar_update(dstar_t *dstar, point_t const *start,
+	point_t const *changed, size_t nb_changed)
+{
+	size_t i;
+	int dx, dy;
+
+	if (!dstar || (nb_changed && !changed) ||
+		(start && !GRID_IN(&dstar->terrain, start->x, start->y)))
+		return (NULL);
+
+	dstar->stats.expanded = 0;
+	dstar->stats.relaxed = 0;
+
+	/* Rather than rekeying the queue, later keys grow by the distance */
+	if (start)
+	{
+		dstar->start = *start;
+		dstar->km += dstar_estimate(dstar, dstar->last.x,
+			dstar->last.y);
+		dstar->last = *start;
+	}
+
+	for (i = 0; i < nb_changed; ++i)
+	{
+		for (dy = -1; dy <= 1; ++dy)
+			for (dx = -1; dx <= 1; ++dx)
+				dstar_vertex(dstar, changed[i].x + dx,
+					changed[i].y + dy);
+	}
+
+	if (!dstar_compute(dstar))
+		return (NULL);
+
+	return (dstar_path(dstar));
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * dstar_path - Follows the cheapest moves from the agent to the target
+ *
+ * @dstar: Pointer to dstar_t structure, its plan up to date
+ *
+ * Return: Pointer to queue_t of point_t, NULL on failure or if there is no
+ *   path
+ */
+static queue_t *dstar_path(dstar_t const *dstar)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_terrain_t *terrain = &dstar->terrain;
+	int x = dstar->start.x, y = dstar->start.y, d, best;
+	unsigned long cost, best_cost, g;
+	size_t steps = (size_t)terrain->rows * (size_t)terrain->cols;
+	queue_t *path = NULL;
+	point_t *point = NULL;
+	int ok;
+
+	if (!grid_terrain_cost(terrain, x, y))
+		return (NULL);
+
+	path = queue_create();
+	ok = path && dstar_path_push(path, x, y);
+
+	while (ok && (x != dstar->target.x || y != dstar->target.y))
+	{
+		/* Each step strictly lowers g, so this ends within steps */
+		for (d = 0, best = -1, best_cost = 0; d < dstar->connectivity;
+			++d)
+		{
+			cost = dstar_step(dstar, x, y, d);
+
+			if (!cost)
+				continue;
+
+			g = dstar->g[GRID_CELL(terrain, x + dx[d], y + dy[d])];
+
+			if (g != DSTAR_INFINITY && (best < 0 ||
+				cost + g < best_cost))
+				best = d, best_cost = cost + g;
+		}
+
+		ok = best >= 0 && steps-- > 0;
+		x += ok ? dx[best] : 0;
+		y += ok ? dy[best] : 0;
+		ok = ok && dstar_path_push(path, x, y);
+	}
+
+	if (!ok && path)
+	{
+		while ((point = dequeue(path)))
+			free(point);
+		queue_delete(path);
+		path = NULL;
+	}
+
+	return (path);
+}
+
+/**
+ * dstar_path_push - Appends a point to a path
+ *
+ * @path: Pointer to queue_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int dstar_path_push(queue_t *path, int x, int y)
+{
+	point_t *point = calloc(1, sizeof(point_t));
+
+	if (!point)
+		return (0);
+
+	point->x = x;
+	point->y = y;
+
+	if (!queue_push_back(path, point))
+	{
+		free(point);
+		return (0);
+	}
+
+	return (1);
+}
@@ -0,0 +1,214 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+#define ABS(a) ((a) < 0 ? -(a) : (a))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/* STATIC FUNCTIONS */
+
+static unsigned long dstar_key(dstar_t const *dstar, size_t cell);
+
+/* API IMPLEMENTATION */
+
+/**
+ * dstar_compute - Brings the planner's g values up to date for the agent's
+ * cell (D* Lite's ComputeShortestPath)
+ * Overconsistent cells (g > rhs) settle, underconsistent ones are reset to
+ * infinity and queued again; only cells whose cost to the target changed
+ * are ever expanded
+ *
+ * @dstar: Pointer to dstar_t structure
+ *
+ * Return: 1 if the target can be reached from the agent's cell, 0 if not
+ */
+int dstar_compute(dstar_t *dstar)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_terrain_t *terrain = &dstar->terrain;
+	size_t start = GRID_CELL(terrain, dstar->start.x, dstar->start.y);
+	size_t cell, pred, target;
+	unsigned long key, cost;
+	int x, y, d;
+
+	target = GRID_CELL(terrain, dstar->target.x, dstar->target.y);
+
+	while ((cell = sp_heap_peek(dstar->pq, &key)) != SP_HEAP_NONE &&
+		(key < dstar_key(dstar, start) ||
+		dstar->g[start] != dstar->rhs[start]))
+	{
+		sp_heap_pop(dstar->pq, NULL);
+
+		/* Consistent cells are left queued rather than removed */
+		if (dstar->g[cell] == dstar->rhs[cell])
+			continue;
+
+		/* Queued keys only lag behind: requeue with the real one */
+		if (key < dstar_key(dstar, cell))
+		{
+			sp_heap_push(dstar->pq, cell, dstar_key(dstar, cell));
+			continue;
+		}
+
+		++dstar->stats.expanded;
+		x = (int)(cell % (size_t)terrain->cols);
+		y = (int)(cell / (size_t)terrain->cols);
+
+		if (dstar->g[cell] > dstar->rhs[cell])
+			dstar->g[cell] = dstar->rhs[cell];
+		else
+		{
+			dstar->g[cell] = DSTAR_INFINITY;
+			dstar_vertex(dstar, x, y);
+		}
+
+		for (d = 0; d < dstar->connectivity; ++d)
+		{
+			cost = dstar_step(dstar, x - dx[d], y - dy[d], d);
+
+			if (!cost)
+				continue;
+
+			pred = GRID_CELL(terrain, x - dx[d], y - dy[d]);
+
+			/* A lower g can only lower its predecessors' rhs */
+			if (dstar->g[cell] == DSTAR_INFINITY)
+				dstar_vertex(dstar, x - dx[d], y - dy[d]);
+			else if (pred != target &&
+				cost + dstar->g[cell] < dstar->rhs[pred])
+			{
+				dstar->rhs[pred] = (unsigned int)(cost +
+					dstar->g[cell]);
+				++dstar->stats.relaxed;
+				sp_heap_push(dstar->pq, pred,
+					dstar_key(dstar, pred));
+			}
+		}
+	}
+
+	return (dstar->g[start] != DSTAR_INFINITY);
+}
+
+/**
+ * dstar_vertex - Recomputes a cell's rhs from its successors, and queues
+ * the cell if that leaves it inconsistent (D* Lite's UpdateVertex)
+ *
+ * @dstar: Pointer to dstar_t structure
+ * @x: X coordinate (out of range cells are ignored)
+ * @y: Y coordinate
+ */
+void dstar_vertex(dstar_t *dstar, int x, int y)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_terrain_t *terrain = &dstar->terrain;
+	unsigned long rhs = DSTAR_INFINITY, cost, g;
+	size_t cell;
+	int d;
+
+	if (!GRID_IN(terrain, x, y) ||
+		(x == dstar->target.x && y == dstar->target.y))
+		return;
+
+	cell = GRID_CELL(terrain, x, y);
+
+	for (d = 0; d < dstar->connectivity; ++d)
+	{
+		cost = dstar_step(dstar, x, y, d);
+
+		if (!cost)
+			continue;
+
+		g = dstar->g[GRID_CELL(terrain, x + dx[d], y + dy[d])];
+
+		if (g != DSTAR_INFINITY && cost + g < rhs)
+			rhs = cost + g;
+	}
+
+	dstar->rhs[cell] = (unsigned int)rhs;
+
+	if (dstar->g[cell] != dstar->rhs[cell])
+		sp_heap_push(dstar->pq, cell, dstar_key(dstar, cell));
+}
+
+/**
+ * dstar_step - Cost of one move on the planner's terrain
+ *
+ * @dstar: Pointer to dstar_t structure
+ * @x: X coordinate moved from
+ * @y: Y coordinate moved from
+ * @dir: Direction, an index in the grid searches' neighbour tables
+ *
+ * Return: Cost of the move, 0 if either cell is blocked or out of range,
+ *   or if a diagonal move would cut a blocked corner
+ */
+unsigned long dstar_step(dstar_t const *dstar, int x, int y, int dir)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_terrain_t *terrain = &dstar->terrain;
+	int nx = x + dx[dir], ny = y + dy[dir];
+	unsigned long cost = grid_terrain_cost(terrain, nx, ny);
+
+	if (!cost || !grid_terrain_cost(terrain, x, y))
+		return (0);
+
+	if (dir < 4)
+		return (cost * GRID_TERRAIN_STRAIGHT);
+
+	if (!grid_terrain_cost(terrain, nx, y) ||
+		!grid_terrain_cost(terrain, x, ny))
+		return (0);
+
+	return (cost * GRID_TERRAIN_DIAGONAL);
+}
+
+/**
+ * dstar_estimate - Lower bound on the cost between the agent and a cell
+ * Octile distance when 8-connected, Manhattan distance when 4-connected,
+ * scaled by the terrain's lowest cost
+ *
+ * @dstar: Pointer to dstar_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ *
+ * Return: Estimated cost
+ */
+unsigned long dstar_estimate(dstar_t const *dstar, int x, int y)
+{
+	unsigned long dx = (unsigned long)ABS(dstar->start.x - x);
+	unsigned long dy = (unsigned long)ABS(dstar->start.y - y);
+	unsigned long scale = dstar->terrain.min_cost;
+
+	scale = scale ? scale : 1;
+
+	if (dstar->connectivity == 4)
+		return (scale * GRID_TERRAIN_STRAIGHT * (dx + dy));
+
+	return (scale * (GRID_TERRAIN_STRAIGHT * MAX(dx, dy) +
+		(GRID_TERRAIN_DIAGONAL - GRID_TERRAIN_STRAIGHT) * MIN(dx, dy)));
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * dstar_key - Computes the priority of a cell
+ *
+ * @dstar: Pointer to dstar_t structure
+ * @cell: Cell index
+ *
+ * Return: DSTAR_KEY of [min(g, rhs) + h + km; min(g, rhs)], the largest key
+ *   if both are infinite
+ */
+static unsigned long dstar_key(dstar_t const *dstar, size_t cell)
+{
+	unsigned long min = MIN(dstar->g[cell], dstar->rhs[cell]);
+	int x = (int)(cell % (size_t)dstar->terrain.cols);
+	int y = (int)(cell / (size_t)dstar->terrain.cols);
+
+	if (min == DSTAR_INFINITY)
+		return ((unsigned long)-1);
+
+	return (DSTAR_KEY(min + dstar_estimate(dstar, x, y) + dstar->km, min));
+}
@@ -0,0 +1,185 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int flow_relax(flow_field_t *field, size_t cell);
+
+/* API IMPLEMENTATION */
+
+/**
+ * flow_field_create - Computes the flow field of a target
+ * One reverse Dijkstra from the target replaces a search per agent: any
+ * number of agents then follow flow_field_next
+ *
+ * @terrain: Pointer to grid_terrain_t structure (copied, but the arrays it
+ *   points to are not: keep them alive, and report changes to them through
+ *   flow_field_update)
+ * @target: Pointer to point_t for the target coordinates
+ * @connectivity: 4 or 8 (diagonal steps never cut a blocked corner)
+ *
+ * Return: Pointer to flow_field_t structure, NULL on failure
+ */
+flow_field_t *flow_field_create(grid_terrain_t const *terrain,
+	point_t const *target, int connectivity)
+{
+	flow_field_t *field = NULL;
+	size_t cells, i;
+
+	if (!terrain || !target || (connectivity != 4 && connectivity != 8) ||
+		terrain->rows <= 0 || terrain->cols <= 0 ||
+		!GRID_IN(terrain, target->x, target->y))
+		return (NULL);
+
+	cells = (size_t)terrain->rows * (size_t)terrain->cols;
+	field = calloc(1, sizeof(flow_field_t) + cells * (sizeof(size_t) +
+		sizeof(unsigned int) + sizeof(unsigned char)));
+
+	if (!field)
+		return (NULL);
+
+	field->pq = sp_heap_create(SP_HEAP_DEFAULT, cells);
+
+	if (!field->pq)
+	{
+		free(field);
+		return (NULL);
+	}
+
+	field->terrain = *terrain;
+	field->connectivity = connectivity;
+	field->target = *target;
+	field->fifo = (size_t *)(field + 1);
+	field->dist = (unsigned int *)(field->fifo + cells);
+	field->dir = (unsigned char *)(field->dist + cells);
+
+	for (i = 0; i < cells; ++i)
+		field->dist[i] = FLOW_UNREACHABLE, field->dir[i] = FLOW_NONE;
+
+	i = GRID_CELL(terrain, target->x, target->y);
+	field->dist[i] = 0;
+	sp_heap_push(field->pq, i, 0);
+
+	if (!flow_field_run(field))
+	{
+		flow_field_delete(field);
+		return (NULL);
+	}
+
+	return (field);
+}
+
+/**
+ * flow_field_delete - Deallocates a flow field
+ *
+ * @field: Pointer to flow_field_t structure
+ */
+void flow_field_delete(flow_field_t *field)
+{
+	if (!field)
+		return;
+
+	sp_heap_delete(field->pq);
+	free(field);
+}
+
+/**
+ * flow_field_next - Moves an agent one step towards the target, in O(1)
+ *
+ * @field: Pointer to flow_field_t structure
+ * @pos: Agent's coordinates, updated
+ *
+ * Return: 1 if the agent moved, 0 if it is at the target, out of range or
+ *   cannot reach the target
+ */
+int flow_field_next(flow_field_t const *field, point_t *pos)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	unsigned char dir;
+
+	if (!field || !pos || !GRID_IN(&field->terrain, pos->x, pos->y))
+		return (0);
+
+	dir = field->dir[GRID_CELL(&field->terrain, pos->x, pos->y)];
+
+	if (dir == FLOW_NONE)
+		return (0);
+
+	pos->x += dx[dir];
+	pos->y += dy[dir];
+	return (1);
+}
+
+/**
+ * flow_field_run - Settles the cells queued in a flow field's priority
+ * queue, relaxing the moves into each
+ *
+ * @field: Pointer to flow_field_t structure
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int flow_field_run(flow_field_t *field)
+{
+	size_t cell;
+
+	while ((cell = sp_heap_pop(field->pq, NULL)) != SP_HEAP_NONE)
+	{
+		++field->stats.expanded;
+
+		if (!flow_relax(field, cell))
+			return (0);
+	}
+
+	return (1);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * flow_relax - Offers the neighbours of a settled cell the step into it
+ *
+ * @field: Pointer to flow_field_t structure
+ * @cell: Cell index settled
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int flow_relax(flow_field_t *field, size_t cell)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_terrain_t *terrain = &field->terrain;
+	int x = (int)(cell % (size_t)terrain->cols), ux;
+	int y = (int)(cell / (size_t)terrain->cols), uy, d;
+	unsigned long cost = grid_terrain_cost(terrain, x, y), dist;
+	size_t u;
+
+	for (d = 0; cost && d < field->connectivity; ++d)
+	{
+		/* u steps in direction d to reach the cell */
+		ux = x - dx[d];
+		uy = y - dy[d];
+
+		if (!grid_terrain_cost(terrain, ux, uy) || (d >= 4 &&
+			(!grid_terrain_cost(terrain, x, uy) ||
+			!grid_terrain_cost(terrain, ux, y))))
+			continue;
+
+		dist = field->dist[cell] + cost *
+			(d < 4 ? GRID_TERRAIN_STRAIGHT : GRID_TERRAIN_DIAGONAL);
+		u = GRID_CELL(terrain, ux, uy);
+
+		/* Costs past FLOW_UNREACHABLE stay unreachable */
+		if (dist >= field->dist[u])
+			continue;
+
+		field->dist[u] = (unsigned int)dist;
+		field->dir[u] = (unsigned char)d;
+		++field->stats.relaxed;
+
+		if (!sp_heap_push(field->pq, u, dist))
+			return (0);
+	}
+
+	return (1);
+}
@@ -0,0 +1,163 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static size_t flow_invalidate(flow_field_t *field, int x, int y, size_t n);
+static size_t flow_orphan(flow_field_t *field, size_t n);
+static void flow_seed(flow_field_t *field, int x, int y, int radius);
+
+/* API IMPLEMENTATION */
+
+/**
+ * flow_field_update - Repairs a flow field after some cells changed cost or
+ * passability
+ * Only the moves between a changed cell and its eight neighbours can have
+ * changed, so the cells of those 3x3 blocks, and every cell whose steps
+ * led through one of them, lose their distance; the Dijkstra then restarts
+ * from the cells around them that kept theirs
+ *
+ * @field: Pointer to flow_field_t structure
+ * @changed: Coordinates of the cells whose cost changed (out of range ones
+ *   are ignored)
+ * @nb_changed: Number of cells in @changed
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int flow_field_update(flow_field_t *field, point_t const *changed,
+	size_t nb_changed)
+{
+	size_t i, n = 0, cols;
+	int dx, dy;
+
+	if (!field || (nb_changed && !changed))
+		return (0);
+
+	field->stats.expanded = 0;
+	field->stats.relaxed = 0;
+	sp_heap_clear(field->pq);
+
+	for (i = 0; i < nb_changed; ++i)
+	{
+		for (dy = -1; dy <= 1; ++dy)
+			for (dx = -1; dx <= 1; ++dx)
+				n = flow_invalidate(field, changed[i].x + dx,
+					changed[i].y + dy, n);
+	}
+
+	n = flow_orphan(field, n);
+	cols = (size_t)field->terrain.cols;
+
+	for (i = 0; i < n; ++i)
+		flow_seed(field, (int)(field->fifo[i] % cols),
+			(int)(field->fifo[i] / cols), 0);
+
+	for (i = 0; i < nb_changed; ++i)
+		flow_seed(field, changed[i].x, changed[i].y, 1);
+
+	return (flow_field_run(field));
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * flow_invalidate - Forgets the distance of a cell, and queues it for its
+ * children to follow
+ *
+ * @field: Pointer to flow_field_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ * @n: Number of cells invalidated so far
+ *
+ * Return: Number of cells invalidated, the cell included
+ */
+static size_t flow_invalidate(flow_field_t *field, int x, int y, size_t n)
+{
+	size_t cell;
+
+	if (!GRID_IN(&field->terrain, x, y) ||
+		(x == field->target.x && y == field->target.y))
+		return (n);
+
+	cell = GRID_CELL(&field->terrain, x, y);
+
+	/* Cells already without a distance have no children either */
+	if (field->dist[cell] == FLOW_UNREACHABLE)
+		return (n);
+
+	field->dist[cell] = FLOW_UNREACHABLE;
+	field->dir[cell] = FLOW_NONE;
+	field->fifo[n] = cell;
+	return (n + 1);
+}
+
+/**
+ * flow_orphan - Invalidates, breadth first, every cell whose steps led
+ * through an invalidated one
+ *
+ * @field: Pointer to flow_field_t structure
+ * @n: Number of cells invalidated so far, in the field's fifo
+ *
+ * Return: Number of cells invalidated
+ */
+static size_t flow_orphan(flow_field_t *field, size_t n)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_terrain_t *terrain = &field->terrain;
+	size_t head;
+	int x, y, d, cx, cy;
+
+	for (head = 0; head < n; ++head)
+	{
+		x = (int)(field->fifo[head] % (size_t)terrain->cols);
+		y = (int)(field->fifo[head] / (size_t)terrain->cols);
+
+		for (d = 0; d < field->connectivity; ++d)
+		{
+			/* Children step in direction d to reach the cell */
+			cx = x - dx[d];
+			cy = y - dy[d];
+
+			if (GRID_IN(terrain, cx, cy) &&
+				field->dir[GRID_CELL(terrain, cx, cy)] == d)
+				n = flow_invalidate(field, cx, cy, n);
+		}
+	}
+
+	return (n);
+}
+
+/**
+ * flow_seed - Queues the cells around a position that kept a distance, so
+ * that they offer it again
+ *
+ * @field: Pointer to flow_field_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ * @radius: 0 for the cells a move away, 1 for the 3x3 block around the
+ *   position
+ */
+static void flow_seed(flow_field_t *field, int x, int y, int radius)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_terrain_t *terrain = &field->terrain;
+	int d, sx, sy;
+	size_t cell;
+
+	for (d = 0; d < (radius ? 9 : field->connectivity); ++d)
+	{
+		sx = radius ? x + d % 3 - 1 : x + dx[d];
+		sy = radius ? y + d / 3 - 1 : y + dy[d];
+
+		if (!GRID_IN(terrain, sx, sy))
+			continue;
+
+		cell = GRID_CELL(terrain, sx, sy);
+
+		/* Already queued cells refuse the same key again */
+		if (field->dist[cell] != FLOW_UNREACHABLE)
+			sp_heap_push(field->pq, cell, field->dist[cell]);
+	}
+}
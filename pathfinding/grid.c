@@ -0,0 +1,158 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static size_t grid_stride(int cols);
+
+/* API IMPLEMENTATION */
+
+/**
+ * grid_create - Allocates a packed grid with every cell blocked
+ *
+ * @rows: Number of rows
+ * @cols: Number of columns
+ *
+ * Return: Pointer to grid_t structure, NULL on failure
+ */
+grid_t *grid_create(int rows, int cols)
+{
+	grid_t *grid = NULL;
+	void *bits = NULL;
+	size_t stride;
+
+	if (rows <= 0 || cols <= 0)
+		return (NULL);
+
+	stride = grid_stride(cols);
+
+	if ((size_t)rows > ((size_t)-1 / sizeof(unsigned long)) / stride)
+		return (NULL);
+
+	grid = calloc(1, sizeof(grid_t));
+
+	if (!grid || posix_memalign(&bits,
+		GRID_LINE_WORDS * sizeof(unsigned long),
+		(size_t)rows * stride * sizeof(unsigned long)))
+	{
+		free(grid);
+		return (NULL);
+	}
+
+	memset(bits, 0, (size_t)rows * stride * sizeof(unsigned long));
+	grid->rows = rows;
+	grid->cols = cols;
+	grid->stride = stride;
+	grid->bits = bits;
+	return (grid);
+}
+
+/**
+ * grid_from_array - Packs a char ** maze into a grid
+ *
+ * @map: Pointer to 2D maze ('0' for open cells, anything else blocked)
+ * @rows: Number of rows in matrix
+ * @cols: Number of columns in matrix
+ *
+ * Return: Pointer to grid_t structure, NULL on failure
+ */
+grid_t *grid_from_array(char **map, int rows, int cols)
+{
+	grid_t *grid = NULL;
+	unsigned long word, *row = NULL;
+	int x, y;
+
+	if (!map)
+		return (NULL);
+
+	grid = grid_create(rows, cols);
+
+	for (y = 0; grid && y < rows; ++y)
+	{
+		row = GRID_ROW(grid, y);
+
+		/* Whole words are assembled in a register, then stored once */
+		for (x = 0, word = 0; x < cols; ++x)
+		{
+			if (map[y][x] == '0')
+				word |= GRID_BIT(x);
+
+			if (x + 1 == cols || !((x + 1) % GRID_WORD_BITS))
+			{
+				row[(size_t)x / GRID_WORD_BITS] = word;
+				word = 0;
+			}
+		}
+	}
+
+	return (grid);
+}
+
+/**
+ * grid_delete - Deallocates a grid, unmapping it if it was loaded
+ *
+ * @grid: Pointer to grid_t structure
+ */
+void grid_delete(grid_t *grid)
+{
+	if (!grid)
+		return;
+
+	if (grid->mapping)
+		munmap(grid->mapping, grid->mapping_size);
+	else
+		free(grid->bits);
+
+	free(grid);
+}
+
+/**
+ * grid_set - Opens or blocks a cell
+ *
+ * @grid: Pointer to grid_t structure (not a loaded, read-only one)
+ * @x: X coordinate
+ * @y: Y coordinate
+ * @open: Nonzero to open the cell, 0 to block it
+ *
+ * Return: 1 on success, 0 if the cell is out of range or the grid is
+ *   read-only
+ */
+int grid_set(grid_t *grid, int x, int y, int open)
+{
+	if (!grid || grid->mapping || !GRID_IN(grid, x, y))
+		return (0);
+
+	if (open)
+		GRID_WORD(grid, x, y) |= GRID_BIT(x);
+	else
+		GRID_WORD(grid, x, y) &= ~GRID_BIT(x);
+
+	return (1);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * grid_stride - Words per row for a number of columns
+ * Up to a cache line, the next power of two; past it, whole cache lines
+ *
+ * @cols: Number of columns
+ *
+ * Return: Words per row
+ */
+static size_t grid_stride(int cols)
+{
+	size_t words = ((size_t)cols + GRID_WORD_BITS - 1) / GRID_WORD_BITS;
+	size_t stride = 1;
+
+	if (words > GRID_LINE_WORDS)
+		return ((words + GRID_LINE_WORDS - 1) / GRID_LINE_WORDS *
+			GRID_LINE_WORDS);
+
+	while (stride < words)
+		stride <<= 1;
+
+	return (stride);
+}
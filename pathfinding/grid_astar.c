@@ -0,0 +1,238 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+#define ABS(a) ((a) < 0 ? -(a) : (a))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/* STATIC FUNCTIONS */
+
+static int astar_expand(grid_search_ctx_t *ctx, size_t cell);
+static unsigned long astar_estimate(grid_search_ctx_t *ctx, int x, int y);
+
+/* API IMPLEMENTATION */
+
+/**
+ * grid_astar - Finds a cheapest path across terrain with A*
+ *
+ * @terrain: Pointer to grid_terrain_t structure
+ * @start: Pointer to point_t for the start coordinates
+ * @target: Pointer to point_t for the target coordinates
+ * @connectivity: 4 or 8 (diagonal steps never cut a blocked corner)
+ * @heuristic: Estimate guiding the search (see grid_heuristic_t)
+ * @stats: Receives the work done (may be NULL)
+ *
+ * Return: Pointer to queue_t of point_t from @start to @target, NULL on
+ *   failure or if there is no path
+ */
+queue_t *grid_astar(grid_terrain_t const *terrain, point_t const *start,
+	point_t const *target, int connectivity, grid_heuristic_t heuristic,
+	sp_stats_t *stats)
+{
+	grid_workspace_t *ws = NULL;
+	queue_t *path = NULL;
+
+	if (!terrain || terrain->rows <= 0 || terrain->cols <= 0)
+		return (NULL);
+
+	ws = grid_workspace_create((size_t)terrain->rows *
+		(size_t)terrain->cols);
+
+	if (!ws)
+		return (NULL);
+
+	path = grid_astar_workspace(ws, terrain, start, target, connectivity,
+		heuristic, stats);
+	grid_workspace_delete(ws);
+	return (path);
+}
+
+/**
+ * grid_astar_workspace - grid_astar reusing a caller's workspace
+ * The open list is the workspace's bucket queue: with consistent
+ * heuristics keys only grow, by at most GRID_TERRAIN_MAX_STEP, so pushes
+ * and pops take O(1)
+ *
+ * @ws: Workspace with room for every cell of @terrain (not shared between
+ *   threads)
+ * @terrain: Pointer to grid_terrain_t structure
+ * @start: Pointer to point_t for the start coordinates
+ * @target: Pointer to point_t for the target coordinates
+ * @connectivity: 4 or 8 (diagonal steps never cut a blocked corner)
+ * @heuristic: Estimate guiding the search (see grid_heuristic_t)
+ * @stats: Receives the work done (may be NULL)
+ *
+ * Return: Pointer to queue_t of point_t from @start to @target, NULL on
+ *   failure or if there is no path
+ */
+queue_t *grid_astar_workspace(grid_workspace_t *ws,
+	grid_terrain_t const *terrain, point_t const *start,
+	point_t const *target, int connectivity, grid_heuristic_t heuristic,
+	sp_stats_t *stats)
+{
+	grid_search_ctx_t ctx;
+	size_t cell, goal;
+	int found = 0;
+
+	if (!ws || !terrain || !start || !target ||
+		(connectivity != 4 && connectivity != 8) ||
+		(heuristic == GRID_HEURISTIC_MANHATTAN && connectivity == 8) ||
+		terrain->rows <= 0 || terrain->cols <= 0 ||
+		ws->capacity / (size_t)terrain->cols < (size_t)terrain->rows ||
+		!grid_terrain_cost(terrain, start->x, start->y) ||
+		!grid_terrain_cost(terrain, target->x, target->y))
+		return (NULL);
+
+	if (!ws->buckets)
+		ws->buckets = sp_bucket_create(ws->capacity,
+			GRID_TERRAIN_MAX_STEP);
+
+	if (!ws->buckets)
+		return (NULL);
+
+	grid_workspace_reset(ws);
+	ctx.grid = terrain->grid;
+	ctx.ws = ws;
+	ctx.connectivity = connectivity;
+	ctx.start = *start;
+	ctx.target = *target;
+	ctx.stats.expanded = 0;
+	ctx.stats.relaxed = 0;
+	ctx.terrain = terrain;
+	ctx.heuristic = heuristic;
+	cell = GRID_CELL(terrain, start->x, start->y);
+	goal = GRID_CELL(terrain, target->x, target->y);
+	grid_workspace_entry(ws, cell)->g = 0;
+	sp_heap_push(ws->buckets, cell,
+		astar_estimate(&ctx, start->x, start->y));
+
+	while (!found &&
+		(cell = sp_heap_pop(ws->buckets, NULL)) != SP_HEAP_NONE)
+	{
+		++ctx.stats.expanded;
+		found = cell == goal ? 1 : -!astar_expand(&ctx, cell);
+	}
+
+	if (stats)
+		*stats = ctx.stats;
+
+	if (found != 1)
+		return (NULL);
+
+	return (grid_path_queue(ws, terrain->cols, goal));
+}
+
+/**
+ * grid_terrain_cost - Reads the cost of entering a cell
+ *
+ * @terrain: Pointer to grid_terrain_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ *
+ * Return: Cost of the cell, 0 if it is blocked or out of range
+ */
+unsigned long grid_terrain_cost(grid_terrain_t const *terrain, int x, int y)
+{
+	unsigned char c;
+
+	if (!GRID_IN(terrain, x, y) ||
+		(terrain->grid && !GRID_OPEN(terrain->grid, x, y)))
+		return (0);
+
+	if (terrain->costs)
+		return (terrain->costs[GRID_CELL(terrain, x, y)]);
+
+	if (!terrain->map)
+		return (1);
+
+	c = (unsigned char)terrain->map[y][x];
+
+	if (terrain->table)
+		return (terrain->table[c]);
+
+	if (c == '0')
+		return (1);
+
+	return (c >= '2' && c <= '9' ? (unsigned long)(c - '0') : 0);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * astar_expand - Relaxes the moves out of a cell
+ *
+ * @ctx: Pointer to grid_search_ctx_t structure
+ * @cell: Cell index being expanded
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int astar_expand(grid_search_ctx_t *ctx, size_t cell)
+{
+	const grid_terrain_t *terrain = ctx->terrain;
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	int x = (int)(cell % (size_t)terrain->cols), nx;
+	int y = (int)(cell / (size_t)terrain->cols), ny, d;
+	grid_entry_t *entry = NULL;
+	unsigned long cost, g;
+	size_t next;
+
+	for (d = 0; d < ctx->connectivity; ++d)
+	{
+		nx = x + dx[d];
+		ny = y + dy[d];
+		cost = grid_terrain_cost(terrain, nx, ny);
+
+		/* A diagonal step needs both cells it passes between */
+		if (!cost || (d >= 4 && (!grid_terrain_cost(terrain, nx, y) ||
+			!grid_terrain_cost(terrain, x, ny))))
+			continue;
+
+		g = ctx->ws->entries[cell].g + cost *
+			(d < 4 ? GRID_TERRAIN_STRAIGHT : GRID_TERRAIN_DIAGONAL);
+		next = GRID_CELL(terrain, nx, ny);
+		entry = grid_workspace_entry(ctx->ws, next);
+
+		if (g >= entry->g)
+			continue;
+
+		entry->g = g;
+		entry->parent = cell;
+		++ctx->stats.relaxed;
+
+		if (!sp_heap_push(ctx->ws->buckets, next,
+			g + astar_estimate(ctx, nx, ny)))
+			return (0);
+	}
+
+	return (1);
+}
+
+/**
+ * astar_estimate - Lower bound on the cost from a cell to the target
+ *
+ * @ctx: Pointer to grid_search_ctx_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ *
+ * Return: Estimated cost
+ */
+static unsigned long astar_estimate(grid_search_ctx_t *ctx, int x, int y)
+{
+	unsigned long dx = (unsigned long)ABS(ctx->target.x - x);
+	unsigned long dy = (unsigned long)ABS(ctx->target.y - y);
+	unsigned long scale = ctx->terrain->min_cost;
+
+	scale = scale ? scale : 1;
+
+	if (ctx->heuristic == GRID_HEURISTIC_MANHATTAN)
+		return (scale * GRID_TERRAIN_STRAIGHT * (dx + dy));
+
+	/* min(dx, dy) diagonal steps, then straight ones */
+	if (ctx->heuristic == GRID_HEURISTIC_OCTILE)
+		return (scale * (GRID_TERRAIN_STRAIGHT * MAX(dx, dy) +
+			(GRID_TERRAIN_DIAGONAL - GRID_TERRAIN_STRAIGHT) *
+			MIN(dx, dy)));
+
+	return (0);
+}
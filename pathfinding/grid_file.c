@@ -0,0 +1,128 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int grid_file_check(grid_file_header_t const *header, size_t size);
+
+/* API IMPLEMENTATION */
+
+/**
+ * grid_load - Maps a grid file written by grid_save
+ * Nothing is copied: pages are read in as searches touch them, and
+ * processes loading the same file share them
+ *
+ * @path: Path of the grid file
+ *
+ * Return: Pointer to a read-only grid_t structure, NULL on failure
+ */
+grid_t *grid_load(char const *path)
+{
+	grid_t *grid = NULL;
+	struct stat st;
+	void *mapping = MAP_FAILED;
+	int fd;
+
+	if (!path)
+		return (NULL);
+
+	fd = open(path, O_RDONLY);
+
+	if (fd == -1)
+		return (NULL);
+
+	if (!fstat(fd, &st) && st.st_size >= GRID_FILE_HEADER)
+		mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED,
+			fd, 0);
+
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return (NULL);
+
+	grid = calloc(1, sizeof(grid_t));
+
+	if (!grid || !grid_file_check(mapping, (size_t)st.st_size))
+	{
+		munmap(mapping, (size_t)st.st_size);
+		free(grid);
+		return (NULL);
+	}
+
+	grid->rows = (int)((grid_file_header_t *)mapping)->rows;
+	grid->cols = (int)((grid_file_header_t *)mapping)->cols;
+	grid->stride = ((grid_file_header_t *)mapping)->stride;
+	grid->bits = (unsigned long *)((char *)mapping + GRID_FILE_HEADER);
+	grid->mapping = mapping;
+	grid->mapping_size = (size_t)st.st_size;
+	return (grid);
+}
+
+/**
+ * grid_save - Writes a grid to a file grid_load can map
+ *
+ * @grid: Pointer to grid_t structure
+ * @path: Path of the file to create or truncate
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int grid_save(grid_t const *grid, char const *path)
+{
+	char header[GRID_FILE_HEADER];
+	grid_file_header_t fields;
+	size_t words;
+	FILE *file = NULL;
+	int ok;
+
+	if (!grid || !path)
+		return (0);
+
+	memset(header, 0, sizeof(header));
+	memset(&fields, 0, sizeof(fields));
+	memcpy(fields.magic, GRID_FILE_MAGIC, sizeof(GRID_FILE_MAGIC));
+	fields.word_bits = GRID_WORD_BITS;
+	fields.rows = (unsigned long)grid->rows;
+	fields.cols = (unsigned long)grid->cols;
+	fields.stride = grid->stride;
+	memcpy(header, &fields, sizeof(fields));
+	words = (size_t)grid->rows * grid->stride;
+	file = fopen(path, "wb");
+
+	if (!file)
+		return (0);
+
+	ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+		fwrite(grid->bits, sizeof(unsigned long), words, file) == words;
+	return (fclose(file) == 0 && ok);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * grid_file_check - Validates the header of a mapped grid file
+ *
+ * @header: Start of the mapping
+ * @size: Size of the mapping
+ *
+ * Return: 1 if the file holds a grid this host can use, 0 otherwise
+ */
+static int grid_file_check(grid_file_header_t const *header, size_t size)
+{
+	size_t words;
+
+	if (memcmp(header->magic, GRID_FILE_MAGIC, sizeof(GRID_FILE_MAGIC)) ||
+		header->word_bits != GRID_WORD_BITS ||
+		!header->rows || !header->cols ||
+		header->rows > 0x7fffffffUL || header->cols > 0x7fffffffUL ||
+		header->stride * GRID_WORD_BITS < header->cols)
+		return (0);
+
+	words = (size - GRID_FILE_HEADER) / sizeof(unsigned long);
+	return (header->rows <= words / header->stride);
+}
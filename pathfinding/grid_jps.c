@@ -0,0 +1,233 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+#define SIGN(a) (((a) > 0) - ((a) < 0))
+#define ABS(a) ((a) < 0 ? -(a) : (a))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+#define PASSABLE(ctx, x, y) GRID_PASSABLE((ctx)->grid, x, y)
+#define DIRECTION(dirs, i, dx, dy) ((dirs)[i][0] = (dx), (dirs)[i][1] = (dy))
+/* Octile distance, or Manhattan distance when moving 4-connected */
+#define HEURISTIC(ctx, dx, dy) ((ctx)->connectivity == 8 ? \
+	GRID_COST_STRAIGHT * (unsigned long)MAX(ABS(dx), ABS(dy)) + \
+	(GRID_COST_DIAGONAL - GRID_COST_STRAIGHT) * \
+	(unsigned long)MIN(ABS(dx), ABS(dy)) : \
+	GRID_COST_STRAIGHT * (unsigned long)(ABS(dx) + ABS(dy)))
+
+/* STATIC FUNCTIONS */
+
+static int jps_expand(grid_search_ctx_t *ctx, size_t cell);
+static int jps_jump(grid_search_ctx_t *ctx, int x, int y, int dx, int dy,
+	point_t *jump);
+static int jps_is_jump(grid_search_ctx_t *ctx, int x, int y, int dx, int dy);
+static int jps_relax(grid_search_ctx_t *ctx, size_t cell, point_t const *to);
+
+/* API IMPLEMENTATION */
+
+/**
+ * grid_jps - Jump Point Search from the start to the target
+ * A* whose successors are the jump points found by scanning straight and
+ * diagonal lines: cells in between are never queued, since some other
+ * shortest path reaches whatever they would lead to
+ *
+ * @ctx: Pointer to grid_search_ctx_t structure, the start's g set to 0
+ *
+ * Return: 1 if the target was reached, 0 if not, -1 on failure
+ */
+int grid_jps(grid_search_ctx_t *ctx)
+{
+	const grid_t *grid = ctx->grid;
+	size_t cell, target = GRID_CELL(grid, ctx->target.x, ctx->target.y);
+
+	if (!ctx->ws->pq)
+		ctx->ws->pq = sp_heap_create(SP_HEAP_DEFAULT,
+			ctx->ws->capacity);
+
+	if (!ctx->ws->pq || !sp_heap_push(ctx->ws->pq,
+		GRID_CELL(grid, ctx->start.x, ctx->start.y),
+		HEURISTIC(ctx, ctx->target.x - ctx->start.x,
+			ctx->target.y - ctx->start.y)))
+		return (-1);
+
+	while ((cell = sp_heap_pop(ctx->ws->pq, NULL)) != SP_HEAP_NONE)
+	{
+		++ctx->stats.expanded;
+
+		if (cell == target)
+			return (1);
+
+		if (!jps_expand(ctx, cell))
+			return (-1);
+	}
+
+	return (0);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * jps_expand - Jumps from a cell in each direction its arrival leaves
+ * open, and relaxes the jump points found
+ * Straight arrivals may turn sideways (diagonally too when 8-connected),
+ * diagonal ones keep going or split into their two straight components;
+ * the start tries every direction
+ *
+ * @ctx: Pointer to grid_search_ctx_t structure
+ * @cell: Cell index being expanded
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int jps_expand(grid_search_ctx_t *ctx, size_t cell)
+{
+	static const int all_x[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int all_y[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	size_t cols = (size_t)ctx->grid->cols;
+	size_t parent = ctx->ws->entries[cell].parent;
+	int x = (int)(cell % cols), y = (int)(cell / cols);
+	int dirs[8][2], n = 0, i, dx, dy, sx, sy;
+	point_t jump;
+
+	dx = parent == SP_HEAP_NONE ? 0 : SIGN(x - (int)(parent % cols));
+	dy = parent == SP_HEAP_NONE ? 0 : SIGN(y - (int)(parent / cols));
+
+	if (!dx && !dy)
+		for (; n < ctx->connectivity; ++n)
+			DIRECTION(dirs, n, all_x[n], all_y[n]);
+	else if (dx && dy)
+	{
+		DIRECTION(dirs, 0, dx, 0);
+		DIRECTION(dirs, 1, 0, dy);
+		DIRECTION(dirs, 2, dx, dy);
+		n = 3;
+	}
+	else
+	{
+		/* Straight on, sideways, and forward-sideways if 8-connected */
+		DIRECTION(dirs, n, dx, dy), ++n;
+		for (i = -1; i <= 1; i += 2)
+		{
+			sx = dy ? i : 0;
+			sy = dx ? i : 0;
+			DIRECTION(dirs, n, sx, sy), ++n;
+			if (ctx->connectivity == 8)
+				DIRECTION(dirs, n, dx + sx, dy + sy), ++n;
+		}
+	}
+
+	for (i = 0; i < n; ++i)
+	{
+		if (jps_jump(ctx, x, y, dirs[i][0], dirs[i][1], &jump) &&
+			!jps_relax(ctx, cell, &jump))
+			return (0);
+	}
+
+	return (1);
+}
+
+/**
+ * jps_jump - Scans from a cell in one direction for the next jump point
+ *
+ * @ctx: Pointer to grid_search_ctx_t structure
+ * @x: X coordinate scanned from
+ * @y: Y coordinate scanned from
+ * @dx: Horizontal step (-1, 0 or 1)
+ * @dy: Vertical step (-1, 0 or 1)
+ * @jump: Receives the jump point
+ *
+ * Return: 1 if a jump point was found, 0 if the scan ran into a wall
+ */
+static int jps_jump(grid_search_ctx_t *ctx, int x, int y, int dx, int dy,
+	point_t *jump)
+{
+	while (1)
+	{
+		/* No cutting corners */
+		if (dx && dy && (!PASSABLE(ctx, x + dx, y) ||
+			!PASSABLE(ctx, x, y + dy)))
+			return (0);
+
+		x += dx;
+		y += dy;
+
+		if (!PASSABLE(ctx, x, y))
+			return (0);
+
+		if ((x == ctx->target.x && y == ctx->target.y) ||
+			jps_is_jump(ctx, x, y, dx, dy))
+		{
+			jump->x = x;
+			jump->y = y;
+			return (1);
+		}
+	}
+}
+
+/**
+ * jps_is_jump - Tells whether a scan must stop at a cell
+ * A straight scan stops next to a wall corner, where a turn around it
+ * becomes a shortest path (a forced neighbour); a diagonal scan, and a
+ * vertical one when 4-connected, stops where a straight scan branching off
+ * would stop
+ *
+ * @ctx: Pointer to grid_search_ctx_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ * @dx: Horizontal step of the scan
+ * @dy: Vertical step of the scan
+ *
+ * Return: 1 if the cell is a jump point, 0 otherwise
+ */
+static int jps_is_jump(grid_search_ctx_t *ctx, int x, int y, int dx, int dy)
+{
+	point_t jump;
+
+	if (dx && dy)
+		return (jps_jump(ctx, x, y, dx, 0, &jump) ||
+			jps_jump(ctx, x, y, 0, dy, &jump));
+
+	if (dx)
+		return ((PASSABLE(ctx, x, y - 1) &&
+			!PASSABLE(ctx, x - dx, y - 1)) ||
+			(PASSABLE(ctx, x, y + 1) &&
+			!PASSABLE(ctx, x - dx, y + 1)));
+
+	return ((PASSABLE(ctx, x - 1, y) && !PASSABLE(ctx, x - 1, y - dy)) ||
+		(PASSABLE(ctx, x + 1, y) && !PASSABLE(ctx, x + 1, y - dy)) ||
+		(ctx->connectivity == 4 && (jps_jump(ctx, x, y, 1, 0, &jump) ||
+		jps_jump(ctx, x, y, -1, 0, &jump))));
+}
+
+/**
+ * jps_relax - Offers a jump point a path through the cell it was found
+ * from
+ *
+ * @ctx: Pointer to grid_search_ctx_t structure
+ * @cell: Cell index expanded
+ * @to: Jump point, a straight or diagonal line away from @cell
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int jps_relax(grid_search_ctx_t *ctx, size_t cell, point_t const *to)
+{
+	const grid_t *grid = ctx->grid;
+	int x = (int)(cell % (size_t)grid->cols);
+	int y = (int)(cell / (size_t)grid->cols);
+	size_t next = GRID_CELL(grid, to->x, to->y);
+	grid_entry_t *entry = grid_workspace_entry(ctx->ws, next);
+	unsigned long g = ctx->ws->entries[cell].g, step = GRID_COST_STRAIGHT;
+
+	if (to->x != x && to->y != y)
+		step = GRID_COST_DIAGONAL;
+
+	g += (unsigned long)MAX(ABS(to->x - x), ABS(to->y - y)) * step;
+
+	if (g >= entry->g)
+		return (1);
+
+	entry->g = g;
+	entry->parent = cell;
+	++ctx->stats.relaxed;
+	return (sp_heap_push(ctx->ws->pq, next, g +
+		HEURISTIC(ctx, ctx->target.x - to->x, ctx->target.y - to->y)));
+}
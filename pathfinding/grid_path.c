@@ -0,0 +1,87 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+#define SIGN(a) (((a) > 0) - ((a) < 0))
+
+/* STATIC FUNCTIONS */
+
+static int grid_path_push(queue_t *path, int x, int y);
+
+/* API IMPLEMENTATION */
+
+/**
+ * grid_path_queue - Builds the path to a cell from the parents left by a
+ * grid search, filling in the straight or diagonal lines between them
+ *
+ * @ws: Workspace of the search
+ * @cols: Number of columns of the grid searched
+ * @target: Cell index reached
+ *
+ * Return: Pointer to queue_t of point_t from the start to @target, NULL on
+ *   failure
+ */
+queue_t *grid_path_queue(grid_workspace_t *ws, int cols, size_t target)
+{
+	queue_t *path = queue_create();
+	size_t cell = target, parent, end;
+	point_t *point = NULL;
+	int x, y, px, py, ok = path != NULL;
+
+	while (ok && cell != SP_HEAP_NONE)
+	{
+		parent = ws->entries[cell].parent;
+		end = parent == SP_HEAP_NONE ? cell : parent;
+		x = (int)(cell % (size_t)cols);
+		y = (int)(cell / (size_t)cols);
+		px = (int)(end % (size_t)cols);
+		py = (int)(end / (size_t)cols);
+
+		do {
+			ok = grid_path_push(path, x, y);
+			x -= SIGN(x - px);
+			y -= SIGN(y - py);
+		} while (ok && (x != px || y != py));
+
+		cell = parent;
+	}
+
+	if (!ok && path)
+	{
+		while ((point = dequeue(path)))
+			free(point);
+		queue_delete(path);
+		path = NULL;
+	}
+
+	return (path);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * grid_path_push - Puts a point in front of a path
+ *
+ * @path: Pointer to queue_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int grid_path_push(queue_t *path, int x, int y)
+{
+	point_t *point = calloc(1, sizeof(point_t));
+
+	if (!point)
+		return (0);
+
+	point->x = x;
+	point->y = y;
+
+	if (!queue_push_front(path, point))
+	{
+		free(point);
+		return (0);
+	}
+
+	return (1);
+}
@@ -0,0 +1,152 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int grid_bfs(grid_search_ctx_t *ctx);
+
+/* API IMPLEMENTATION */
+
+/**
+ * grid_shortest_path - Finds a shortest path across a packed grid
+ *
+ * @grid: Pointer to grid_t structure
+ * @start: Pointer to point_t for the start coordinates
+ * @target: Pointer to point_t for the target coordinates
+ * @mode: Search to run (see grid_search_t)
+ * @connectivity: 4 or 8
+ * @stats: Receives the work done (may be NULL)
+ *
+ * Return: Pointer to queue_t of point_t from @start to @target, NULL on
+ *   failure or if there is no path
+ */
+queue_t *grid_shortest_path(grid_t const *grid, point_t const *start,
+	point_t const *target, grid_search_t mode, int connectivity,
+	sp_stats_t *stats)
+{
+	grid_workspace_t *ws = NULL;
+	queue_t *path = NULL;
+
+	if (!grid)
+		return (NULL);
+
+	ws = grid_workspace_create((size_t)grid->rows * (size_t)grid->cols);
+
+	if (!ws)
+		return (NULL);
+
+	path = grid_shortest_path_workspace(ws, grid, start, target, mode,
+		connectivity, stats);
+	grid_workspace_delete(ws);
+	return (path);
+}
+
+/**
+ * grid_shortest_path_workspace - grid_shortest_path reusing a caller's
+ * workspace
+ *
+ * @ws: Workspace with room for every cell of @grid (not shared between
+ *   threads)
+ * @grid: Pointer to grid_t structure
+ * @start: Pointer to point_t for the start coordinates
+ * @target: Pointer to point_t for the target coordinates
+ * @mode: Search to run (see grid_search_t)
+ * @connectivity: 4 or 8
+ * @stats: Receives the work done (may be NULL)
+ *
+ * Return: Pointer to queue_t of point_t from @start to @target, NULL on
+ *   failure or if there is no path
+ */
+queue_t *grid_shortest_path_workspace(grid_workspace_t *ws,
+	grid_t const *grid, point_t const *start, point_t const *target,
+	grid_search_t mode, int connectivity, sp_stats_t *stats)
+{
+	grid_search_ctx_t ctx;
+	int found;
+
+	if (!ws || !grid || !start || !target ||
+		(connectivity != 4 && connectivity != 8) ||
+		ws->capacity / (size_t)grid->cols < (size_t)grid->rows ||
+		!GRID_PASSABLE(grid, start->x, start->y) ||
+		!GRID_PASSABLE(grid, target->x, target->y))
+		return (NULL);
+
+	grid_workspace_reset(ws);
+	ctx.grid = grid;
+	ctx.ws = ws;
+	ctx.connectivity = connectivity;
+	ctx.start = *start;
+	ctx.target = *target;
+	ctx.stats.expanded = 0;
+	ctx.stats.relaxed = 0;
+	ctx.terrain = NULL;
+	ctx.heuristic = GRID_HEURISTIC_NONE;
+	grid_workspace_entry(ws, GRID_CELL(grid, start->x, start->y))->g = 0;
+	found = mode == GRID_SEARCH_JPS ? grid_jps(&ctx) : grid_bfs(&ctx);
+
+	if (stats)
+		*stats = ctx.stats;
+
+	if (found != 1)
+		return (NULL);
+
+	return (grid_path_queue(ws, grid->cols,
+		GRID_CELL(grid, target->x, target->y)));
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * grid_bfs - Breadth-first search from the start to the target
+ * Neighbours are queued right, down, left, up, then diagonally
+ *
+ * @ctx: Pointer to grid_search_ctx_t structure
+ *
+ * Return: 1 if the target was reached, 0 if not
+ */
+static int grid_bfs(grid_search_ctx_t *ctx)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_t *grid = ctx->grid;
+	grid_entry_t *entry = NULL;
+	size_t head = 0, tail = 0, cell, next, target;
+	int x, y, d;
+
+	target = GRID_CELL(grid, ctx->target.x, ctx->target.y);
+	ctx->ws->fifo[tail++] = GRID_CELL(grid, ctx->start.x, ctx->start.y);
+
+	while (head < tail)
+	{
+		cell = ctx->ws->fifo[head++];
+		++ctx->stats.expanded;
+
+		if (cell == target)
+			return (1);
+
+		for (d = 0; d < ctx->connectivity; ++d)
+		{
+			x = (int)(cell % (size_t)grid->cols) + dx[d];
+			y = (int)(cell / (size_t)grid->cols) + dy[d];
+
+			/* A diagonal step needs both cells it passes between */
+			if (!GRID_PASSABLE(grid, x, y) || (d >= 4 &&
+				(!GRID_OPEN(grid, x - dx[d], y) ||
+				!GRID_OPEN(grid, x, y - dy[d]))))
+				continue;
+
+			next = GRID_CELL(grid, x, y);
+			entry = grid_workspace_entry(ctx->ws, next);
+
+			if (entry->g != SP_UNREACHABLE)
+				continue;
+
+			entry->g = ctx->ws->entries[cell].g + 1;
+			entry->parent = cell;
+			ctx->ws->fifo[tail++] = next;
+			++ctx->stats.relaxed;
+		}
+	}
+
+	return (0);
+}
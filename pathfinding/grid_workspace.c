@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * grid_workspace_create - Allocates a grid search workspace
+ *
+ * @capacity: Number of cells of the largest grid the workspace will serve
+ *
+ * Return: Pointer to grid_workspace_t structure, NULL on failure
+ */
+grid_workspace_t *grid_workspace_create(size_t capacity)
+{
+	grid_workspace_t *ws = NULL;
+
+	if (!capacity || capacity > ((size_t)-1 - sizeof(grid_workspace_t)) /
+		(sizeof(grid_entry_t) + sizeof(size_t)))
+		return (NULL);
+
+	/* calloc leaves every entry at epoch 0, which no query uses */
+	ws = calloc(1, sizeof(grid_workspace_t) +
+		capacity * (sizeof(grid_entry_t) + sizeof(size_t)));
+
+	if (!ws)
+		return (NULL);
+
+	ws->capacity = capacity;
+	ws->entries = (grid_entry_t *)(ws + 1);
+	ws->fifo = (size_t *)(ws->entries + capacity);
+	return (ws);
+}
+
+/**
+ * grid_workspace_delete - Deallocates a grid search workspace
+ *
+ * @ws: Pointer to grid_workspace_t structure
+ */
+void grid_workspace_delete(grid_workspace_t *ws)
+{
+	if (!ws)
+		return;
+
+	sp_heap_delete(ws->pq);
+	sp_heap_delete(ws->buckets);
+	free(ws);
+}
+
+/**
+ * grid_workspace_reset - Forgets the previous search's state
+ * O(1) apart from emptying what the previous search left queued (see
+ * sp_heap_clear); entries are only rewritten when the epoch counter wraps
+ * around
+ *
+ * @ws: Pointer to grid_workspace_t structure
+ */
+void grid_workspace_reset(grid_workspace_t *ws)
+{
+	size_t i;
+
+	if (ws->pq)
+		sp_heap_clear(ws->pq);
+
+	if (ws->buckets)
+		sp_heap_clear(ws->buckets);
+
+	if (++ws->epoch)
+		return;
+
+	for (i = 0; i < ws->capacity; ++i)
+		ws->entries[i].epoch = 0;
+
+	ws->epoch = 1;
+}
+
+/**
+ * grid_workspace_entry - Looks up a cell's entry, resetting it on first
+ * use in the current search
+ *
+ * @ws: Pointer to grid_workspace_t structure
+ * @cell: Cell index
+ *
+ * Return: Pointer to the cell's entry
+ */
+grid_entry_t *grid_workspace_entry(grid_workspace_t *ws, size_t cell)
+{
+	grid_entry_t *entry = &ws->entries[cell];
+
+	if (entry->epoch != ws->epoch)
+	{
+		entry->epoch = ws->epoch;
+		entry->parent = SP_HEAP_NONE;
+		entry->g = SP_UNREACHABLE;
+	}
+
+	return (entry);
+}
@@ -0,0 +1,143 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* API IMPLEMENTATION */
+
+/**
+ * hpa_create - Splits a terrain into clusters and builds its abstract
+ * graph
+ *
+ * @terrain: Pointer to grid_terrain_t structure (copied, but the arrays it
+ *   points to are not: keep them alive, and report changes to them through
+ *   hpa_update)
+ * @size: Cluster side, in cells (10 to 30 suits most maps)
+ * @connectivity: 4 or 8 (diagonal steps never cut a blocked corner)
+ *
+ * Return: Pointer to hpa_t structure, NULL on failure
+ */
+hpa_t *hpa_create(grid_terrain_t const *terrain, int size, int connectivity)
+{
+	hpa_t *hpa = NULL;
+	hpa_cluster_t *cluster = NULL;
+	size_t nb, i;
+
+	if (!terrain || size <= 0 || (connectivity != 4 && connectivity != 8) ||
+		terrain->rows <= 0 || terrain->cols <= 0)
+		return (NULL);
+
+	nb = (size_t)((terrain->cols + size - 1) / size) *
+		(size_t)((terrain->rows + size - 1) / size);
+	hpa = calloc(1, sizeof(hpa_t) + nb * (sizeof(hpa_cluster_t) +
+		8 * (size_t)size * sizeof(vertex_t *)));
+
+	if (!hpa)
+		return (NULL);
+
+	hpa->terrain = *terrain;
+	hpa->connectivity = connectivity;
+	hpa->size = size;
+	hpa->cols = (terrain->cols + size - 1) / size;
+	hpa->rows = (terrain->rows + size - 1) / size;
+	hpa->clusters = (hpa_cluster_t *)(hpa + 1);
+
+	for (i = 0; i < nb; ++i)
+	{
+		cluster = &hpa->clusters[i];
+		cluster->x = (int)(i % (size_t)hpa->cols) * size;
+		cluster->y = (int)(i / (size_t)hpa->cols) * size;
+		cluster->width = MIN(size, terrain->cols - cluster->x);
+		cluster->height = MIN(size, terrain->rows - cluster->y);
+		cluster->dirty = HPA_DIRTY_CLUSTER | HPA_DIRTY_RIGHT |
+			HPA_DIRTY_DOWN;
+		cluster->perimeter = (vertex_t **)(hpa->clusters + nb) +
+			i * 8 * (size_t)size;
+		cluster->nodes = cluster->perimeter + 4 * size;
+	}
+
+	hpa->graph = graph_create();
+	hpa->local = grid_workspace_create((size_t)terrain->rows *
+		(size_t)terrain->cols);
+
+	if (hpa->graph)
+	{
+		hpa->start = graph_add_vertex(hpa->graph, "start", 0, 0);
+		hpa->target = graph_add_vertex(hpa->graph, "target", 0, 0);
+	}
+
+	if (!hpa->local || !hpa->start || !hpa->target || !hpa_rebuild(hpa))
+	{
+		hpa_delete(hpa);
+		return (NULL);
+	}
+
+	return (hpa);
+}
+
+/**
+ * hpa_delete - Deallocates a HPA* abstraction and its graph
+ *
+ * @hpa: Pointer to hpa_t structure
+ */
+void hpa_delete(hpa_t *hpa)
+{
+	if (!hpa)
+		return;
+
+	if (hpa->graph)
+		graph_delete(hpa->graph);
+
+	grid_workspace_delete(hpa->local);
+	sp_workspace_delete(hpa->ws);
+	sp_path_release(&hpa->path);
+	free(hpa);
+}
+
+/**
+ * hpa_update - Rebuilds the clusters touched by some cell changes
+ * A change inside a cluster only redoes the searches between its
+ * transitions; one on its edge also rescans the border, and with it the
+ * cluster on the other side
+ *
+ * @hpa: Pointer to hpa_t structure
+ * @changed: Coordinates of the cells whose cost changed (out of range ones
+ *   are ignored)
+ * @nb_changed: Number of cells in @changed
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int hpa_update(hpa_t *hpa, point_t const *changed, size_t nb_changed)
+{
+	hpa_cluster_t *cluster = NULL;
+	size_t i, k;
+	int x, y;
+
+	if (!hpa || (nb_changed && !changed))
+		return (0);
+
+	for (i = 0; i < nb_changed; ++i)
+	{
+		x = changed[i].x;
+		y = changed[i].y;
+
+		if (!GRID_IN(&hpa->terrain, x, y))
+			continue;
+
+		k = HPA_CLUSTER(hpa, x, y);
+		cluster = &hpa->clusters[k];
+		cluster->dirty |= HPA_DIRTY_CLUSTER;
+
+		if (x == cluster->x && x)
+			hpa->clusters[k - 1].dirty |= HPA_DIRTY_RIGHT;
+		if (x == cluster->x + cluster->width - 1)
+			cluster->dirty |= HPA_DIRTY_RIGHT;
+		if (y == cluster->y && y)
+			hpa->clusters[k - (size_t)hpa->cols].dirty |=
+				HPA_DIRTY_DOWN;
+		if (y == cluster->y + cluster->height - 1)
+			cluster->dirty |= HPA_DIRTY_DOWN;
+	}
+
+	return (hpa_rebuild(hpa));
+}
@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "pathfinding.h"
+
+#define IN_CLUSTER(c, px, py) ((px) >= (c)->x && (py) >= (c)->y && \
+	(px) < (c)->x + (c)->width && (py) < (c)->y + (c)->height)
+/* Cells facing each other across a border, @i cells along it */
+#define BORDER(a, down, i, pa, pb) ( \
+	(pa).x = (down) ? (a)->x + (i) : (a)->x + (a)->width - 1, \
+	(pa).y = (down) ? (a)->y + (a)->height - 1 : (a)->y + (i), \
+	(pb).x = (pa).x + !(down), (pb).y = (pa).y + !!(down))
+
+/* STATIC FUNCTIONS */
+
+static int hpa_border(hpa_t *hpa, size_t a, int down);
+static int hpa_cluster(hpa_t *hpa, hpa_cluster_t *cluster);
+static vertex_t *hpa_node(hpa_t *hpa, hpa_cluster_t *cluster,
+	point_t const *cell);
+static void hpa_drop(vertex_t *vertex, hpa_cluster_t const *cluster);
+
+/* API IMPLEMENTATION */
+
+/**
+ * hpa_rebuild - Rescans the stale borders, then redoes the searches inside
+ * the stale clusters
+ *
+ * @hpa: Pointer to hpa_t structure
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int hpa_rebuild(hpa_t *hpa)
+{
+	size_t nb = (size_t)hpa->cols * (size_t)hpa->rows, k;
+	hpa_cluster_t *cluster = NULL;
+	int ok = 1;
+
+	for (k = 0; ok && k < nb; ++k)
+	{
+		cluster = &hpa->clusters[k];
+
+		if ((cluster->dirty & HPA_DIRTY_RIGHT) &&
+			(k + 1) % (size_t)hpa->cols)
+			ok = hpa_border(hpa, k, 0);
+		if (ok && (cluster->dirty & HPA_DIRTY_DOWN) &&
+			k + (size_t)hpa->cols < nb)
+			ok = hpa_border(hpa, k, 1);
+
+		cluster->dirty &= ~(HPA_DIRTY_RIGHT | HPA_DIRTY_DOWN);
+	}
+
+	for (k = 0; ok && k < nb; ++k)
+	{
+		cluster = &hpa->clusters[k];
+
+		if (cluster->dirty & HPA_DIRTY_CLUSTER)
+			ok = hpa_cluster(hpa, cluster);
+
+		cluster->dirty &= ~HPA_DIRTY_CLUSTER;
+	}
+
+	/* New transitions may have outgrown the abstract search's workspace */
+	if (ok && (!hpa->ws || hpa->ws->capacity < hpa->graph->nb_vertices))
+	{
+		sp_workspace_delete(hpa->ws);
+		hpa->ws = sp_workspace_create(hpa->graph->nb_vertices,
+			SP_HEAP_DEFAULT);
+		ok = hpa->ws != NULL;
+	}
+
+	return (ok);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * hpa_border - Replaces the transitions across a cluster's right or lower
+ * border
+ * Each run of cells open on both sides is an entrance: narrow ones get a
+ * transition in their middle, wide ones one at each end
+ *
+ * @hpa: Pointer to hpa_t structure
+ * @a: Index of the cluster left of, or above, the border
+ * @down: 0 for its right border, 1 for its lower one
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int hpa_border(hpa_t *hpa, size_t a, int down)
+{
+	hpa_cluster_t *ca = &hpa->clusters[a], *cb = &hpa->clusters[a + 1];
+	int len = down ? ca->width : ca->height, i, run = -1, n, ends[2];
+	point_t pa, pb;
+	vertex_t *va = NULL, *vb = NULL;
+	unsigned long cost_a, cost_b;
+
+	if (down)
+		cb = &hpa->clusters[a + (size_t)hpa->cols];
+
+	for (i = 0; i < len; ++i)
+	{
+		BORDER(ca, down, i, pa, pb);
+		hpa_drop(hpa_node(NULL, ca, &pa), cb);
+		hpa_drop(hpa_node(NULL, cb, &pb), ca);
+	}
+
+	for (i = 0; i <= len; ++i)
+	{
+		if (i < len && (BORDER(ca, down, i, pa, pb),
+			grid_terrain_cost(&hpa->terrain, pa.x, pa.y) &&
+			grid_terrain_cost(&hpa->terrain, pb.x, pb.y)))
+		{
+			run = run < 0 ? i : run;
+			continue;
+		}
+
+		if (run < 0)
+			continue;
+
+		/* Cells run to i - 1 make an entrance */
+		ends[0] = run;
+		ends[1] = i - 1;
+		if (i - run < HPA_ENTRANCE_SPLIT)
+			ends[0] = ends[1] = (run + i - 1) / 2;
+
+		for (n = 0; n < 1 + (ends[0] != ends[1]); ++n)
+		{
+			BORDER(ca, down, ends[n], pa, pb);
+			va = hpa_node(hpa, ca, &pa);
+			vb = hpa_node(hpa, cb, &pb);
+			cost_a = GRID_TERRAIN_STRAIGHT *
+				grid_terrain_cost(&hpa->terrain, pa.x, pa.y);
+			cost_b = GRID_TERRAIN_STRAIGHT *
+				grid_terrain_cost(&hpa->terrain, pb.x, pb.y);
+
+			if (!va || !vb || !hpa_link(va, vb, cost_b) ||
+				!hpa_link(vb, va, cost_a))
+				return (0);
+		}
+
+		run = -1;
+	}
+
+	ca->dirty |= HPA_DIRTY_CLUSTER;
+	cb->dirty |= HPA_DIRTY_CLUSTER;
+	return (1);
+}
+
+/**
+ * hpa_cluster - Relinks the transitions of a cluster with one another,
+ * through the cheapest paths inside it
+ *
+ * @hpa: Pointer to hpa_t structure
+ * @cluster: Pointer to hpa_cluster_t structure
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int hpa_cluster(hpa_t *hpa, hpa_cluster_t *cluster)
+{
+	size_t slots = 2 * (size_t)(cluster->width + cluster->height), i, j;
+	vertex_t *node = NULL;
+	point_t from;
+	unsigned long g;
+	size_t cell;
+
+	cluster->nb_nodes = 0;
+
+	/* What is left once inner edges are gone crosses the borders */
+	for (i = 0; i < slots; ++i)
+	{
+		node = cluster->perimeter[i];
+		hpa_drop(node, cluster);
+
+		if (node && node->nb_edges)
+			cluster->nodes[cluster->nb_nodes++] = node;
+	}
+
+	for (i = 0; i < cluster->nb_nodes; ++i)
+	{
+		from.x = cluster->nodes[i]->x;
+		from.y = cluster->nodes[i]->y;
+
+		if (hpa_local(hpa, cluster, &from, NULL, 0) < 0)
+			return (0);
+
+		for (j = 0; j < cluster->nb_nodes; ++j)
+		{
+			node = cluster->nodes[j];
+			cell = GRID_CELL(&hpa->terrain, node->x, node->y);
+			g = grid_workspace_entry(hpa->local, cell)->g;
+
+			if (j != i && g != SP_UNREACHABLE &&
+				!hpa_link(cluster->nodes[i], node, g))
+				return (0);
+		}
+	}
+
+	return (1);
+}
+
+/**
+ * hpa_node - Looks up, or creates, the abstract vertex of a border cell
+ *
+ * @hpa: Pointer to hpa_t structure, or NULL to only look up
+ * @cluster: Cluster of the cell
+ * @cell: Cell coordinates, on the cluster's border
+ *
+ * Return: Pointer to the vertex, NULL on failure or if there is none
+ */
+static vertex_t *hpa_node(hpa_t *hpa, hpa_cluster_t *cluster,
+	point_t const *cell)
+{
+	int x = cell->x - cluster->x, y = cell->y - cluster->y;
+	vertex_t **slot = cluster->perimeter;
+	char name[32];
+
+	if (!y)
+		slot += x;
+	else if (y == cluster->height - 1)
+		slot += cluster->width + x;
+	else if (!x)
+		slot += 2 * cluster->width + y;
+	else
+		slot += 2 * cluster->width + cluster->height + y;
+
+	if (*slot || !hpa)
+		return (*slot);
+
+	sprintf(name, "%d,%d", cell->x, cell->y);
+	*slot = graph_add_vertex(hpa->graph, name, cell->x, cell->y);
+	return (*slot);
+}
+
+/**
+ * hpa_drop - Unlinks and frees the edges from a vertex into a cluster
+ *
+ * @vertex: Pointer to vertex_t structure (may be NULL)
+ * @cluster: Cluster the edges to drop lead into
+ */
+static void hpa_drop(vertex_t *vertex, hpa_cluster_t const *cluster)
+{
+	edge_t **link = NULL, *edge = NULL;
+
+	if (!vertex)
+		return;
+
+	for (link = &vertex->edges; *link;)
+	{
+		edge = *link;
+
+		if (!IN_CLUSTER(cluster, edge->dest->x, edge->dest->y))
+		{
+			link = &edge->next;
+			continue;
+		}
+
+		*link = edge->next;
+		--vertex->nb_edges;
+		free(edge);
+	}
+}
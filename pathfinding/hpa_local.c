@@ -0,0 +1,144 @@
+#include <limits.h>
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int hpa_expand(hpa_t *hpa, hpa_cluster_t const *cluster, size_t cell,
+	int reverse);
+
+/* API IMPLEMENTATION */
+
+/**
+ * hpa_local - Dijkstra confined to one cluster, into the abstraction's
+ * local workspace
+ *
+ * @hpa: Pointer to hpa_t structure
+ * @cluster: Cluster searched
+ * @from: Cell the search starts from, inside @cluster
+ * @to: Cell to stop at, or NULL to reach the whole cluster
+ * @reverse: Nonzero to compute costs to @from rather than from it
+ *
+ * Return: 1 if @to was reached (always when it is NULL), 0 if not, -1 on
+ *   failure
+ */
+int hpa_local(hpa_t *hpa, hpa_cluster_t const *cluster,
+	point_t const *from, point_t const *to, int reverse)
+{
+	grid_workspace_t *ws = hpa->local;
+	size_t cell = GRID_CELL(&hpa->terrain, from->x, from->y), goal;
+
+	goal = to ? GRID_CELL(&hpa->terrain, to->x, to->y) : SP_HEAP_NONE;
+
+	if (!ws->pq)
+		ws->pq = sp_heap_create(SP_HEAP_DEFAULT, ws->capacity);
+
+	if (!ws->pq)
+		return (-1);
+
+	grid_workspace_reset(ws);
+	grid_workspace_entry(ws, cell)->g = 0;
+
+	if (!sp_heap_push(ws->pq, cell, 0))
+		return (-1);
+
+	while ((cell = sp_heap_pop(ws->pq, NULL)) != SP_HEAP_NONE)
+	{
+		++hpa->stats.expanded;
+
+		if (cell == goal)
+			return (1);
+
+		if (!hpa_expand(hpa, cluster, cell, reverse))
+			return (-1);
+	}
+
+	return (!to);
+}
+
+/**
+ * hpa_link - Prepends an edge to a vertex's list
+ *
+ * @src: Vertex the edge leaves
+ * @dest: Vertex the edge leads to
+ * @weight: Weight of the edge
+ *
+ * Return: Pointer to the new edge, NULL on failure or if @weight does not
+ *   fit an edge
+ */
+edge_t *hpa_link(vertex_t *src, vertex_t *dest, unsigned long weight)
+{
+	edge_t *edge = NULL;
+
+	if (weight > INT_MAX)
+		return (NULL);
+
+	edge = calloc(1, sizeof(edge_t));
+
+	if (!edge)
+		return (NULL);
+
+	edge->dest = dest;
+	edge->weight = (int)weight;
+	edge->next = src->edges;
+	src->edges = edge;
+	++src->nb_edges;
+	return (edge);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * hpa_expand - Relaxes the moves out of (or into) a cell, within its
+ * cluster
+ *
+ * @hpa: Pointer to hpa_t structure
+ * @cluster: Cluster searched
+ * @cell: Cell index being expanded
+ * @reverse: Nonzero to relax the moves into the cell
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int hpa_expand(hpa_t *hpa, hpa_cluster_t const *cluster, size_t cell,
+	int reverse)
+{
+	static const int dx[] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	static const int dy[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+	const grid_terrain_t *terrain = &hpa->terrain;
+	int x = (int)(cell % (size_t)terrain->cols), nx;
+	int y = (int)(cell / (size_t)terrain->cols), ny, d;
+	unsigned long here = grid_terrain_cost(terrain, x, y), cost, g;
+	grid_entry_t *entry = NULL;
+	size_t next;
+
+	for (d = 0; here && d < hpa->connectivity; ++d)
+	{
+		nx = x + dx[d];
+		ny = y + dy[d];
+		cost = grid_terrain_cost(terrain, nx, ny);
+
+		/* Diagonal corners of two cells in a cluster are in it too */
+		if (!cost || nx < cluster->x || ny < cluster->y ||
+			nx >= cluster->x + cluster->width ||
+			ny >= cluster->y + cluster->height ||
+			(d >= 4 && (!grid_terrain_cost(terrain, nx, y) ||
+			!grid_terrain_cost(terrain, x, ny))))
+			continue;
+
+		g = hpa->local->entries[cell].g + (reverse ? here : cost) *
+			(d < 4 ? GRID_TERRAIN_STRAIGHT : GRID_TERRAIN_DIAGONAL);
+		next = GRID_CELL(terrain, nx, ny);
+		entry = grid_workspace_entry(hpa->local, next);
+
+		if (g >= entry->g)
+			continue;
+
+		entry->g = g;
+		entry->parent = cell;
+
+		if (!sp_heap_push(hpa->local->pq, next, g))
+			return (0);
+	}
+
+	return (1);
+}
@@ -0,0 +1,234 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int hpa_attach(hpa_t *hpa, hpa_cluster_t const *from,
+	hpa_cluster_t const *to);
+static void hpa_detach(hpa_t *hpa, hpa_cluster_t const *to);
+static queue_t *hpa_refine(hpa_t *hpa);
+static int hpa_push(queue_t *path, int x, int y);
+
+/* API IMPLEMENTATION */
+
+/**
+ * hpa_path - Finds a path across the terrain with HPA*
+ * The start and target are linked to the transitions of their clusters,
+ * the abstract graph is searched, and each of its hops inside a cluster is
+ * refined with a search confined to that cluster. Paths are near-optimal:
+ * they only ever cross borders at transitions
+ *
+ * @hpa: Pointer to hpa_t structure (queries modify its graph, so they must
+ *   not run concurrently)
+ * @start: Pointer to point_t for the start coordinates
+ * @target: Pointer to point_t for the target coordinates
+ *
+ * Return: Pointer to queue_t of point_t from @start to @target, NULL on
+ *   failure or if there is no path
+ */
+queue_t *hpa_path(hpa_t *hpa, point_t const *start, point_t const *target)
+{
+	hpa_cluster_t *from = NULL, *to = NULL;
+	int found;
+
+	if (!hpa || !start || !target ||
+		!grid_terrain_cost(&hpa->terrain, start->x, start->y) ||
+		!grid_terrain_cost(&hpa->terrain, target->x, target->y))
+		return (NULL);
+
+	hpa->stats.expanded = 0;
+	hpa->stats.relaxed = 0;
+	hpa->start->x = start->x;
+	hpa->start->y = start->y;
+	hpa->target->x = target->x;
+	hpa->target->y = target->y;
+	from = &hpa->clusters[HPA_CLUSTER(hpa, start->x, start->y)];
+	to = &hpa->clusters[HPA_CLUSTER(hpa, target->x, target->y)];
+
+	found = hpa_attach(hpa, from, to) && dijkstra_graph_path(hpa->ws,
+		hpa->graph, hpa->start, hpa->target, &hpa->path);
+	hpa_detach(hpa, to);
+
+	if (!found)
+		return (NULL);
+
+	return (hpa_refine(hpa));
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * hpa_attach - Links the start vertex to the transitions it reaches inside
+ * its cluster, and those that reach the target to the target vertex
+ *
+ * @hpa: Pointer to hpa_t structure, its start and target vertices placed
+ * @from: Cluster of the start
+ * @to: Cluster of the target
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int hpa_attach(hpa_t *hpa, hpa_cluster_t const *from,
+	hpa_cluster_t const *to)
+{
+	point_t start, target;
+	unsigned long g;
+	size_t i;
+
+	start.x = hpa->start->x;
+	start.y = hpa->start->y;
+	target.x = hpa->target->x;
+	target.y = hpa->target->y;
+
+	if (hpa_local(hpa, from, &start, NULL, 0) < 0)
+		return (0);
+
+	for (i = 0; i < from->nb_nodes; ++i)
+	{
+		g = grid_workspace_entry(hpa->local, GRID_CELL(&hpa->terrain,
+			from->nodes[i]->x, from->nodes[i]->y))->g;
+
+		if (g != SP_UNREACHABLE &&
+			!hpa_link(hpa->start, from->nodes[i], g))
+			return (0);
+	}
+
+	/* A target in the same cluster may also be reached without leaving */
+	g = grid_workspace_entry(hpa->local, GRID_CELL(&hpa->terrain, target.x,
+		target.y))->g;
+
+	if (from == to && g != SP_UNREACHABLE &&
+		!hpa_link(hpa->start, hpa->target, g))
+		return (0);
+
+	if (hpa_local(hpa, to, &target, NULL, 1) < 0)
+		return (0);
+
+	for (i = 0; i < to->nb_nodes; ++i)
+	{
+		g = grid_workspace_entry(hpa->local, GRID_CELL(&hpa->terrain,
+			to->nodes[i]->x, to->nodes[i]->y))->g;
+
+		if (g != SP_UNREACHABLE &&
+			!hpa_link(to->nodes[i], hpa->target, g))
+			return (0);
+	}
+
+	return (1);
+}
+
+/**
+ * hpa_detach - Frees the edges hpa_attach linked
+ *
+ * @hpa: Pointer to hpa_t structure
+ * @to: Cluster of the target
+ */
+static void hpa_detach(hpa_t *hpa, hpa_cluster_t const *to)
+{
+	edge_t *edge = NULL;
+	size_t i;
+
+	while ((edge = hpa->start->edges))
+	{
+		hpa->start->edges = edge->next;
+		free(edge);
+	}
+
+	hpa->start->nb_edges = 0;
+
+	/* hpa_link prepends, so edges to the target come first */
+	for (i = 0; i < to->nb_nodes; ++i)
+	{
+		edge = to->nodes[i]->edges;
+
+		if (edge && edge->dest == hpa->target)
+		{
+			to->nodes[i]->edges = edge->next;
+			--to->nodes[i]->nb_edges;
+			free(edge);
+		}
+	}
+}
+
+/**
+ * hpa_refine - Expands the abstract path of a query into cells
+ *
+ * @hpa: Pointer to hpa_t structure
+ *
+ * Return: Pointer to queue_t of point_t, NULL on failure
+ */
+static queue_t *hpa_refine(hpa_t *hpa)
+{
+	const vertex_t *a = NULL, *b = NULL;
+	queue_t *path = queue_create();
+	point_t from, to, *point = NULL;
+	size_t i, n, cell, k, *cells = hpa->local->fifo;
+	size_t cols = (size_t)hpa->terrain.cols;
+	int ok = path && hpa_push(path, hpa->start->x, hpa->start->y);
+
+	for (i = 1; ok && i < hpa->path.length; ++i)
+	{
+		a = hpa->path.vertices[i - 1];
+		b = hpa->path.vertices[i];
+		from.x = a->x, from.y = a->y;
+		to.x = b->x, to.y = b->y;
+
+		k = HPA_CLUSTER(hpa, a->x, a->y);
+
+		/* Hops across a border join neighbouring cells */
+		if (k != HPA_CLUSTER(hpa, b->x, b->y))
+		{
+			ok = hpa_push(path, b->x, b->y);
+			continue;
+		}
+
+		ok = hpa_local(hpa, &hpa->clusters[k], &from, &to, 0) == 1;
+		cell = GRID_CELL(&hpa->terrain, b->x, b->y);
+
+		/* Parents lead back from b: stack them, then append in order */
+		for (n = 0; ok && cell != GRID_CELL(&hpa->terrain, a->x, a->y);
+			cell = hpa->local->entries[cell].parent)
+			cells[n++] = cell;
+
+		while (ok && n--)
+			ok = hpa_push(path, (int)(cells[n] % cols),
+				(int)(cells[n] / cols));
+	}
+
+	if (!ok && path)
+	{
+		while ((point = dequeue(path)))
+			free(point);
+		queue_delete(path);
+		path = NULL;
+	}
+
+	return (path);
+}
+
+/**
+ * hpa_push - Appends a point to a path
+ *
+ * @path: Pointer to queue_t structure
+ * @x: X coordinate
+ * @y: Y coordinate
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int hpa_push(queue_t *path, int x, int y)
+{
+	point_t *point = calloc(1, sizeof(point_t));
+
+	if (!point)
+		return (0);
+
+	point->x = x;
+	point->y = y;
+
+	if (!queue_push_back(path, point))
+	{
+		free(point);
+		return (0);
+	}
+
+	return (1);
+}
@@ -0,0 +1,94 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * msf_create - Allocates an empty minimum spanning forest
+ *
+ * @nb_vertices: Number of vertices of the graph (bounds the edge count)
+ *
+ * Return: Pointer to msf_t structure, NULL on failure
+ */
+msf_t *msf_create(size_t nb_vertices)
+{
+	msf_t *msf = NULL;
+
+	msf = calloc(1, sizeof(msf_t) + (nb_vertices + 1) * sizeof(msf_edge_t));
+
+	if (!msf)
+		return (NULL);
+
+	msf->edges = (msf_edge_t *)(msf + 1);
+	return (msf);
+}
+
+/**
+ * msf_delete - Deallocates a minimum spanning forest
+ *
+ * @msf: Pointer to msf_t structure
+ */
+void msf_delete(msf_t *msf)
+{
+	free(msf);
+}
+
+/**
+ * msf_collect_edges - Copies every non-loop edge of a graph into an array
+ *
+ * @graph: Pointer to graph_t structure
+ * @nb_edges: Pointer to store the number of edges at
+ *
+ * Return: Pointer to malloc'd edge array, NULL on failure
+ */
+msf_edge_t *msf_collect_edges(graph_t const *graph, size_t *nb_edges)
+{
+	msf_edge_t *edges = NULL;
+	const vertex_t *v = NULL;
+	const edge_t *e = NULL;
+	size_t n = 0;
+
+	for (v = graph->vertices; v; v = v->next)
+		n += v->nb_edges;
+
+	edges = malloc((n + 1) * sizeof(msf_edge_t));
+
+	if (!edges)
+		return (NULL);
+
+	/* Both halves of a BIDIRECTIONAL edge are kept; union-find drops one */
+	for (n = 0, v = graph->vertices; v; v = v->next)
+	{
+		for (e = v->edges; e; e = e->next)
+		{
+			if (e->dest == v)
+				continue;
+
+			edges[n].src = v;
+			edges[n].dest = e->dest;
+			edges[n++].weight = e->weight;
+		}
+	}
+
+	*nb_edges = n;
+	return (edges);
+}
+
+/**
+ * msf_find - Union-find root lookup with path halving
+ *
+ * @parent: Union-find parent array, by vertex index
+ * @v: Vertex index
+ *
+ * Return: Index of the root of `v`'s set
+ */
+size_t msf_find(size_t *parent, size_t v)
+{
+	while (parent[v] != v)
+	{
+		parent[v] = parent[parent[v]];
+		v = parent[v];
+	}
+
+	return (v);
+}
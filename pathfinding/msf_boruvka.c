@@ -0,0 +1,183 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "pathfinding.h"
+
+#define NO_EDGE (~0UL)
+/* Packs (weight, edge id) so one integer compare gives a strict order */
+#define EDGE_KEY(w, id) (\
+	((unsigned long)((unsigned int)(w) ^ 0x80000000u) << 32) | (id)\
+)
+#define KEY_EDGE(key) ((size_t)((key) & 0xffffffffUL))
+
+/* STATIC FUNCTIONS */
+
+static void *scan_edges(void *arg);
+static void atomic_min(unsigned long *slot, unsigned long key);
+static size_t merge_round(msf_t *msf, msf_boruvka_ctx_t *ctx,
+	size_t *parent, size_t nb_vertices);
+
+/* API IMPLEMENTATION */
+
+/**
+ * msf_boruvka - Minimum spanning forest via parallel Boruvka rounds
+ *
+ * @graph: Pointer to graph_t structure (edges are taken as undirected)
+ * @nb_threads: Number of threads scanning edges (0 means 1)
+ *
+ * Return: Pointer to msf_t structure, NULL on failure
+ */
+msf_t *msf_boruvka(graph_t const *graph, size_t nb_threads)
+{
+	msf_boruvka_ctx_t ctx = { NULL, 0, NULL, NULL };
+	msf_boruvka_job_t *jobs = NULL;
+	pthread_t *tids = NULL;
+	msf_t *msf = NULL;
+	size_t *parent = NULL, n, i, started;
+
+	if (!graph)
+		return (NULL);
+
+	n = graph->nb_vertices, nb_threads = nb_threads ? nb_threads : 1;
+	ctx.edges = msf_collect_edges(graph, &ctx.nb_edges);
+	parent = malloc((2 * n + 1) * sizeof(size_t));
+	ctx.best = malloc((n + 1) * sizeof(unsigned long));
+	jobs = malloc(nb_threads * sizeof(msf_boruvka_job_t));
+	tids = malloc(nb_threads * sizeof(pthread_t));
+	msf = msf_create(n);
+
+	if (!ctx.edges || !parent || !ctx.best || !jobs || !tids || !msf ||
+		ctx.nb_edges > 0xffffffffUL)
+		goto on_fail;
+
+	ctx.comp = parent + n;
+
+	for (i = 0; i < n; ++i)
+		parent[i] = ctx.comp[i] = i;
+
+	do {
+		for (i = 0; i < n; ++i)
+			ctx.best[i] = NO_EDGE;
+
+		for (i = 0, started = 0; i < nb_threads; ++i)
+		{
+			jobs[i].ctx = &ctx;
+			jobs[i].first = ctx.nb_edges * i / nb_threads;
+			jobs[i].last = ctx.nb_edges * (i + 1) / nb_threads;
+
+			if (i && !pthread_create(tids + started, NULL,
+				scan_edges, jobs + i))
+				++started;
+			else if (i)
+				scan_edges(jobs + i);
+		}
+
+		scan_edges(jobs);
+
+		for (i = 0; i < started; ++i)
+			pthread_join(tids[i], NULL);
+	} while (merge_round(msf, &ctx, parent, n));
+
+	goto out;
+
+on_fail:
+	msf_delete(msf);
+	msf = NULL;
+out:
+	free((void *)ctx.edges), free(parent), free(ctx.best);
+	free(jobs), free(tids);
+	return (msf);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * scan_edges - Thread body: cheapest outgoing edge of each component
+ *
+ * @arg: Pointer to msf_boruvka_job_t structure
+ *
+ * Return: `arg`
+ */
+static void *scan_edges(void *arg)
+{
+	msf_boruvka_job_t *job = arg;
+	const msf_boruvka_ctx_t *ctx = job->ctx;
+	const msf_edge_t *edge = NULL;
+	size_t i, a, b;
+	unsigned long key;
+
+	for (i = job->first; i < job->last; ++i)
+	{
+		edge = ctx->edges + i;
+		a = ctx->comp[edge->src->index];
+		b = ctx->comp[edge->dest->index];
+
+		if (a == b)
+			continue;
+
+		key = EDGE_KEY(edge->weight, i);
+
+		if (key < __atomic_load_n(ctx->best + a, __ATOMIC_RELAXED))
+			atomic_min(ctx->best + a, key);
+
+		if (key < __atomic_load_n(ctx->best + b, __ATOMIC_RELAXED))
+			atomic_min(ctx->best + b, key);
+	}
+
+	return (arg);
+}
+
+/**
+ * atomic_min - Lowers a shared slot to `key` if `key` is smaller
+ *
+ * @slot: Pointer to shared slot
+ * @key: Candidate value
+ */
+static void atomic_min(unsigned long *slot, unsigned long key)
+{
+	unsigned long cur = __atomic_load_n(slot, __ATOMIC_RELAXED);
+
+	while (key < cur && !__atomic_compare_exchange_n(slot, &cur, key, 1,
+		__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+}
+
+/**
+ * merge_round - Adds every component's cheapest edge, then relabels
+ *
+ * @msf: Pointer to forest being built
+ * @ctx: Pointer to shared round state
+ * @parent: Union-find parent array
+ * @nb_vertices: Number of vertices
+ *
+ * Return: Number of edges added this round (0 once the forest is complete)
+ */
+static size_t merge_round(msf_t *msf, msf_boruvka_ctx_t *ctx,
+	size_t *parent, size_t nb_vertices)
+{
+	const msf_edge_t *edge = NULL;
+	size_t i, a, b, added = 0;
+
+	for (i = 0; i < nb_vertices; ++i)
+	{
+		if (ctx->best[i] == NO_EDGE)
+			continue;
+
+		edge = ctx->edges + KEY_EDGE(ctx->best[i]);
+		a = msf_find(parent, edge->src->index);
+		b = msf_find(parent, edge->dest->index);
+
+		/* Both endpoints may have picked the same edge */
+		if (a == b)
+			continue;
+
+		parent[a] = b;
+		msf->edges[msf->nb_edges++] = *edge;
+		msf->total_weight += edge->weight;
+		++added;
+	}
+
+	for (i = 0; i < nb_vertices; ++i)
+		ctx->comp[i] = msf_find(parent, i);
+
+	return (added);
+}
@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/* Order-preserving map of a signed weight to an unsigned radix key */
+#define WEIGHT_KEY(w) ((unsigned int)(w) ^ 0x80000000u)
+#define KEY_BYTE(w, pass) ((WEIGHT_KEY(w) >> ((pass) * 8)) & 0xffu)
+
+/* STATIC FUNCTIONS */
+
+static msf_edge_t *radix_sort(msf_edge_t *edges, msf_edge_t *tmp, size_t n);
+
+/* API IMPLEMENTATION */
+
+/**
+ * msf_kruskal - Minimum spanning forest via Kruskal's algorithm
+ *
+ * @graph: Pointer to graph_t structure (edges are taken as undirected)
+ *
+ * Return: Pointer to msf_t structure, NULL on failure
+ */
+msf_t *msf_kruskal(graph_t const *graph)
+{
+	msf_t *msf = NULL;
+	msf_edge_t *edges = NULL, *tmp = NULL, *sorted = NULL;
+	size_t *parent = NULL, nb_edges = 0, i, a, b;
+
+	if (!graph)
+		return (NULL);
+
+	edges = msf_collect_edges(graph, &nb_edges);
+	tmp = malloc((nb_edges + 1) * sizeof(msf_edge_t));
+	parent = malloc((graph->nb_vertices + 1) * sizeof(size_t));
+	msf = msf_create(graph->nb_vertices);
+
+	if (!edges || !tmp || !parent || !msf)
+	{
+		msf_delete(msf);
+		msf = NULL;
+		goto out;
+	}
+
+	for (i = 0; i < graph->nb_vertices; ++i)
+		parent[i] = i;
+
+	sorted = radix_sort(edges, tmp, nb_edges);
+
+	for (i = 0; i < nb_edges && msf->nb_edges + 1 < graph->nb_vertices; ++i)
+	{
+		a = msf_find(parent, sorted[i].src->index);
+		b = msf_find(parent, sorted[i].dest->index);
+
+		if (a == b)
+			continue;
+
+		parent[a] = b;
+		msf->edges[msf->nb_edges++] = sorted[i];
+		msf->total_weight += sorted[i].weight;
+	}
+
+out:
+	free(edges);
+	free(tmp);
+	free(parent);
+	return (msf);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * radix_sort - Stable LSD radix sort of edges by weight, one byte per pass
+ *
+ * @edges: Edges to sort
+ * @tmp: Scratch array of the same size
+ * @n: Number of edges
+ *
+ * Return: Whichever of `edges` or `tmp` holds the sorted result
+ */
+static msf_edge_t *radix_sort(msf_edge_t *edges, msf_edge_t *tmp, size_t n)
+{
+	size_t count[256], i, sum, pass;
+	msf_edge_t *swap = NULL;
+
+	for (pass = 0; pass < 4; ++pass)
+	{
+		memset(count, 0, sizeof(count));
+
+		for (i = 0; i < n; ++i)
+			++count[KEY_BYTE(edges[i].weight, pass)];
+
+		/* Small weights share their high bytes: skip no-op passes */
+		if (n && count[KEY_BYTE(edges[0].weight, pass)] == n)
+			continue;
+
+		for (i = 0, sum = 0; i < 256; ++i)
+		{
+			sum += count[i];
+			count[i] = sum - count[i];
+		}
+
+		for (i = 0; i < n; ++i)
+			tmp[count[KEY_BYTE(edges[i].weight, pass)]++] =
+				edges[i];
+
+		swap = edges, edges = tmp, tmp = swap;
+	}
+
+	return (edges);
+}
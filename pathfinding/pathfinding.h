@@ -1,6 +1,7 @@
 #ifndef SYSTEMALGORITHMS_PATHFINDING_H
 #define SYSTEMALGORITHMS_PATHFINDING_H
 
+#include <pthread.h>
 #include "graphs.h"
 #include "queues.h"
 
@@ -15,74 +16,1559 @@ typedef struct point_s
 	int x, y;
 } point_t;
 
+/* Bits per grid word, and words per cache line */
+#define GRID_WORD_BITS (8 * sizeof(unsigned long))
+#define GRID_LINE_WORDS (64 / sizeof(unsigned long))
+/* Grid files: magic string, and size of the header preceding the rows */
+#define GRID_FILE_MAGIC "SPGRID1"
+#define GRID_FILE_HEADER 64
+
+#define GRID_IN(grid, x, y) (\
+	(x) >= 0 && (x) < (grid)->cols && (y) >= 0 && (y) < (grid)->rows\
+)
+#define GRID_ROW(grid, y) ((grid)->bits + (size_t)(y) * (grid)->stride)
+#define GRID_WORD(grid, x, y) (GRID_ROW(grid, y)[(size_t)(x) / GRID_WORD_BITS])
+#define GRID_BIT(x) (1UL << ((size_t)(x) % GRID_WORD_BITS))
+/* Whether an in-range cell is open (a '0' in the char ** format) */
+#define GRID_OPEN(grid, x, y) ((GRID_WORD(grid, x, y) & GRID_BIT(x)) != 0)
+
+/**
+ * struct grid_s - Maze stored as a packed bitset, one bit per cell, set
+ * for open cells
+ * Rows start on word boundaries; rows of up to a cache line are padded to
+ * a power-of-two number of words and wider rows to whole cache lines, so
+ * no short row straddles two lines. Padding bits are clear
+ *
+ * @rows: Number of rows
+ * @cols: Number of columns
+ * @stride: Words per row
+ * @bits: Rows of cells, bit x % GRID_WORD_BITS of word x / GRID_WORD_BITS
+ *   holding column x
+ * @mapping: File mapping holding `bits` (read-only), NULL if allocated
+ * @mapping_size: Size of `mapping`
+ */
+typedef struct grid_s
+{
+	int rows, cols;
+	size_t stride;
+	unsigned long *bits;
+	void *mapping;
+	size_t mapping_size;
+} grid_t;
+
+/**
+ * struct grid_file_header_s - Header of a grid file, padded with zeroes to
+ * GRID_FILE_HEADER bytes and followed by the rows exactly as in memory
+ * Files are only meant for hosts sharing the writer's word size and byte
+ * order, which `word_bits` and the magic check loosely
+ *
+ * @magic: GRID_FILE_MAGIC
+ * @word_bits: GRID_WORD_BITS of the writer
+ * @rows: Number of rows
+ * @cols: Number of columns
+ * @stride: Words per row
+ */
+typedef struct grid_file_header_s
+{
+	char magic[8];
+	unsigned long word_bits, rows, cols, stride;
+} grid_file_header_t;
+
+/* Id returned by an empty heap, and position of ids not in a heap */
+#define SP_HEAP_NONE ((size_t)-1)
+#define SP_HEAP_DEFAULT SP_HEAP_QUATERNARY
+/* SP_HEAP_AUTO uses buckets when no edge weighs more than this */
+#define SP_BUCKET_MAX_WEIGHT 4096
+
+/**
+ * enum sp_heap_kind_e - Priority queue implementations behind sp_heap_t
+ *
+ * @SP_HEAP_BINARY: Indexed binary heap
+ * @SP_HEAP_QUATERNARY: Indexed 4-ary heap (shallower, cache-friendlier)
+ * @SP_HEAP_PAIRING: Pairing heap (O(1) insert, cheap decrease-key)
+ * @SP_HEAP_BUCKET: Dial's circular buckets, O(1) operations for monotone
+ *   integer keys spanning less than the number of buckets
+ * @SP_HEAP_AUTO: Not a queue: lets a search pick SP_HEAP_BUCKET for small
+ *   non-negative weights, SP_HEAP_DEFAULT otherwise
+ */
+typedef enum sp_heap_kind_e
+{
+	SP_HEAP_BINARY = 0,
+	SP_HEAP_QUATERNARY,
+	SP_HEAP_PAIRING,
+	SP_HEAP_BUCKET,
+	SP_HEAP_AUTO
+} sp_heap_kind_t;
+
+/**
+ * struct sp_pairing_node_s - Pairing heap node, one per id
+ * The bucket kind reuses it as a doubly linked list node (`child` unused)
+ *
+ * @child: Leftmost child id
+ * @sibling: Right sibling id
+ * @prev: Left sibling id, or parent id for a leftmost child
+ */
+typedef struct sp_pairing_node_s
+{
+	size_t child, sibling, prev;
+} sp_pairing_node_t;
+
+/**
+ * struct sp_heap_s - Indexed min-priority queue of ids in [0, capacity)
+ *
+ * @kind: Implementation
+ * @arity: Children per node (d-ary kinds)
+ * @size: Number of ids queued
+ * @capacity: Number of distinct ids
+ * @key: Priority of each queued id, by id
+ * @pos: Position of each id in `items` (d-ary), a membership mark
+ *   (pairing) or its bucket (bucket), SP_HEAP_NONE when not queued
+ * @items: Heap-ordered ids (d-ary kinds)
+ * @nodes: Tree links (pairing kind) or list links (bucket kind), by id
+ * @root: Root id (pairing kind)
+ * @buckets: Head id of each bucket (bucket kind)
+ * @nb_buckets: Number of buckets, more than the largest key step
+ * @cursor: Bucket holding the smallest possible key (bucket kind)
+ * @cursor_key: Key stored in bucket `cursor` (bucket kind)
+ */
+typedef struct sp_heap_s
+{
+	sp_heap_kind_t kind;
+	size_t arity, size, capacity;
+	unsigned long *key;
+	size_t *pos, *items;
+	sp_pairing_node_t *nodes;
+	size_t root;
+	size_t *buckets, nb_buckets, cursor;
+	unsigned long cursor_key;
+} sp_heap_t;
+
+/**
+ * struct dijkstra_entry_s - Entry in Dijkstra's algorithm bookkeeping array
+ * An entry whose epoch differs from its workspace's is unset: it reads as
+ * unreached (and unvisited) without having been cleared
+ *
+ * @prev: Pointer to previous vertex leading to current vertex's min distance
+ * @vertex: Vertex owning the entry (heap ids are vertex indices)
+ * @distance: Min distance of vertex from start
+ * @epoch: Workspace epoch in which the entry was last written
+ */
+typedef struct dijkstra_entry_s
+{
+	const vertex_t *prev, *vertex;
+	unsigned int distance, epoch;
+} dijkstra_entry_t;
+
+/**
+ * struct sp_workspace_s - Reusable shortest-path query state
+ * Allocate one per thread and pass it to every query: starting a query
+ * bumps the epoch instead of clearing the entries, so setup no longer
+ * costs O(V)
+ *
+ * @capacity: Number of entries (vertices or grid cells)
+ * @epoch: Current epoch, never 0
+ * @entries: Bookkeeping array, by vertex index or cell index
+ * @pq: Indexed priority queue keyed on distance
+ */
+typedef struct sp_workspace_s
+{
+	size_t capacity;
+	unsigned int epoch;
+	dijkstra_entry_t *entries;
+	sp_heap_t *pq;
+} sp_workspace_t;
+
+/* Whether entry `i` was written during the current query */
+#define SP_WORKSPACE_SEEN(ws, i) ((ws)->entries[i].epoch == (ws)->epoch)
+#define SP_WORKSPACE_MARK(ws, i) ((ws)->entries[i].epoch = (ws)->epoch)
+
+/**
+ * struct sp_visited_s - Reusable visited marks for backtracking, which
+ * needs neither distances nor a priority queue
+ * A byte per vertex or cell: starting a search bumps the epoch instead of
+ * clearing the marks
+ *
+ * @capacity: Number of marks (vertices or cells)
+ * @epoch: Current epoch, never 0
+ * @marks: Epoch in which each vertex or cell was last visited
+ */
+typedef struct sp_visited_s
+{
+	size_t capacity;
+	unsigned char epoch;
+	unsigned char *marks;
+} sp_visited_t;
+
+/* Whether mark `i` was set during the current search */
+#define SP_VISITED_SEEN(vis, i) ((vis)->marks[i] == (vis)->epoch)
+#define SP_VISITED_MARK(vis, i) ((vis)->marks[i] = (vis)->epoch)
+
+/**
+ * struct sp_path_s - Path as a contiguous array of vertex pointers
+ * To supply a buffer, set `vertices` and `capacity`; a search then fails if
+ * the path does not fit, leaving the size needed in `length`. A zeroed
+ * structure instead lets searches allocate (and grow) a buffer of their
+ * own, reused by later searches until sp_path_release.
+ *
+ * @vertices: Vertices from start to target
+ * @length: Number of vertices in the path
+ * @capacity: Number of slots in `vertices`
+ * @cost: Sum of the weights of the edges followed
+ * @owned: Non-0 if `vertices` was allocated by a search
+ */
+typedef struct sp_path_s
+{
+	const vertex_t **vertices;
+	size_t length, capacity;
+	unsigned long cost;
+	int owned;
+} sp_path_t;
+
+/**
+ * struct dijkstra_ctx_s - Dijkstra's-algorithm context data
+ *
+ * @graph: Pointer to graph data structure
+ * @ws: Workspace holding the bookkeeping array and priority queue
+ * @start: Pointer to start vertex
+ * @target: Pointer to target vertex
+ * @alt: Landmark tables turning the search into A*, or NULL
+ */
+typedef struct dijkstra_ctx_s
+{
+	graph_t *graph;
+	sp_workspace_t *ws;
+	const vertex_t *start, *target;
+	const struct alt_s *alt;
+} dijkstra_ctx_t;
+
+/**
+ * struct array_backtrack_frame_s - Cell being explored by backtracking
+ *
+ * @x: X coordinate
+ * @y: Y coordinate
+ * @dir: Next direction to try (right, down, left, up, then done)
+ */
+typedef struct array_backtrack_frame_s
+{
+	int x, y, dir;
+} array_backtrack_frame_t;
+
 /**
  * struct array_backtrack_ctx_s - Backtracking context
+ * Frames are only pushed for cells being visited, so the stack never holds
+ * more than the number of cells visited
  *
- * @map: Maze grid
- * @visited: Array to track visitation
+ * @map: Maze grid, unused when `grid` is set
+ * @grid: Packed maze, NULL to use `map`
+ * @visited: Visited marks, by cell index, unused when `grid` is set
+ * @seen: Visited bitset laid out like `grid`, NULL to use `visited`
  * @rows: Number of rows
  * @cols: Number of columns
  * @target: Target point
  * @path: Queue representing the path
+ * @stack: Explicit stack standing for the recursion
+ * @size: Number of frames in `stack`
+ * @cap: Capacity of `stack`
+ * @steps: Number of cells checked so far
+ * @max_steps: Checks allowed before giving up (0 for no limit)
  */
 typedef struct array_backtrack_ctx_s
 {
 	char **map;
-	unsigned char *visited;
+	const grid_t *grid;
+	sp_visited_t *visited;
+	grid_t *seen;
 	int rows, cols;
 	const point_t *target;
 	queue_t *path;
+	array_backtrack_frame_t *stack;
+	size_t size, cap, steps, max_steps;
 } array_backtrack_ctx_t;
 
+/**
+ * struct graph_backtrack_frame_s - Vertex being explored by backtracking
+ *
+ * @vertex: Pointer to vertex
+ * @edge: Next edge to try
+ * @weight: Weight of the edge the vertex was reached through
+ * @on_path: Set once one of its edges led to the target
+ */
+typedef struct graph_backtrack_frame_s
+{
+	const vertex_t *vertex;
+	const edge_t *edge;
+	int weight, on_path;
+} graph_backtrack_frame_t;
+
 /**
  * struct graph_backtrack_ctx_s - Graph backtracking context data
+ * Frames are only pushed for vertices being visited, so the stack never
+ * holds more than the number of vertices visited
  *
  * @graph: Pointer to graph_t structure
- * @visited: Array to track visitation
+ * @visited: Visited marks, by vertex index
  * @target: Target vertex
- * @path: Queue representing the path
+ * @path: Path, filled target first as frames are popped
+ * @stack: Explicit stack standing for the recursion
+ * @size: Number of frames in `stack`
+ * @cap: Capacity of `stack`
+ * @steps: Number of vertices checked so far
+ * @max_steps: Checks allowed before giving up (0 for no limit)
  */
 typedef struct graph_backtrack_ctx_s
 {
 	graph_t *graph;
-	unsigned char *visited;
+	sp_visited_t *visited;
 	const vertex_t *target;
-	queue_t *path;
+	sp_path_t *path;
+	graph_backtrack_frame_t *stack;
+	size_t size, cap, steps, max_steps;
 } graph_backtrack_ctx_t;
 
 /**
- * struct dijkstra_entry_s - Entry in Dijkstra's algorithm bookkeeping array
+ * struct msf_edge_s - Edge of a minimum spanning forest
  *
- * @prev: Pointer to previous vertex leading to current vertex's min distance
- * @distance: Min distance of vertex from start (31 bits, unsigned)
- * @frontier: Bit flag indicating if the vertex is in the priority queue
+ * @src: Pointer to one endpoint
+ * @dest: Pointer to the other endpoint
+ * @weight: Weight of the edge
  */
-typedef struct dijkstra_entry_s
+typedef struct msf_edge_s
+{
+	const vertex_t *src, *dest;
+	int weight;
+} msf_edge_t;
+
+/**
+ * struct msf_s - Minimum spanning forest
+ *
+ * @edges: Chosen edges (at most `nb_vertices - 1`)
+ * @nb_edges: Number of chosen edges
+ * @total_weight: Sum of the chosen edges' weights
+ */
+typedef struct msf_s
+{
+	msf_edge_t *edges;
+	size_t nb_edges;
+	long total_weight;
+} msf_t;
+
+/**
+ * struct msf_boruvka_ctx_s - Shared state of one Boruvka round
+ *
+ * @edges: Every edge of the graph
+ * @nb_edges: Number of edges
+ * @comp: Component of each vertex, by vertex index
+ * @best: Cheapest outgoing (weight key << 32 | edge id) of each component
+ */
+typedef struct msf_boruvka_ctx_s
+{
+	const msf_edge_t *edges;
+	size_t nb_edges;
+	size_t *comp;
+	unsigned long *best;
+} msf_boruvka_ctx_t;
+
+/**
+ * struct msf_boruvka_job_s - Edge range scanned by one Boruvka thread
+ *
+ * @ctx: Pointer to shared round state
+ * @first: First edge id
+ * @last: One past the last edge id
+ */
+typedef struct msf_boruvka_job_s
+{
+	msf_boruvka_ctx_t *ctx;
+	size_t first, last;
+} msf_boruvka_job_t;
+
+/**
+ * struct sp_stats_s - Work counters of a shortest-path search
+ *
+ * @expanded: Number of vertices settled (popped from the frontier)
+ * @relaxed: Number of edges that improved a tentative distance
+ */
+typedef struct sp_stats_s
+{
+	size_t expanded, relaxed;
+} sp_stats_t;
+
+/**
+ * enum sp_trace_kind_e - Search steps reported to a trace sink
+ *
+ * @SP_TRACE_EXPAND: A vertex or cell is examined (the former "Checking"
+ *   output)
+ * @SP_TRACE_RELAX: An edge improved a tentative distance
+ * @SP_TRACE_PUSH: A vertex or cell joined the frontier or the stack
+ * @SP_TRACE_POP: A vertex or cell left the frontier or the stack
+ */
+typedef enum sp_trace_kind_e
+{
+	SP_TRACE_EXPAND = 0,
+	SP_TRACE_RELAX,
+	SP_TRACE_PUSH,
+	SP_TRACE_POP
+} sp_trace_kind_t;
+
+/**
+ * enum sp_trace_search_e - Search emitting a trace event
+ *
+ * @SP_TRACE_ARRAY: backtracking_array (events carry coordinates)
+ * @SP_TRACE_GRAPH: backtracking_graph
+ * @SP_TRACE_DIJKSTRA: dijkstra_graph
+ */
+typedef enum sp_trace_search_e
+{
+	SP_TRACE_ARRAY = 0,
+	SP_TRACE_GRAPH,
+	SP_TRACE_DIJKSTRA
+} sp_trace_search_t;
+
+/* Mask bit of an event kind, and the mask of every kind */
+#define SP_TRACE_BIT(kind) (1u << (kind))
+#define SP_TRACE_ALL 0xfu
+
+/**
+ * struct sp_trace_event_s - Structured trace event
+ *
+ * @kind: Step taken
+ * @search: Search taking it
+ * @vertex: Vertex concerned (graph searches)
+ * @source: Start vertex of the search (graph searches)
+ * @x: X coordinate of the cell concerned (array search)
+ * @y: Y coordinate of the cell concerned (array search)
+ * @value: Distance of the vertex (Dijkstra), 0 otherwise
+ */
+typedef struct sp_trace_event_s
+{
+	sp_trace_kind_t kind;
+	sp_trace_search_t search;
+	const vertex_t *vertex, *source;
+	int x, y;
+	unsigned long value;
+} sp_trace_event_t;
+
+/**
+ * sp_trace_fn_t - Receives a batch of consecutive trace events
+ *
+ * @events: Events, oldest first
+ * @count: Number of events
+ * @data: Sink's user data
+ */
+typedef void (*sp_trace_fn_t)(const sp_trace_event_t *events, size_t count,
+	void *data);
+
+/**
+ * struct sp_trace_sink_s - Ring buffer batching trace events
+ * With a callback, a full ring is flushed to it before the next event is
+ * stored. Without one, the newest events overwrite the oldest and the
+ * last `capacity` of them remain for a later sp_trace_flush
+ *
+ * @flush: Callback receiving batches, or NULL
+ * @data: User data passed to `flush`
+ * @mask: SP_TRACE_BIT of each kind recorded (SP_TRACE_ALL by default)
+ * @capacity: Number of slots in `events`
+ * @head: Slot of the oldest event
+ * @size: Number of events stored
+ * @dropped: Number of events overwritten
+ * @events: Slots
+ */
+typedef struct sp_trace_sink_s
+{
+	sp_trace_fn_t flush;
+	void *data;
+	unsigned int mask;
+	size_t capacity, head, size;
+	unsigned long dropped;
+	sp_trace_event_t *events;
+} sp_trace_sink_t;
+
+/* Sink receiving the calling thread's events, NULL when tracing is off */
+extern __thread sp_trace_sink_t *sp_trace_active;
+
+/*
+ * Trace hooks. Building with -DSP_TRACE_DISABLE compiles them out; other
+ * builds pay one thread-local load and a test per hook while no sink is
+ * attached
+ */
+#ifdef SP_TRACE_DISABLE
+#define SP_TRACE(kind, search, vertex, source, x, y, value) ((void)0)
+#define SP_TRACE_FLUSH() ((void)0)
+#else
+#define SP_TRACE(kind, search, vertex, source, x, y, value) (\
+	sp_trace_active && (sp_trace_active->mask & SP_TRACE_BIT(kind)) ? \
+	sp_trace_emit(sp_trace_active, kind, search, vertex, source, x, y, \
+		(unsigned long)(value)) : \
+	(void)0\
+)
+#define SP_TRACE_FLUSH() (\
+	sp_trace_active ? sp_trace_flush(sp_trace_active) : (void)0\
+)
+#endif
+
+/**
+ * astar_heuristic_t - Lower bound on the cost from a vertex to the target
+ * It must never overestimate, and must be consistent (h(u) <= w(u, v) + h(v))
+ * since expanded vertices are not reopened
+ */
+typedef unsigned int (*astar_heuristic_t)(const vertex_t *v,
+	const vertex_t *target);
+
+/**
+ * struct astar_entry_s - Entry in A*'s bookkeeping array
+ *
+ * @prev: Pointer to previous vertex on the best known path
+ * @g: Best known cost from start
+ * @closed: Flag set once the vertex has been expanded
+ */
+typedef struct astar_entry_s
 {
 	const vertex_t *prev;
-	unsigned distance : 31;
-	unsigned frontier : 1;
-} dijkstra_entry_t;
+	unsigned long g;
+	unsigned char closed;
+} astar_entry_t;
 
 /**
- * struct dijkstra_ctx_s - Dijkstra's-algorithm context data
+ * struct astar_node_s - Open-list node (stale copies are skipped on pop)
+ *
+ * @f: Estimated total cost through the vertex (g + h)
+ * @vertex: Pointer to vertex
+ */
+typedef struct astar_node_s
+{
+	unsigned long f;
+	const vertex_t *vertex;
+} astar_node_t;
+
+/**
+ * struct astar_ctx_s - A* search context data
  *
  * @graph: Pointer to graph data structure
  * @entries: Bookkeeping array
  * @start: Pointer to start vertex
  * @target: Pointer to target vertex
- * @pq: Array implementation of priority queue (vertex_t pointers)
- * @pq_size: Current number of elements in priority queue
- * @path: Queue representing the path
+ * @heuristic: Heuristic function (NULL behaves like Dijkstra)
+ * @open: Binary min-heap of open nodes
+ * @open_size: Number of nodes in `open`
+ * @open_cap: Capacity of `open`
+ * @stats: Work counters
  */
-typedef struct dijkstra_ctx_s
+typedef struct astar_ctx_s
 {
 	graph_t *graph;
-	dijkstra_entry_t *entries;
-	const vertex_t *start, *target, **pq;
-	size_t pq_size;
-	queue_t *path;
-} dijkstra_ctx_t;
+	astar_entry_t *entries;
+	const vertex_t *start, *target;
+	astar_heuristic_t heuristic;
+	astar_node_t *open;
+	size_t open_size, open_cap;
+	sp_stats_t stats;
+} astar_ctx_t;
+
+/**
+ * struct sp_in_edges_s - Incoming-edge view of a graph, in CSR layout
+ * Lets backward searches walk edges against their direction, which the
+ * adjacency lists alone cannot do for UNIDIRECTIONAL edges
+ *
+ * @nb_vertices: Number of vertices
+ * @nb_edges: Number of edges
+ * @offsets: In-edges of vertex i are [offsets[i], offsets[i + 1])
+ * @sources: Tail vertex of each in-edge
+ * @weights: Weight of each in-edge
+ * @vertices: Vertex pointers, by index
+ */
+typedef struct sp_in_edges_s
+{
+	size_t nb_vertices, nb_edges;
+	size_t *offsets;
+	const vertex_t **sources;
+	int *weights;
+	const vertex_t **vertices;
+} sp_in_edges_t;
+
+/**
+ * struct dijkstra_bidi_entry_s - Per-vertex state of a bidirectional search
+ * Index 0 is the forward search (from start), index 1 the backward search
+ * (towards target)
+ *
+ * @next: Predecessor (forward) or successor (backward) on the best path
+ * @dist: Best known distance from start (forward) or to target (backward)
+ */
+typedef struct dijkstra_bidi_entry_s
+{
+	const vertex_t *next[2];
+	unsigned long dist[2];
+} dijkstra_bidi_entry_t;
+
+/**
+ * struct dijkstra_bidi_ctx_s - Bidirectional Dijkstra context data
+ *
+ * @in: Incoming-edge view used by the backward search
+ * @entries: Bookkeeping array, by vertex index
+ * @pq: Forward and backward priority queues
+ * @start: Pointer to start vertex
+ * @target: Pointer to target vertex
+ * @meet: Vertex where the best start-target path found so far crosses over
+ * @best: Cost of that path (~0UL while none is known)
+ * @stats: Work counters (both directions)
+ */
+typedef struct dijkstra_bidi_ctx_s
+{
+	const sp_in_edges_t *in;
+	dijkstra_bidi_entry_t *entries;
+	sp_heap_t *pq[2];
+	const vertex_t *start, *target, *meet;
+	unsigned long best;
+	sp_stats_t stats;
+} dijkstra_bidi_ctx_t;
+
+/* Marks "no vertex" / "no arc" in Contraction Hierarchies arrays */
+#define CH_NONE (~0u)
+/* Vertices a witness search may settle before giving up */
+#define CH_WITNESS_SETTLE_LIMIT 500
+
+/**
+ * struct ch_arc_s - Arc of a Contraction Hierarchy: an original edge or a
+ * shortcut standing for two consecutive arcs through a contracted vertex
+ *
+ * @tail: Source vertex (by index while contracting, by rank afterwards)
+ * @head: Destination vertex (likewise)
+ * @weight: Cost of the arc
+ * @child: Arcs (tail, mid) and (mid, head) a shortcut replaces, CH_NONE
+ *   for original edges
+ */
+typedef struct ch_arc_s
+{
+	unsigned int tail, head, weight;
+	unsigned int child[2];
+} ch_arc_t;
+
+/**
+ * struct ch_edge_s - CSR entry of the upward or downward graph
+ *
+ * @vertex: Rank of the higher-ranked endpoint
+ * @weight: Cost of the arc
+ * @arc: Id of the arc in ch_t.arcs (for unpacking)
+ */
+typedef struct ch_edge_s
+{
+	unsigned int vertex, weight, arc;
+} ch_edge_t;
+
+/**
+ * struct ch_s - Contraction Hierarchy of a graph
+ * The upward graph lists, for each vertex, its arcs towards higher-ranked
+ * vertices; the downward graph lists the arcs coming into it from
+ * higher-ranked vertices. A query only ever climbs both. Once built, the
+ * hierarchy numbers vertices by rank; `rank` maps vertex indices to it.
+ *
+ * @nb_vertices: Number of vertices
+ * @nb_arcs: Number of arcs (original edges plus shortcuts)
+ * @nb_shortcuts: Number of shortcuts added
+ * @vertices: Vertex pointers, by rank (the graph must outlive the CH)
+ * @rank: Contraction order of each vertex, by vertex index
+ * @arcs: Every arc
+ * @up_offsets: Upward arcs of rank r are [up_offsets[r], up_offsets[r + 1])
+ * @up: Upward CSR entries
+ * @down_offsets: Downward arcs of rank r, as for `up_offsets`
+ * @down: Downward CSR entries
+ */
+typedef struct ch_s
+{
+	size_t nb_vertices, nb_arcs, nb_shortcuts;
+	const vertex_t **vertices;
+	unsigned int *rank;
+	ch_arc_t *arcs;
+	size_t *up_offsets;
+	ch_edge_t *up;
+	size_t *down_offsets;
+	ch_edge_t *down;
+} ch_t;
+
+/**
+ * struct ch_adj_s - Growable list of arc ids (preprocessing only)
+ *
+ * @arcs: Arc ids
+ * @size: Number of arc ids
+ * @cap: Capacity of `arcs`
+ */
+typedef struct ch_adj_s
+{
+	unsigned int *arcs;
+	size_t size, cap;
+} ch_adj_t;
+
+/**
+ * struct ch_build_ctx_s - Contraction Hierarchy preprocessing state
+ *
+ * @ch: Hierarchy under construction
+ * @nb_vertices: Number of vertices
+ * @arcs_cap: Capacity of ch->arcs
+ * @out: Outgoing arc ids of each vertex
+ * @in: Incoming arc ids of each vertex
+ * @deleted: Number of contracted neighbours of each vertex
+ * @ws: Workspace for witness searches
+ * @order: Contraction queue keyed on priority
+ */
+typedef struct ch_build_ctx_s
+{
+	ch_t *ch;
+	size_t nb_vertices, arcs_cap;
+	ch_adj_t *out, *in;
+	unsigned int *deleted;
+	sp_workspace_t *ws;
+	sp_heap_t *order;
+} ch_build_ctx_t;
+
+/**
+ * struct ch_query_entry_s - Per-vertex state of a CH query
+ * Index 0 is the forward search, index 1 the backward search
+ *
+ * @dist: Best known distance from start (forward) or to target (backward)
+ * @arc: Arc the distance was reached through, CH_NONE at the roots
+ * @epoch: Query epoch in which the entry was last written
+ */
+typedef struct ch_query_entry_s
+{
+	unsigned long dist[2];
+	unsigned int arc[2];
+	unsigned int epoch;
+} ch_query_entry_t;
+
+/**
+ * struct ch_query_s - Reusable CH query state (one per thread)
+ *
+ * @ch: Hierarchy queried
+ * @epoch: Current epoch, never 0
+ * @entries: Bookkeeping array, by rank
+ * @pq: Forward and backward priority queues
+ * @stack: Arc stack for unpacking shortcuts
+ * @meet: Rank of the vertex both searches reached on the best path
+ * @best: Cost of that path
+ * @stats: Work counters of the last query
+ */
+typedef struct ch_query_s
+{
+	const ch_t *ch;
+	unsigned int epoch;
+	ch_query_entry_t *entries;
+	sp_heap_t *pq[2];
+	unsigned int *stack;
+	unsigned int meet;
+	unsigned long best;
+	sp_stats_t stats;
+} ch_query_t;
+
+/* Distance written for unreachable (source, target) pairs */
+#define SP_UNREACHABLE (~0UL)
+
+/**
+ * struct distance_matrix_ctx_s - Shared state of a distance matrix job
+ *
+ * @graph: Pointer to graph data structure
+ * @sources: Source vertices (rows)
+ * @nb_sources: Number of sources
+ * @nb_targets: Number of targets (columns)
+ * @nb_distinct: Number of distinct target vertices
+ * @first: First column of each vertex as a target, by vertex index
+ *   (SP_HEAP_NONE if it is not one)
+ * @next: Next column holding the same target vertex, by column
+ * @out: Dense nb_sources * nb_targets output, row-major
+ * @next_source: Next row to compute (claimed atomically by threads)
+ * @failed: Set if any search failed
+ */
+typedef struct distance_matrix_ctx_s
+{
+	graph_t *graph;
+	vertex_t const * const *sources;
+	size_t nb_sources, nb_targets, nb_distinct;
+	size_t *first, *next;
+	unsigned long *out;
+	size_t next_source;
+	int failed;
+} distance_matrix_ctx_t;
+
+/**
+ * struct distance_matrix_job_s - One distance matrix thread
+ *
+ * @ctx: Pointer to shared state
+ * @ws: Thread's own query workspace
+ */
+typedef struct distance_matrix_job_s
+{
+	distance_matrix_ctx_t *ctx;
+	sp_workspace_t *ws;
+} distance_matrix_job_t;
+
+/* Step costs of the weighted grid searches, a diagonal costing ~sqrt(2) */
+#define GRID_COST_STRAIGHT 1000UL
+#define GRID_COST_DIAGONAL 1414UL
+
+#define GRID_PASSABLE(grid, x, y) (GRID_IN(grid, x, y) && GRID_OPEN(grid, x, y))
+#define GRID_CELL(grid, x, y) ((size_t)(y) * (size_t)(grid)->cols + (size_t)(x))
+
+/**
+ * enum grid_search_e - grid_shortest_path modes
+ * 8-connected moves never cut a blocked corner: a diagonal step needs both
+ * orthogonal cells it passes between to be open
+ *
+ * @GRID_SEARCH_BFS: Breadth-first search, fewest moves (a diagonal move
+ *   counts as one)
+ * @GRID_SEARCH_JPS: Jump Point Search, A* over jump points only, shortest
+ *   length (a diagonal move counts as GRID_COST_DIAGONAL / GRID_COST_STRAIGHT)
+ */
+typedef enum grid_search_e
+{
+	GRID_SEARCH_BFS = 0,
+	GRID_SEARCH_JPS
+} grid_search_t;
+
+/**
+ * struct grid_entry_s - Per-cell state of a grid search
+ *
+ * @parent: Cell index the cell was reached from (a straight or diagonal
+ *   line away), SP_HEAP_NONE for the start
+ * @g: Cost from the start
+ * @epoch: Query that last wrote the entry
+ */
+typedef struct grid_entry_s
+{
+	size_t parent;
+	unsigned long g;
+	unsigned int epoch;
+} grid_entry_t;
+
+/**
+ * struct grid_workspace_s - Reusable grid search state, the grid
+ * counterpart of sp_workspace_t
+ *
+ * @capacity: Number of cells
+ * @epoch: Current epoch, never 0
+ * @entries: Per-cell state, by GRID_CELL index
+ * @fifo: Breadth-first queue of cell indices
+ * @pq: Indexed priority queue of cell indices, allocated on first use (a
+ *   breadth-first search needs none)
+ * @buckets: Bucket queue of cell indices for terrain searches, allocated
+ *   on first use
+ */
+typedef struct grid_workspace_s
+{
+	size_t capacity;
+	unsigned int epoch;
+	grid_entry_t *entries;
+	size_t *fifo;
+	sp_heap_t *pq, *buckets;
+} grid_workspace_t;
+
+/*
+ * Terrain step costs: entering a cell of cost c takes GRID_TERRAIN_STRAIGHT
+ * * c straight on and GRID_TERRAIN_DIAGONAL * c diagonally (7 / 5 ~ sqrt(2)).
+ * Cell costs fit a byte, so an A* key never grows by more than
+ * GRID_TERRAIN_MAX_STEP between a cell and its successor
+ */
+#define GRID_TERRAIN_STRAIGHT 5UL
+#define GRID_TERRAIN_DIAGONAL 7UL
+#define GRID_TERRAIN_MAX_STEP (2 * 255 * GRID_TERRAIN_DIAGONAL)
+
+/**
+ * enum grid_heuristic_e - A* heuristics over grids
+ *
+ * @GRID_HEURISTIC_OCTILE: Octile distance, exact on open 8-connected
+ *   ground (a lower bound when 4-connected)
+ * @GRID_HEURISTIC_MANHATTAN: Manhattan distance, exact on open 4-connected
+ *   ground (overestimates diagonals, so 4-connected only)
+ * @GRID_HEURISTIC_NONE: No estimate, the search runs as Dijkstra's
+ */
+typedef enum grid_heuristic_e
+{
+	GRID_HEURISTIC_OCTILE = 0,
+	GRID_HEURISTIC_MANHATTAN,
+	GRID_HEURISTIC_NONE
+} grid_heuristic_t;
+
+/**
+ * struct grid_terrain_s - Map of per-cell traversal costs, 0 meaning
+ * blocked
+ * A cell's cost is read from `costs` if set, else through `table` from its
+ * `map` character if set, else 1; a cell closed in `grid` is blocked
+ * whatever its cost. Without a table, '0' costs 1 and '2' to '9' their
+ * digit (so '1' stays a wall, as for backtracking_array)
+ *
+ * @grid: Packed passability, or NULL
+ * @map: Plain char ** grid, or NULL
+ * @costs: Parallel cost array by GRID_CELL index, or NULL
+ * @table: Cost of each character of `map`, or NULL
+ * @min_cost: Lowest cost of an open cell (0 for 1), scaling the heuristic
+ * @rows: Number of rows
+ * @cols: Number of columns
+ */
+typedef struct grid_terrain_s
+{
+	const grid_t *grid;
+	char **map;
+	const unsigned char *costs, *table;
+	unsigned char min_cost;
+	int rows, cols;
+} grid_terrain_t;
+
+/**
+ * struct grid_search_ctx_s - Grid search context data
+ *
+ * @grid: Pointer to grid_t structure
+ * @ws: Workspace, reset for this search
+ * @connectivity: 4 or 8
+ * @start: Start coordinates
+ * @target: Target coordinates
+ * @stats: Work counters
+ * @terrain: Cell costs (terrain searches)
+ * @heuristic: Estimate guiding the search (terrain searches)
+ */
+typedef struct grid_search_ctx_s
+{
+	const grid_t *grid;
+	grid_workspace_t *ws;
+	int connectivity;
+	point_t start, target;
+	sp_stats_t stats;
+	const grid_terrain_t *terrain;
+	grid_heuristic_t heuristic;
+} grid_search_ctx_t;
+
+/* Direction of the target and distance of the cells that cannot reach it */
+#define FLOW_NONE 8
+#define FLOW_UNREACHABLE (~0u)
+
+/**
+ * struct flow_field_s - Cost to a shared target and first step towards it,
+ * for every cell of a terrain
+ * Directions index the neighbour tables used by the grid searches: right,
+ * down, left, up, then the diagonals from down-right clockwise
+ *
+ * @terrain: Terrain the field was computed on (its arrays are the
+ *   caller's)
+ * @connectivity: 4 or 8
+ * @target: Target coordinates
+ * @dist: Cost to the target, by GRID_CELL index (FLOW_UNREACHABLE if none)
+ * @dir: Direction of the next step, by GRID_CELL index (FLOW_NONE at the
+ *   target and where it is unreachable)
+ * @fifo: Cells invalidated by the current update
+ * @pq: Indexed priority queue of cell indices
+ * @stats: Work done by the last computation or update
+ */
+typedef struct flow_field_s
+{
+	grid_terrain_t terrain;
+	int connectivity;
+	point_t target;
+	unsigned int *dist;
+	unsigned char *dir;
+	size_t *fifo;
+	sp_heap_t *pq;
+	sp_stats_t stats;
+} flow_field_t;
+
+/* D* Lite keys: k1 in the high half, k2 breaking ties in the low one */
+#define DSTAR_INFINITY (~0u)
+#define DSTAR_KEY(k1, k2) ((unsigned long)(k1) << 32 | (unsigned long)(k2))
+
+/**
+ * struct dstar_s - D* Lite planner on a terrain
+ * The search runs backwards from the target, so that the agent may move
+ * and cells may change between plans: g and rhs hold costs to the target
+ * and survive across updates, as does the queue of inconsistent cells
+ * (whose queued keys are lower bounds, corrected when they come out)
+ *
+ * @terrain: Terrain planned on (its arrays are the caller's)
+ * @connectivity: 4 or 8
+ * @start: Agent's current coordinates
+ * @last: Agent's coordinates when km was last raised
+ * @target: Target coordinates
+ * @km: Sum of the heuristic distances the agent moved, added to new keys
+ *   instead of rekeying the queue
+ * @g: Cost to the target, by GRID_CELL index (DSTAR_INFINITY if unknown)
+ * @rhs: One-step lookahead cost, by GRID_CELL index
+ * @pq: Indexed priority queue of cell indices
+ * @stats: Work done by the last plan
+ */
+typedef struct dstar_s
+{
+	grid_terrain_t terrain;
+	int connectivity;
+	point_t start, last, target;
+	unsigned long km;
+	unsigned int *g, *rhs;
+	sp_heap_t *pq;
+	sp_stats_t stats;
+} dstar_t;
+
+/* Stale parts of a cluster: its inner edges, its right or lower border */
+#define HPA_DIRTY_CLUSTER 1
+#define HPA_DIRTY_RIGHT 2
+#define HPA_DIRTY_DOWN 4
+/* Entrances at least this wide get a transition at each end */
+#define HPA_ENTRANCE_SPLIT 6
+#define HPA_CLUSTER(hpa, x, y) ((size_t)((y) / (hpa)->size) * \
+	(size_t)(hpa)->cols + (size_t)((x) / (hpa)->size))
+
+/**
+ * struct hpa_cluster_s - Square block of cells in a HPA* abstraction
+ *
+ * @x: X coordinate of the top left cell
+ * @y: Y coordinate of the top left cell
+ * @width: Number of columns (the last clusters may be narrower)
+ * @height: Number of rows
+ * @dirty: HPA_DIRTY_* flags
+ * @perimeter: Abstract vertex of each border cell that ever was a
+ *   transition, by perimeter slot (top row, bottom row, left column, right
+ *   column), NULL if none
+ * @nodes: Abstract vertices currently linked to a neighbouring cluster
+ * @nb_nodes: Number of vertices in `nodes`
+ */
+typedef struct hpa_cluster_s
+{
+	int x, y, width, height;
+	unsigned char dirty;
+	vertex_t **perimeter, **nodes;
+	size_t nb_nodes;
+} hpa_cluster_t;
+
+/**
+ * struct hpa_s - Hierarchical path-finding A* abstraction of a terrain
+ * Vertices of `graph` are transition cells on each side of the cluster
+ * borders, named after their coordinates; edges either cross a border or
+ * join two vertices of a cluster, weighted with the cost of the cheapest
+ * path between them inside it. Edges are linked directly rather than with
+ * graph_add_edge, which looks both ends up by name
+ *
+ * @terrain: Terrain abstracted (its arrays are the caller's)
+ * @connectivity: 4 or 8 (transitions only ever cross borders straight)
+ * @size: Cluster side, in cells
+ * @cols: Number of clusters across
+ * @rows: Number of clusters down
+ * @clusters: Clusters, row by row
+ * @graph: Abstract graph
+ * @start: Vertex standing for the start of the current query
+ * @target: Vertex standing for the target of the current query
+ * @local: Workspace of the searches inside clusters
+ * @ws: Workspace of the searches of `graph`
+ * @path: Abstract path of the last query
+ * @stats: Work done by the last query (cells expanded by the searches
+ *   inside clusters)
+ */
+typedef struct hpa_s
+{
+	grid_terrain_t terrain;
+	int connectivity, size, cols, rows;
+	hpa_cluster_t *clusters;
+	graph_t *graph;
+	vertex_t *start, *target;
+	grid_workspace_t *local;
+	sp_workspace_t *ws;
+	sp_path_t path;
+	sp_stats_t stats;
+} hpa_t;
+
+/* Distance of vertices a landmark cannot reach, or that cannot reach it */
+#define ALT_UNREACHABLE (~0u)
+/* Landmark files: magic string, and size of the header preceding tables */
+#define ALT_FILE_MAGIC "SPALT01"
+#define ALT_FILE_HEADER 64
+
+/**
+ * enum alt_select_e - Landmark selection strategies
+ *
+ * @ALT_FARTHEST: Each landmark is the vertex farthest from those already
+ *   chosen (unreachable ones first, so that every component gets one)
+ * @ALT_AVOID: Each landmark is the leaf of the shortest-path tree of some
+ *   root whose subtree the current landmarks bound worst (Goldberg and
+ *   Werneck's "avoid")
+ */
+typedef enum alt_select_e
+{
+	ALT_FARTHEST = 0,
+	ALT_AVOID
+} alt_select_t;
+
+/**
+ * struct alt_s - Landmark distance tables for ALT lower bounds
+ * By the triangle inequality, d(v, t) >= d(L, t) - d(L, v) and
+ * d(v, t) >= d(v, L) - d(t, L) for every landmark L
+ *
+ * @nb_vertices: Number of vertices of the graph the tables were built on
+ * @nb_landmarks: Number of landmarks
+ * @landmarks: Vertex index of each landmark
+ * @forward: d(L, v) for landmark l at forward[l * nb_vertices + v->index]
+ * @backward: d(v, L), laid out the same way
+ * @mapping: Start of the file mapping if loaded with alt_load, else NULL
+ * @mapping_size: Size of the file mapping
+ */
+typedef struct alt_s
+{
+	size_t nb_vertices, nb_landmarks;
+	unsigned long *landmarks;
+	unsigned int *forward, *backward;
+	void *mapping;
+	size_t mapping_size;
+} alt_t;
+
+/**
+ * struct alt_file_header_s - Header of a landmark file, padded with zeroes
+ * to ALT_FILE_HEADER bytes and followed by the landmarks, then the forward
+ * and backward tables, exactly as in memory
+ *
+ * @magic: ALT_FILE_MAGIC
+ * @nb_vertices: Number of vertices
+ * @nb_landmarks: Number of landmarks
+ */
+typedef struct alt_file_header_s
+{
+	char magic[8];
+	unsigned long nb_vertices, nb_landmarks;
+} alt_file_header_t;
+
+/**
+ * struct alt_build_ctx_s - Landmark preprocessing context data
+ *
+ * @graph: Pointer to graph_t structure
+ * @in: Incoming-edge view of the graph, for backward searches
+ * @alt: Tables being filled
+ * @pq: Indexed priority queue of vertex indices
+ * @order: Vertex indices in the order the last search settled them
+ * @nb_settled: Number of vertices in `order`
+ * @parent: Shortest-path tree parent of each vertex in the last search
+ * @size: Subtree weights of the avoid strategy
+ * @leaf: Heaviest child, then deepest heaviest descendant, of each vertex
+ *   (avoid strategy)
+ */
+typedef struct alt_build_ctx_s
+{
+	graph_t const *graph;
+	sp_in_edges_t *in;
+	alt_t *alt;
+	sp_heap_t *pq;
+	size_t *order, nb_settled, *parent, *leaf;
+	unsigned long *size;
+} alt_build_ctx_t;
+
+/* Edge weights of the typed Dijkstra kernels, computed by the caller */
+typedef unsigned int (*sp_weight_u32_t)(edge_t const *edge, void *data);
+typedef unsigned long (*sp_weight_u64_t)(edge_t const *edge, void *data);
+typedef float (*sp_weight_f32_t)(edge_t const *edge, void *data);
+typedef double (*sp_weight_f64_t)(edge_t const *edge, void *data);
+
+/* Delta-stepping keys: distance in the high half, predecessor in the low */
+#define DELTA_KEY(d, pred) ((unsigned long)(d) << 32 | (unsigned long)(pred))
+#define DELTA_NONE 0xffffffffUL
+/* Frontier entries a thread claims at a time */
+#define DELTA_CHUNK 64
+
+/**
+ * enum delta_phase_e - What the delta-stepping threads do next
+ *
+ * @DELTA_LIGHT: Relax the light edges of the current bucket's frontier
+ * @DELTA_HEAVY: Relax the heavy edges of the vertices it settled
+ * @DELTA_DONE: Every bucket is empty
+ */
+typedef enum delta_phase_e
+{
+	DELTA_LIGHT = 0,
+	DELTA_HEAVY,
+	DELTA_DONE
+} delta_phase_t;
+
+/**
+ * struct delta_bucket_s - Growable list of vertex indices
+ *
+ * @items: Vertex indices (stale ones are skipped when processed)
+ * @size: Number of indices
+ * @capacity: Number of slots in `items`
+ */
+typedef struct delta_bucket_s
+{
+	size_t *items, size, capacity;
+} delta_bucket_t;
+
+/**
+ * struct delta_ctx_s - Shared state of a delta-stepping search
+ *
+ * @vertices: Vertex pointers, by index
+ * @nb_vertices: Number of vertices
+ * @delta: Bucket width; edges at most this heavy are light
+ * @nb_buckets: Number of buckets, reused cyclically (no tentative distance
+ *   is ever more than the heaviest edge past the current bucket)
+ * @key: DELTA_KEY of each vertex's tentative distance and predecessor
+ *   (~0UL while unreached), lowered with compare-and-swap
+ * @done: Distance each vertex was last expanded at (~0u before)
+ * @frontier: Entries of the current bucket, gathered from every thread
+ * @work: Vertices of the current phase (the frontier, or `settled`)
+ * @nb_work: Number of vertices in `work`
+ * @next: Next entry of `work` to claim
+ * @settled: Vertices expanded in the current bucket, whose heavy edges
+ *   are relaxed once it is empty
+ * @nb_settled: Number of vertices in `settled`
+ * @bucket: Index of the current bucket
+ * @phase: Current phase
+ * @jobs: Per-thread state
+ * @nb_jobs: Number of threads taking part
+ * @barrier: Separates phases
+ * @gate: Held while threads start, so none reaches the barrier before it
+ *   is sized
+ * @failed: Set if any allocation failed
+ */
+typedef struct delta_ctx_s
+{
+	const vertex_t **vertices;
+	size_t nb_vertices;
+	unsigned long delta;
+	size_t nb_buckets;
+	unsigned long *key;
+	unsigned int *done;
+	delta_bucket_t frontier;
+	const size_t *work;
+	size_t nb_work, next;
+	size_t *settled, nb_settled;
+	size_t bucket;
+	delta_phase_t phase;
+	struct delta_job_s *jobs;
+	size_t nb_jobs;
+	pthread_barrier_t barrier;
+	pthread_mutex_t gate;
+	int failed;
+} delta_ctx_t;
+
+/**
+ * struct delta_job_s - One delta-stepping thread
+ * Threads only append to their own buckets; the serial step between phases
+ * gathers them
+ *
+ * @ctx: Pointer to shared state
+ * @buckets: Thread's share of each bucket
+ */
+typedef struct delta_job_s
+{
+	delta_ctx_t *ctx;
+	delta_bucket_t *buckets;
+} delta_job_t;
+
+/* Graph files: magic string, and size of the header preceding arrays */
+#define SP_GRAPH_FILE_MAGIC "SPGRAPH"
+#define SP_GRAPH_FILE_HEADER 64
+
+/**
+ * struct sp_graph_file_header_s - Header of a graph file, padded with zeroes
+ * to SP_GRAPH_FILE_HEADER bytes
+ * It is followed by the edge offsets of each vertex (unsigned long[n + 1]),
+ * the edge targets (unsigned long[m]), the coordinates (int[2n], x then y),
+ * the edge weights (int[m]) and the vertex names, each null-terminated, all
+ * by vertex index
+ *
+ * @magic: SP_GRAPH_FILE_MAGIC
+ * @nb_vertices: Number of vertices
+ * @nb_edges: Number of edges
+ * @names_size: Size of the names, terminating null bytes included
+ */
+typedef struct sp_graph_file_header_s
+{
+	char magic[8];
+	unsigned long nb_vertices, nb_edges, names_size;
+} sp_graph_file_header_t;
+
+/* Largest message payload a server or client accepts */
+#define SP_MSG_MAX (1UL << 24)
+/*
+ * A connection with this many requests unanswered, or this many reply bytes
+ * unsent, is not read until it catches up
+ */
+#define SP_CONN_PENDING_MAX 64
+#define SP_CONN_OUT_MAX (1UL << 20)
+/* A client whose queued replies do not drain for this long is dropped */
+#define SP_SEND_TIMEOUT_MS 10000
+/* Latency bucket b counts requests served in [2^b, 2^(b + 1)) microseconds */
+#define SP_LATENCY_BUCKETS 32
+
+/**
+ * enum sp_msg_type_e - Path-query server requests (replies carry the type
+ * of the request they answer)
+ *
+ * @SP_MSG_NONE: Not a request; latencies of unknown types count here
+ * @SP_MSG_PATH: Minimum cost path between two vertices (sp_msg_path_t),
+ *   answered with its cost, its length, then its vertex indices (unsigned
+ *   long each)
+ * @SP_MSG_GRID: Shortest path on the server's grid (sp_msg_grid_t),
+ *   answered with its length (unsigned long), then its cells (point_t each)
+ * @SP_MSG_MATRIX: Distances from sources to targets (sp_msg_matrix_t, then
+ *   the source and target indices, unsigned long each), answered with the
+ *   row-major matrix (unsigned long each, SP_UNREACHABLE if no path)
+ * @SP_MSG_STATS: Server statistics, answered with sp_msg_stats_t
+ * @SP_MSG_TYPES: Number of types
+ */
+typedef enum sp_msg_type_e
+{
+	SP_MSG_NONE = 0,
+	SP_MSG_PATH,
+	SP_MSG_GRID,
+	SP_MSG_MATRIX,
+	SP_MSG_STATS,
+	SP_MSG_TYPES
+} sp_msg_type_t;
+
+/**
+ * enum sp_msg_status_e - Outcome of a request
+ *
+ * @SP_MSG_OK: Served; the payload follows
+ * @SP_MSG_NO_PATH: There is no path (no payload)
+ * @SP_MSG_BAD_REQUEST: Malformed request, or one the server cannot serve
+ * @SP_MSG_FAILED: The server ran out of memory
+ */
+typedef enum sp_msg_status_e
+{
+	SP_MSG_OK = 0,
+	SP_MSG_NO_PATH,
+	SP_MSG_BAD_REQUEST,
+	SP_MSG_FAILED
+} sp_msg_status_t;
+
+/**
+ * struct sp_msg_header_s - Header of every request and reply, in host byte
+ * order (the socket is local)
+ *
+ * @length: Number of payload bytes that follow
+ * @type: sp_msg_type_t
+ * @status: sp_msg_status_t (0 in requests)
+ * @id: Chosen by the client, echoed in the reply: requests may be
+ *   pipelined, and replies come back in the order they are served
+ */
+typedef struct sp_msg_header_s
+{
+	unsigned int length;
+	unsigned short type, status;
+	unsigned long id;
+} sp_msg_header_t;
+
+/**
+ * struct sp_msg_path_s - Payload of a SP_MSG_PATH request
+ *
+ * @source: Index of the source vertex
+ * @target: Index of the target vertex
+ */
+typedef struct sp_msg_path_s
+{
+	unsigned long source, target;
+} sp_msg_path_t;
+
+/**
+ * struct sp_msg_grid_s - Payload of a SP_MSG_GRID request
+ *
+ * @start: Start cell
+ * @target: Target cell
+ * @mode: grid_search_t
+ * @connectivity: 4 or 8
+ */
+typedef struct sp_msg_grid_s
+{
+	point_t start, target;
+	int mode, connectivity;
+} sp_msg_grid_t;
+
+/**
+ * struct sp_msg_matrix_s - Head of a SP_MSG_MATRIX request payload
+ *
+ * @nb_sources: Number of source indices that follow
+ * @nb_targets: Number of target indices after them
+ */
+typedef struct sp_msg_matrix_s
+{
+	unsigned long nb_sources, nb_targets;
+} sp_msg_matrix_t;
+
+/**
+ * struct sp_msg_stats_s - Payload of a SP_MSG_STATS reply
+ *
+ * @nb_vertices: Number of vertices of the graph
+ * @rows: Number of rows of the grid (0 if there is none)
+ * @cols: Number of columns of the grid
+ * @latency: Requests served so far, by type and latency bucket
+ */
+typedef struct sp_msg_stats_s
+{
+	unsigned long nb_vertices;
+	int rows, cols;
+	unsigned long latency[SP_MSG_TYPES][SP_LATENCY_BUCKETS];
+} sp_msg_stats_t;
+
+/**
+ * struct sp_conn_s - Client connection of a path-query server
+ * Workers never write to the socket: they queue replies in `out`, which
+ * the reader sends as the socket drains. Freed once the reader and every
+ * queued request have let go of it
+ *
+ * @fd: Socket
+ * @refs: Reader reference, plus one per request not answered yet
+ * @lock: Protects `out`, `pending`, `since` and `closing`
+ * @buf: Bytes read but not yet parsed into requests
+ * @size: Number of bytes in `buf`
+ * @capacity: Size of `buf`
+ * @out: Replies queued for sending
+ * @out_sent: Bytes of `out` already sent
+ * @out_size: Number of bytes in `out`
+ * @out_capacity: Size of `out`
+ * @pending: Requests read but not answered yet
+ * @since: sp_clock_ns when `out` last started filling or drained a bit
+ * @closing: Set once replies can no longer be sent; later ones are dropped
+ * @eof: Set once the client shut its end down (reader only)
+ */
+typedef struct sp_conn_s
+{
+	int fd;
+	size_t refs;
+	pthread_mutex_t lock;
+	unsigned char *buf;
+	size_t size, capacity;
+	unsigned char *out;
+	size_t out_sent, out_size, out_capacity, pending;
+	unsigned long since;
+	int closing, eof;
+} sp_conn_t;
+
+/**
+ * struct sp_job_s - Request queued for the workers
+ *
+ * @conn: Connection to reply on
+ * @header: Request header
+ * @payload: Request payload (header.length bytes)
+ * @queued: sp_clock_ns when the request was read
+ * @next: Next request in the queue
+ */
+typedef struct sp_job_s
+{
+	sp_conn_t *conn;
+	sp_msg_header_t header;
+	unsigned char *payload;
+	unsigned long queued;
+	struct sp_job_s *next;
+} sp_job_t;
+
+/**
+ * struct sp_worker_s - Path-query server thread and its query state
+ *
+ * @server: Pointer to the server
+ * @tid: Thread
+ * @ws: Graph query workspace
+ * @grid_ws: Grid query workspace, NULL without a grid
+ * @path: Path buffer, reused from query to query
+ * @out: Reply buffer, reused from query to query
+ * @out_capacity: Size of `out`
+ * @latency: Requests served, by type and latency bucket
+ */
+typedef struct sp_worker_s
+{
+	struct sp_server_s *server;
+	pthread_t tid;
+	sp_workspace_t *ws;
+	grid_workspace_t *grid_ws;
+	sp_path_t path;
+	unsigned char *out;
+	size_t out_capacity;
+	unsigned long latency[SP_MSG_TYPES][SP_LATENCY_BUCKETS];
+} sp_worker_t;
+
+/**
+ * struct sp_server_s - Path-query server over a Unix domain socket
+ * One thread reads every connection, queues whole requests and sends the
+ * replies; a fixed pool of workers serves them, each with its own
+ * workspaces
+ *
+ * @graph: Graph served (owned by the caller, only read)
+ * @vertices: Vertex pointers, by index
+ * @grid: Grid served, or NULL (owned by the caller)
+ * @listen_fd: Listening socket
+ * @wake: Non-blocking pipe waking the reader up when a reply is queued or
+ *   the server is stopped
+ * @socket_path: Path the socket is bound to
+ * @lock: Protects the queue
+ * @ready: Signalled when a request is queued or the server stops
+ * @head: Oldest queued request
+ * @tail: Newest queued request
+ * @stopping: Set once sp_server_stop was called
+ * @draining: Set by sp_server_delete; workers return once the queue is empty
+ * @workers: Worker threads
+ * @nb_workers: Number of workers started
+ * @conns: Open connections
+ * @nb_conns: Number of open connections
+ * @conns_capacity: Number of slots in `conns`
+ */
+typedef struct sp_server_s
+{
+	graph_t *graph;
+	const vertex_t **vertices;
+	grid_t const *grid;
+	int listen_fd, wake[2];
+	char socket_path[108];
+	pthread_mutex_t lock;
+	pthread_cond_t ready;
+	sp_job_t *head, *tail;
+	int stopping, draining;
+	sp_worker_t *workers;
+	size_t nb_workers;
+	sp_conn_t **conns;
+	size_t nb_conns, conns_capacity;
+} sp_server_t;
+
+/**
+ * struct sp_client_s - Connection to a path-query server
+ *
+ * @fd: Socket
+ * @next_id: Id of the next request
+ */
+typedef struct sp_client_s
+{
+	int fd;
+	unsigned long next_id;
+} sp_client_t;
+
+/**
+ * struct sp_loadgen_s - Load generator settings and results
+ * Each connection keeps `depth` random requests in flight until it has
+ * sent `nb_requests`
+ *
+ * @socket_path: Path of the server's socket
+ * @type: SP_MSG_PATH, SP_MSG_GRID or SP_MSG_MATRIX
+ * @nb_connections: Number of connections, one thread each
+ * @nb_requests: Requests per connection
+ * @depth: Requests in flight per connection
+ * @matrix_size: Sources and targets per SP_MSG_MATRIX request
+ * @seed: Random seed
+ * @latency: Round-trip latencies, by latency bucket
+ * @nb_errors: Requests that failed or got a malformed reply
+ * @elapsed: Wall-clock duration of the run, in nanoseconds
+ */
+typedef struct sp_loadgen_s
+{
+	char const *socket_path;
+	sp_msg_type_t type;
+	size_t nb_connections, nb_requests, depth, matrix_size;
+	unsigned long seed;
+	unsigned long latency[SP_LATENCY_BUCKETS];
+	size_t nb_errors;
+	unsigned long elapsed;
+} sp_loadgen_t;
+
+/**
+ * struct sp_loadgen_conn_s - Load generator connection, run by one thread
+ * @loadgen: Settings; the thread adds its results
+ * @bounds: Graph and grid sizes, from the server's statistics
+ * @tid: Thread
+ * @rng: Random state
+ * @sent: sp_clock_ns when each request was sent, by id
+ * @payload: Request buffer
+ */
+typedef struct sp_loadgen_conn_s
+{
+	sp_loadgen_t *loadgen;
+	sp_msg_stats_t const *bounds;
+	pthread_t tid;
+	unsigned long rng;
+	unsigned long *sent;
+	unsigned long *payload;
+} sp_loadgen_conn_t;
 
 /* TASK 0 */
 queue_t *backtracking_array(char **map, int rows, int cols,
@@ -96,4 +1582,264 @@ queue_t *backtracking_graph(graph_t *graph, vertex_t const *start,
 queue_t *dijkstra_graph(graph_t *graph, vertex_t const *start,
 	vertex_t const *target);
 
+/* TASK 2 (heap selection) */
+queue_t *dijkstra_graph_heap(graph_t *graph, vertex_t const *start,
+	vertex_t const *target, sp_heap_kind_t kind);
+
+/* QUERY WORKSPACES */
+sp_workspace_t *sp_workspace_create(size_t capacity, sp_heap_kind_t kind);
+sp_workspace_t *sp_workspace_create_for(graph_t const *graph,
+	sp_heap_kind_t kind);
+void sp_workspace_delete(sp_workspace_t *ws);
+void sp_workspace_reset(sp_workspace_t *ws);
+queue_t *dijkstra_graph_workspace(sp_workspace_t *ws, graph_t *graph,
+	vertex_t const *start, vertex_t const *target);
+sp_visited_t *sp_visited_create(size_t capacity);
+void sp_visited_delete(sp_visited_t *visited);
+void sp_visited_reset(sp_visited_t *visited);
+queue_t *backtracking_graph_workspace(sp_visited_t *visited, graph_t *graph,
+	vertex_t const *start, vertex_t const *target);
+
+/* PATH ARRAYS */
+int dijkstra_graph_path(sp_workspace_t *ws, graph_t *graph,
+	vertex_t const *start, vertex_t const *target, sp_path_t *path);
+int backtracking_graph_path(sp_visited_t *visited, graph_t *graph,
+	vertex_t const *start, vertex_t const *target, sp_path_t *path,
+	size_t max_steps);
+int sp_path_reserve(sp_path_t *path, size_t length);
+int sp_path_push(sp_path_t *path, const vertex_t *vertex);
+void sp_path_reverse(sp_path_t *path);
+void sp_path_release(sp_path_t *path);
+queue_t *sp_path_to_queue(sp_path_t const *path);
+queue_t *backtracking_array_workspace(sp_visited_t *visited, char **map,
+	int rows, int cols, point_t const *start, point_t const *target,
+	size_t max_steps);
+
+/* PACKED GRIDS */
+grid_t *grid_create(int rows, int cols);
+grid_t *grid_from_array(char **map, int rows, int cols);
+void grid_delete(grid_t *grid);
+int grid_set(grid_t *grid, int x, int y, int open);
+grid_t *grid_load(char const *path);
+int grid_save(grid_t const *grid, char const *path);
+queue_t *backtracking_grid(grid_t const *grid, point_t const *start,
+	point_t const *target);
+queue_t *backtracking_grid_workspace(grid_t *seen, grid_t const *grid,
+	point_t const *start, point_t const *target, size_t max_steps);
+queue_t *array_backtrack_run(array_backtrack_ctx_t *ctx,
+	point_t const *start);
+
+/* GRID SHORTEST PATHS */
+grid_workspace_t *grid_workspace_create(size_t capacity);
+void grid_workspace_delete(grid_workspace_t *ws);
+void grid_workspace_reset(grid_workspace_t *ws);
+grid_entry_t *grid_workspace_entry(grid_workspace_t *ws, size_t cell);
+queue_t *grid_shortest_path(grid_t const *grid, point_t const *start,
+	point_t const *target, grid_search_t mode, int connectivity,
+	sp_stats_t *stats);
+queue_t *grid_shortest_path_workspace(grid_workspace_t *ws,
+	grid_t const *grid, point_t const *start, point_t const *target,
+	grid_search_t mode, int connectivity, sp_stats_t *stats);
+int grid_jps(grid_search_ctx_t *ctx);
+queue_t *grid_path_queue(grid_workspace_t *ws, int cols, size_t target);
+
+/* TERRAIN A* */
+queue_t *grid_astar(grid_terrain_t const *terrain, point_t const *start,
+	point_t const *target, int connectivity, grid_heuristic_t heuristic,
+	sp_stats_t *stats);
+queue_t *grid_astar_workspace(grid_workspace_t *ws,
+	grid_terrain_t const *terrain, point_t const *start,
+	point_t const *target, int connectivity, grid_heuristic_t heuristic,
+	sp_stats_t *stats);
+unsigned long grid_terrain_cost(grid_terrain_t const *terrain, int x, int y);
+
+/* FLOW FIELDS */
+flow_field_t *flow_field_create(grid_terrain_t const *terrain,
+	point_t const *target, int connectivity);
+void flow_field_delete(flow_field_t *field);
+int flow_field_next(flow_field_t const *field, point_t *pos);
+int flow_field_update(flow_field_t *field, point_t const *changed,
+	size_t nb_changed);
+int flow_field_run(flow_field_t *field);
+
+/* D* LITE */
+dstar_t *dstar_create(grid_terrain_t const *terrain, point_t const *start,
+	point_t const *target, int connectivity);
+void dstar_delete(dstar_t *dstar);
+queue_t *dstar_update(dstar_t *dstar, point_t const *start,
+	point_t const *changed, size_t nb_changed);
+int dstar_compute(dstar_t *dstar);
+void dstar_vertex(dstar_t *dstar, int x, int y);
+unsigned long dstar_step(dstar_t const *dstar, int x, int y, int dir);
+unsigned long dstar_estimate(dstar_t const *dstar, int x, int y);
+
+/* HIERARCHICAL A* */
+hpa_t *hpa_create(grid_terrain_t const *terrain, int size, int connectivity);
+void hpa_delete(hpa_t *hpa);
+int hpa_update(hpa_t *hpa, point_t const *changed, size_t nb_changed);
+queue_t *hpa_path(hpa_t *hpa, point_t const *start, point_t const *target);
+int hpa_rebuild(hpa_t *hpa);
+int hpa_local(hpa_t *hpa, hpa_cluster_t const *cluster,
+	point_t const *from, point_t const *to, int reverse);
+edge_t *hpa_link(vertex_t *src, vertex_t *dest, unsigned long weight);
+
+/* TRACING */
+sp_trace_sink_t *sp_trace_sink_create(size_t capacity, sp_trace_fn_t flush,
+	void *data);
+void sp_trace_sink_delete(sp_trace_sink_t *sink);
+sp_trace_sink_t *sp_trace_attach(sp_trace_sink_t *sink);
+void sp_trace_emit(sp_trace_sink_t *sink, sp_trace_kind_t kind,
+	sp_trace_search_t search, const vertex_t *vertex,
+	const vertex_t *source, int x, int y, unsigned long value);
+void sp_trace_flush(sp_trace_sink_t *sink);
+void sp_trace_print(const sp_trace_event_t *events, size_t count,
+	void *data);
+
+/* INDEXED PRIORITY QUEUES */
+sp_heap_t *sp_heap_create(sp_heap_kind_t kind, size_t capacity);
+void sp_heap_delete(sp_heap_t *heap);
+void sp_heap_clear(sp_heap_t *heap);
+int sp_heap_push(sp_heap_t *heap, size_t id, unsigned long key);
+size_t sp_heap_pop(sp_heap_t *heap, unsigned long *key);
+size_t sp_heap_peek(sp_heap_t *heap, unsigned long *key);
+void sp_dary_sift_up(sp_heap_t *heap, size_t i);
+size_t sp_dary_pop(sp_heap_t *heap);
+void sp_pairing_push(sp_heap_t *heap, size_t id, int queued);
+size_t sp_pairing_pop(sp_heap_t *heap);
+void sp_pairing_clear(sp_heap_t *heap);
+sp_heap_t *sp_bucket_create(size_t capacity, size_t max_step);
+int sp_bucket_push(sp_heap_t *heap, size_t id, unsigned long key, int queued);
+size_t sp_bucket_pop(sp_heap_t *heap);
+size_t sp_bucket_first(sp_heap_t *heap);
+sp_heap_t *sp_heap_create_for(graph_t const *graph, sp_heap_kind_t kind);
+
+/* BIDIRECTIONAL DIJKSTRA */
+queue_t *dijkstra_bidirectional_graph(graph_t *graph, vertex_t const *start,
+	vertex_t const *target);
+queue_t *dijkstra_bidirectional_in(sp_in_edges_t const *in,
+	vertex_t const *start, vertex_t const *target, sp_stats_t *stats);
+dijkstra_bidi_ctx_t *dijkstra_bidi_ctx_create(sp_in_edges_t const *in,
+	const vertex_t *start, const vertex_t *target);
+void dijkstra_bidi_ctx_delete(dijkstra_bidi_ctx_t *ctx);
+sp_in_edges_t *sp_in_edges_create(graph_t const *graph);
+void sp_in_edges_delete(sp_in_edges_t *in);
+
+/* DISTANCE MATRIX */
+int distance_matrix(graph_t *graph, vertex_t const * const *sources,
+	size_t n, vertex_t const * const *targets, size_t m,
+	unsigned long *out);
+int distance_matrix_threads(graph_t *graph, vertex_t const * const *sources,
+	size_t n, vertex_t const * const *targets, size_t m, unsigned long *out,
+	size_t nb_threads);
+
+/* CONTRACTION HIERARCHIES */
+ch_t *ch_create(graph_t const *graph);
+void ch_delete(ch_t *ch);
+long ch_contract(ch_build_ctx_t *ctx, unsigned int v, int apply);
+unsigned int ch_arc_add(ch_build_ctx_t *ctx, unsigned int tail,
+	unsigned int head, unsigned long weight, const unsigned int *child);
+int ch_csr_build(ch_t *ch);
+ch_query_t *ch_query_create(ch_t const *ch);
+void ch_query_delete(ch_query_t *query);
+int ch_query_distance(ch_query_t *query, vertex_t const *start,
+	vertex_t const *target, unsigned long *dist);
+queue_t *ch_query_path(ch_query_t *query, vertex_t const *start,
+	vertex_t const *target);
+queue_t *ch_graph(ch_t const *ch, vertex_t const *start,
+	vertex_t const *target);
+
+/* LANDMARKS (ALT) */
+alt_t *alt_create(graph_t const *graph, size_t nb_landmarks,
+	alt_select_t select);
+void alt_delete(alt_t *alt);
+unsigned long alt_bound(alt_t const *alt, size_t v, size_t target);
+int alt_sssp(alt_build_ctx_t *ctx, size_t source, int backward,
+	unsigned int *dist);
+alt_t *alt_load(char const *path);
+int alt_save(alt_t const *alt, char const *path);
+int dijkstra_graph_alt(sp_workspace_t *ws, graph_t *graph, alt_t const *alt,
+	vertex_t const *start, vertex_t const *target, sp_path_t *path);
+
+/* TYPED DIJKSTRA KERNELS */
+queue_t *dijkstra_graph_u32(graph_t *graph, vertex_t const *start,
+	vertex_t const *target);
+int dijkstra_graph_u32_weighted(graph_t const *graph, vertex_t const *start,
+	vertex_t const *target, sp_weight_u32_t weight, void *data,
+	sp_path_t *path, unsigned int *cost);
+queue_t *dijkstra_graph_u64(graph_t *graph, vertex_t const *start,
+	vertex_t const *target);
+int dijkstra_graph_u64_weighted(graph_t const *graph, vertex_t const *start,
+	vertex_t const *target, sp_weight_u64_t weight, void *data,
+	sp_path_t *path, unsigned long *cost);
+queue_t *dijkstra_graph_f32(graph_t *graph, vertex_t const *start,
+	vertex_t const *target);
+int dijkstra_graph_f32_weighted(graph_t const *graph, vertex_t const *start,
+	vertex_t const *target, sp_weight_f32_t weight, void *data,
+	sp_path_t *path, float *cost);
+queue_t *dijkstra_graph_f64(graph_t *graph, vertex_t const *start,
+	vertex_t const *target);
+int dijkstra_graph_f64_weighted(graph_t const *graph, vertex_t const *start,
+	vertex_t const *target, sp_weight_f64_t weight, void *data,
+	sp_path_t *path, double *cost);
+
+/* DELTA-STEPPING */
+int delta_stepping(graph_t const *graph, vertex_t const *source,
+	unsigned long delta, size_t nb_threads, unsigned long *dist,
+	size_t *pred);
+void delta_relax(delta_job_t *job, size_t v);
+void delta_next(delta_ctx_t *ctx);
+
+/* GRAPH FILES */
+int sp_graph_save(graph_t const *graph, char const *path);
+graph_t *sp_graph_load(char const *path);
+
+/* PATH-QUERY SERVER */
+sp_server_t *sp_server_create(graph_t *graph, grid_t const *grid,
+	char const *socket_path, size_t nb_workers);
+void sp_server_delete(sp_server_t *server);
+void sp_server_stop(sp_server_t *server);
+int sp_server_run(sp_server_t *server);
+void *sp_server_worker(void *arg);
+int sp_server_reply(sp_server_t *server, sp_conn_t *conn,
+	void const *reply, size_t length);
+int sp_conn_read(sp_conn_t *conn);
+int sp_conn_parse(sp_server_t *server, sp_conn_t *conn);
+int sp_conn_flush(sp_conn_t *conn);
+void sp_conn_release(sp_conn_t *conn);
+void *sp_worker_reserve(sp_worker_t *worker, size_t length);
+int sp_io_write(int fd, void const *buf, size_t length);
+int sp_io_read(int fd, void *buf, size_t length);
+
+/* PATH-QUERY CLIENT */
+sp_client_t *sp_client_connect(char const *socket_path);
+void sp_client_close(sp_client_t *client);
+unsigned long sp_client_send(sp_client_t *client, sp_msg_type_t type,
+	void const *payload, size_t length);
+int sp_client_recv(sp_client_t *client, sp_msg_header_t *header,
+	void **payload);
+int sp_client_path(sp_client_t *client, unsigned long source,
+	unsigned long target, unsigned long *cost, unsigned long **vertices,
+	size_t *length);
+
+/* LATENCY HISTOGRAMS */
+unsigned long sp_clock_ns(void);
+void sp_latency_record(unsigned long *latency, unsigned long ns);
+unsigned long sp_latency_percentile(unsigned long const *latency,
+	double fraction);
+int sp_loadgen_run(sp_loadgen_t *loadgen);
+
+/* A* SEARCH */
+queue_t *astar_graph(graph_t *graph, vertex_t const *start,
+	vertex_t const *target, astar_heuristic_t heuristic, sp_stats_t *stats);
+unsigned int astar_euclidean(const vertex_t *v, const vertex_t *target);
+unsigned int astar_manhattan(const vertex_t *v, const vertex_t *target);
+
+/* MINIMUM SPANNING FOREST */
+msf_t *msf_kruskal(graph_t const *graph);
+msf_t *msf_boruvka(graph_t const *graph, size_t nb_threads);
+void msf_delete(msf_t *msf);
+msf_edge_t *msf_collect_edges(graph_t const *graph, size_t *nb_edges);
+size_t msf_find(size_t *parent, size_t v);
+msf_t *msf_create(size_t nb_vertices);
+
 #endif /* SYSTEMALGORITHMS_PATHFINDING_H */
@@ -0,0 +1,172 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+#define NODE(heap, id) ((heap)->nodes[id])
+
+/* STATIC FUNCTIONS */
+
+static void bucket_unlink(sp_heap_t *heap, size_t id);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_bucket_create - Allocates a Dial bucket queue
+ * Keys must be pushed in monotone order: never below the last key popped,
+ * and never `max_step` or more above it
+ *
+ * @capacity: Number of distinct ids (ids range over [0, capacity))
+ * @max_step: Largest key increase per relaxation (max edge weight)
+ *
+ * Return: Pointer to sp_heap_t structure of kind SP_HEAP_BUCKET, NULL on
+ *   failure
+ */
+sp_heap_t *sp_bucket_create(size_t capacity, size_t max_step)
+{
+	sp_heap_t *heap = NULL;
+	size_t nb_buckets = max_step + 1, i;
+
+	heap = calloc(1, sizeof(sp_heap_t) + capacity * (sizeof(unsigned long) +
+		sizeof(size_t) + sizeof(sp_pairing_node_t)) +
+		nb_buckets * sizeof(size_t));
+
+	if (!heap)
+		return (NULL);
+
+	heap->kind = SP_HEAP_BUCKET;
+	heap->capacity = capacity;
+	heap->key = (unsigned long *)(heap + 1);
+	heap->nodes = (sp_pairing_node_t *)(heap->key + capacity);
+	heap->pos = (size_t *)(heap->nodes + capacity);
+	heap->buckets = heap->pos + capacity;
+	heap->nb_buckets = nb_buckets;
+	heap->root = SP_HEAP_NONE;
+
+	for (i = 0; i < capacity; ++i)
+		heap->pos[i] = SP_HEAP_NONE;
+
+	for (i = 0; i < nb_buckets; ++i)
+		heap->buckets[i] = SP_HEAP_NONE;
+
+	return (heap);
+}
+
+/**
+ * sp_bucket_push - Files an id under its key's bucket
+ * Called by sp_heap_push once the id is known to be new or improved
+ *
+ * @heap: Pointer to sp_heap_t structure (bucket kind)
+ * @id: Id in [0, capacity)
+ * @key: Priority
+ * @queued: Non-0 if `id` is already queued (decrease-key)
+ *
+ * Return: 1 on success, 0 if `key` breaks monotonicity
+ */
+int sp_bucket_push(sp_heap_t *heap, size_t id, unsigned long key, int queued)
+{
+	size_t b;
+
+	/* An empty queue keeps its window unless `key` falls outside it */
+	if (!heap->size && (key < heap->cursor_key ||
+		key - heap->cursor_key >= heap->nb_buckets))
+	{
+		heap->cursor_key = key;
+		heap->cursor = key % heap->nb_buckets;
+	}
+
+	if (key < heap->cursor_key ||
+		key - heap->cursor_key >= heap->nb_buckets)
+		return (0);
+
+	if (queued)
+		bucket_unlink(heap, id);
+	else
+		++heap->size;
+
+	b = key % heap->nb_buckets;
+	heap->key[id] = key;
+	heap->pos[id] = b;
+	NODE(heap, id).prev = SP_HEAP_NONE;
+	NODE(heap, id).sibling = heap->buckets[b];
+
+	if (heap->buckets[b] != SP_HEAP_NONE)
+		NODE(heap, heap->buckets[b]).prev = id;
+
+	heap->buckets[b] = id;
+	return (1);
+}
+
+/**
+ * sp_bucket_pop - Removes an id from the lowest non-empty bucket
+ * The caller updates `size` and the id's position mark
+ *
+ * @heap: Pointer to sp_heap_t structure (bucket kind, not empty)
+ *
+ * Return: Extracted id
+ */
+size_t sp_bucket_pop(sp_heap_t *heap)
+{
+	size_t id = sp_bucket_first(heap);
+
+	bucket_unlink(heap, id);
+	return (id);
+}
+
+/**
+ * sp_heap_create_for - Allocates the priority queue best suited to a graph
+ *
+ * @graph: Pointer to graph_t structure the search will run on
+ * @kind: Requested kind; SP_HEAP_AUTO picks buckets when every weight is in
+ *   [0, SP_BUCKET_MAX_WEIGHT], SP_HEAP_DEFAULT otherwise
+ *
+ * Return: Pointer to sp_heap_t structure, NULL on failure
+ */
+sp_heap_t *sp_heap_create_for(graph_t const *graph, sp_heap_kind_t kind)
+{
+	const vertex_t *v = NULL;
+	const edge_t *e = NULL;
+	int max_weight = 0;
+
+	if (kind != SP_HEAP_AUTO)
+		return (sp_heap_create(kind, graph->nb_vertices));
+
+	for (v = graph->vertices; v && max_weight >= 0; v = v->next)
+	{
+		for (e = v->edges; e; e = e->next)
+		{
+			if (e->weight < 0 || e->weight > SP_BUCKET_MAX_WEIGHT)
+			{
+				max_weight = -1;
+				break;
+			}
+
+			if (e->weight > max_weight)
+				max_weight = e->weight;
+		}
+	}
+
+	if (max_weight < 0)
+		return (sp_heap_create(SP_HEAP_DEFAULT, graph->nb_vertices));
+
+	return (sp_bucket_create(graph->nb_vertices, (size_t)max_weight));
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * bucket_unlink - Removes an id from its bucket's list
+ *
+ * @heap: Pointer to sp_heap_t structure (bucket kind)
+ * @id: Queued id
+ */
+static void bucket_unlink(sp_heap_t *heap, size_t id)
+{
+	size_t prev = NODE(heap, id).prev, next = NODE(heap, id).sibling;
+
+	if (prev == SP_HEAP_NONE)
+		heap->buckets[heap->pos[id]] = next;
+	else
+		NODE(heap, prev).sibling = next;
+
+	if (next != SP_HEAP_NONE)
+		NODE(heap, next).prev = prev;
+}
@@ -0,0 +1,181 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_client_connect - Connects to a path-query server
+ *
+ * @socket_path: Path of the server's socket
+ *
+ * Return: Pointer to sp_client_t structure, NULL on failure
+ */
+sp_client_t *sp_client_connect(char const *socket_path)
+{
+	struct sockaddr_un addr;
+	sp_client_t *client = NULL;
+
+	if (!socket_path || strlen(socket_path) >= sizeof(addr.sun_path))
+		return (NULL);
+
+	client = calloc(1, sizeof(sp_client_t));
+
+	if (!client)
+		return (NULL);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socket_path);
+	client->next_id = 1;
+	client->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (client->fd == -1 ||
+		connect(client->fd, (struct sockaddr *)&addr, sizeof(addr)))
+	{
+		sp_client_close(client);
+		return (NULL);
+	}
+
+	return (client);
+}
+
+/**
+ * sp_client_close - Disconnects from a path-query server
+ *
+ * @client: Pointer to sp_client_t structure
+ */
+void sp_client_close(sp_client_t *client)
+{
+	if (!client)
+		return;
+
+	if (client->fd != -1)
+		close(client->fd);
+
+	free(client);
+}
+
+/**
+ * sp_client_send - Sends a request, without waiting for its reply
+ *
+ * @client: Pointer to sp_client_t structure
+ * @type: Request type
+ * @payload: Request payload (see sp_msg_type_t)
+ * @length: Number of payload bytes
+ *
+ * Return: Id of the request, to match its reply with, 0 on failure
+ */
+unsigned long sp_client_send(sp_client_t *client, sp_msg_type_t type,
+	void const *payload, size_t length)
+{
+	sp_msg_header_t header;
+
+	if (!client || length > SP_MSG_MAX || (length && !payload))
+		return (0);
+
+	memset(&header, 0, sizeof(header));
+	header.length = (unsigned int)length;
+	header.type = (unsigned short)type;
+	header.id = client->next_id;
+
+	if (!sp_io_write(client->fd, &header, sizeof(header)) ||
+		(length && !sp_io_write(client->fd, payload, length)))
+		return (0);
+
+	return (client->next_id++);
+}
+
+/**
+ * sp_client_recv - Waits for the next reply
+ * Replies come in the order requests are served, not sent
+ *
+ * @client: Pointer to sp_client_t structure
+ * @header: Set to the reply header
+ * @payload: Set to the reply payload, to free (NULL if empty)
+ *
+ * Return: 1 on success, 0 on failure or if the server disconnected
+ */
+int sp_client_recv(sp_client_t *client, sp_msg_header_t *header,
+	void **payload)
+{
+	if (!client || !header || !payload)
+		return (0);
+
+	*payload = NULL;
+
+	if (!sp_io_read(client->fd, header, sizeof(*header)) ||
+		header->length > SP_MSG_MAX)
+		return (0);
+
+	if (!header->length)
+		return (1);
+
+	*payload = malloc(header->length);
+
+	if (*payload && sp_io_read(client->fd, *payload, header->length))
+		return (1);
+
+	free(*payload);
+	*payload = NULL;
+	return (0);
+}
+
+/**
+ * sp_client_path - Asks for a minimum cost path and waits for it
+ * No other request may be in flight on the connection
+ *
+ * @client: Pointer to sp_client_t structure
+ * @source: Index of the source vertex
+ * @target: Index of the target vertex
+ * @cost: Set to the cost of the path (may be NULL)
+ * @vertices: Set to its vertex indices, to free (may be NULL)
+ * @length: Set to its number of vertices (may be NULL)
+ *
+ * Return: 1 if there is a path, 0 if not, -1 on failure
+ */
+int sp_client_path(sp_client_t *client, unsigned long source,
+	unsigned long target, unsigned long *cost, unsigned long **vertices,
+	size_t *length)
+{
+	sp_msg_path_t req;
+	sp_msg_header_t header;
+	unsigned long *reply = NULL, id;
+
+	req.source = source;
+	req.target = target;
+	id = sp_client_send(client, SP_MSG_PATH, &req, sizeof(req));
+
+	if (!id || !sp_client_recv(client, &header, (void **)&reply))
+		return (-1);
+
+	if (header.id != id || header.type != SP_MSG_PATH ||
+		(header.status == SP_MSG_OK &&
+		(header.length < 2 * sizeof(unsigned long) ||
+		header.length % sizeof(unsigned long) ||
+		reply[1] != header.length / sizeof(unsigned long) - 2)))
+		header.status = SP_MSG_FAILED;
+
+	if (header.status == SP_MSG_OK)
+	{
+		if (cost)
+			*cost = reply[0];
+		if (length)
+			*length = reply[1];
+		if (vertices)
+		{
+			/* The indices follow the cost and length */
+			memmove(reply, reply + 2,
+				reply[1] * sizeof(unsigned long));
+			*vertices = reply;
+			reply = NULL;
+		}
+	}
+
+	free(reply);
+	return (header.status == SP_MSG_OK ? 1 :
+		header.status == SP_MSG_NO_PATH ? 0 : -1);
+}
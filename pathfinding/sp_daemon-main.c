@@ -0,0 +1,98 @@
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+static sp_server_t *server;
+
+/**
+ * on_signal - Stops the server on SIGINT or SIGTERM
+ *
+ * @signum: Signal number
+ */
+static void on_signal(int signum)
+{
+	(void)signum;
+	sp_server_stop(server);
+}
+
+/**
+ * print_latency - Prints the latency percentiles of each request type
+ */
+static void print_latency(void)
+{
+	static char const * const names[SP_MSG_TYPES] = {
+		"invalid", "path", "grid", "matrix", "stats"
+	};
+	unsigned long latency[SP_LATENCY_BUCKETS], total;
+	size_t t, b, w;
+
+	for (t = 0; t < SP_MSG_TYPES; ++t)
+	{
+		memset(latency, 0, sizeof(latency));
+		for (w = 0, total = 0; w < server->nb_workers; ++w)
+			for (b = 0; b < SP_LATENCY_BUCKETS; ++b)
+				latency[b] += __atomic_load_n(
+					&server->workers[w].latency[t][b],
+					__ATOMIC_RELAXED);
+		for (b = 0; b < SP_LATENCY_BUCKETS; ++b)
+			total += latency[b];
+		if (!total)
+			continue;
+		printf("%-8s %10lu requests  p50 < %lu us  p99 < %lu us  "
+			"p99.9 < %lu us\n", names[t], total,
+			sp_latency_percentile(latency, 0.5),
+			sp_latency_percentile(latency, 0.99),
+			sp_latency_percentile(latency, 0.999));
+	}
+}
+
+/**
+ * main - Serves path queries on a graph file, and optionally a grid file,
+ * until interrupted
+ *
+ * @ac: Arguments counter
+ * @av: Arguments vector
+ *
+ * Return: EXIT_SUCCESS, or EXIT_FAILURE on error
+ */
+int main(int ac, char **av)
+{
+	graph_t *graph = NULL;
+	grid_t *grid = NULL;
+	struct sigaction sa;
+	int ok;
+
+	if (ac < 3 || ac > 5)
+	{
+		fprintf(stderr, "Usage: %s graph_file socket [workers] "
+			"[grid_file]\n", av[0]);
+		return (EXIT_FAILURE);
+	}
+
+	graph = sp_graph_load(av[1]);
+	grid = ac > 4 ? grid_load(av[4]) : NULL;
+	server = graph && (ac < 5 || grid) ? sp_server_create(graph, grid,
+		av[2], ac > 3 ? strtoul(av[3], NULL, 10) : 4) : NULL;
+
+	if (!server)
+	{
+		fprintf(stderr, "Cannot serve %s on %s\n", av[1], av[2]);
+		grid_delete(grid);
+		if (graph)
+			graph_delete(graph);
+		return (EXIT_FAILURE);
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = on_signal;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+	ok = sp_server_run(server);
+	print_latency();
+	sp_server_delete(server);
+	grid_delete(grid);
+	graph_delete(graph);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
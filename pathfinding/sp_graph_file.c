@@ -0,0 +1,252 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int sp_graph_file_check(sp_graph_file_header_t const *header,
+	size_t size);
+static graph_t *sp_graph_build(sp_graph_file_header_t const *header);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_graph_save - Writes a graph to a file sp_graph_load can map
+ *
+ * @graph: Pointer to graph_t structure (vertex indices 0 to n - 1)
+ * @path: Path of the file to create or truncate
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int sp_graph_save(graph_t const *graph, char const *path)
+{
+	char header[SP_GRAPH_FILE_HEADER];
+	sp_graph_file_header_t fields;
+	const vertex_t *v = NULL, **vertices = NULL;
+	const edge_t *edge = NULL;
+	unsigned long word = 0;
+	size_t n, i;
+	FILE *file = NULL;
+	int ok;
+
+	if (!graph || !path)
+		return (0);
+
+	n = graph->nb_vertices;
+	memset(header, 0, sizeof(header));
+	memset(&fields, 0, sizeof(fields));
+	memcpy(fields.magic, SP_GRAPH_FILE_MAGIC, sizeof(SP_GRAPH_FILE_MAGIC));
+	fields.nb_vertices = n;
+	vertices = malloc(n * sizeof(vertex_t *) + 1);
+	ok = vertices != NULL;
+
+	for (v = graph->vertices; ok && v; v = v->next)
+	{
+		ok = v->index < n;
+		if (ok)
+			vertices[v->index] = v;
+		fields.nb_edges += v->nb_edges;
+		fields.names_size += strlen(v->content) + 1;
+	}
+
+	memcpy(header, &fields, sizeof(fields));
+	file = ok ? fopen(path, "wb") : NULL;
+	ok = file && fwrite(header, sizeof(header), 1, file) == 1;
+
+	for (i = 0; ok && i <= n; ++i)
+	{
+		ok = fwrite(&word, sizeof(word), 1, file) == 1;
+		word += i < n ? vertices[i]->nb_edges : 0;
+	}
+	for (i = 0; ok && i < n; ++i)
+		for (edge = vertices[i]->edges; ok && edge; edge = edge->next)
+		{
+			word = edge->dest->index;
+			ok = fwrite(&word, sizeof(word), 1, file) == 1;
+		}
+	for (i = 0; ok && i < n; ++i)
+		ok = fwrite(&vertices[i]->x, sizeof(int), 1, file) == 1 &&
+			fwrite(&vertices[i]->y, sizeof(int), 1, file) == 1;
+	for (i = 0; ok && i < n; ++i)
+		for (edge = vertices[i]->edges; ok && edge; edge = edge->next)
+			ok = fwrite(&edge->weight, sizeof(int), 1, file) == 1;
+	for (i = 0; ok && i < n; ++i)
+		ok = fputs(vertices[i]->content, file) != EOF &&
+			fputc('\0', file) != EOF;
+
+	free(vertices);
+	return ((!file || fclose(file) == 0) && ok);
+}
+
+/**
+ * sp_graph_load - Builds a graph from a file written by sp_graph_save
+ * The file is mapped and validated, then its arrays are copied into a new
+ * graph_t, in O(V + E) with no text parsing; the mapping is released
+ * before returning
+ *
+ * @path: Path of the graph file
+ *
+ * Return: Pointer to graph_t structure, NULL on failure
+ */
+graph_t *sp_graph_load(char const *path)
+{
+	graph_t *graph = NULL;
+	struct stat st;
+	void *mapping = MAP_FAILED;
+	int fd;
+
+	if (!path)
+		return (NULL);
+
+	fd = open(path, O_RDONLY);
+
+	if (fd == -1)
+		return (NULL);
+
+	if (!fstat(fd, &st) && st.st_size >= SP_GRAPH_FILE_HEADER)
+		mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED,
+			fd, 0);
+
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return (NULL);
+
+	if (sp_graph_file_check(mapping, (size_t)st.st_size))
+		graph = sp_graph_build(mapping);
+
+	munmap(mapping, (size_t)st.st_size);
+	return (graph);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * sp_graph_file_check - Validates a mapped graph file
+ *
+ * @header: Start of the mapping
+ * @size: Size of the mapping
+ *
+ * Return: 1 if the file holds a graph this host can use, 0 otherwise
+ */
+static int sp_graph_file_check(sp_graph_file_header_t const *header,
+	size_t size)
+{
+	size_t n = header->nb_vertices, m = header->nb_edges, i, names = 0;
+	const unsigned long *offsets = NULL, *targets = NULL;
+	const char *name = NULL;
+	size_t arrays;
+
+	if (memcmp(header->magic, SP_GRAPH_FILE_MAGIC,
+		sizeof(SP_GRAPH_FILE_MAGIC)))
+		return (0);
+
+	size -= SP_GRAPH_FILE_HEADER;
+
+	/* Each vertex takes at least 17 bytes, each edge 12 */
+	if (n > size / 17 || m > size / 12)
+		return (0);
+
+	arrays = (n + 1 + m) * sizeof(unsigned long) +
+		(2 * n + m) * sizeof(int);
+
+	if (arrays > size || header->names_size != size - arrays)
+		return (0);
+
+	offsets = (const unsigned long *)((char const *)header +
+		SP_GRAPH_FILE_HEADER);
+	targets = offsets + n + 1;
+
+	for (i = 0; i < n; ++i)
+		if (offsets[i] > offsets[i + 1])
+			return (0);
+
+	for (i = 0; i < m; ++i)
+		if (targets[i] >= n)
+			return (0);
+
+	name = (const char *)((const int *)(targets + m) + 2 * n + m);
+
+	for (i = 0; i < header->names_size; ++i)
+		names += !name[i];
+
+	return (offsets[0] == 0 && offsets[n] == m && names == n &&
+		(!n || !name[header->names_size - 1]));
+}
+
+/**
+ * sp_graph_build - Copies the vertices and edges of a mapped graph file
+ * into a new graph
+ *
+ * @header: Start of the mapping, validated
+ *
+ * Return: Pointer to graph_t structure, NULL on failure
+ */
+static graph_t *sp_graph_build(sp_graph_file_header_t const *header)
+{
+	size_t n = header->nb_vertices, m = header->nb_edges, i, e;
+	const unsigned long *offsets = NULL, *targets = NULL;
+	const int *coords = NULL, *weights = NULL;
+	const char *name = NULL;
+	vertex_t **vertices = malloc(n * sizeof(vertex_t *) + 1), **link;
+	graph_t *graph = graph_create();
+	edge_t *edge = NULL;
+	int ok = vertices && graph;
+
+	link = graph ? &graph->vertices : NULL;
+	offsets = (const unsigned long *)((char const *)header +
+		SP_GRAPH_FILE_HEADER);
+	targets = offsets + n + 1;
+	coords = (const int *)(targets + m);
+	weights = coords + 2 * n;
+	name = (const char *)(weights + m);
+
+	for (i = 0; ok && i < n; ++i)
+	{
+		vertices[i] = calloc(1, sizeof(vertex_t));
+		if (!vertices[i])
+		{
+			ok = 0;
+			break;
+		}
+		vertices[i]->content = strdup(name);
+		ok = vertices[i]->content != NULL;
+		vertices[i]->index = i;
+		vertices[i]->x = coords[2 * i];
+		vertices[i]->y = coords[2 * i + 1];
+		*link = vertices[i];
+		link = &vertices[i]->next;
+		++graph->nb_vertices;
+		name += strlen(name) + 1;
+	}
+
+	/* Prepending from the last edge keeps the file's order */
+	for (i = 0; ok && i < n; ++i)
+		for (e = offsets[i + 1]; ok && e-- > offsets[i];)
+		{
+			edge = calloc(1, sizeof(edge_t));
+			ok = edge != NULL;
+			if (!ok)
+				break;
+			edge->dest = vertices[targets[e]];
+			edge->weight = weights[e];
+			edge->next = vertices[i]->edges;
+			vertices[i]->edges = edge;
+			++vertices[i]->nb_edges;
+		}
+
+	free(vertices);
+
+	if (!ok && graph)
+	{
+		graph_delete(graph);
+		graph = NULL;
+	}
+
+	return (graph);
+}
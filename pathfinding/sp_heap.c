@@ -0,0 +1,163 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_heap_create - Allocates an indexed priority queue
+ *
+ * @kind: Implementation (any but SP_HEAP_AUTO); SP_HEAP_BUCKET gets room
+ *   for key steps up to SP_BUCKET_MAX_WEIGHT
+ * @capacity: Number of distinct ids (ids range over [0, capacity))
+ *
+ * Return: Pointer to sp_heap_t structure, NULL on failure
+ */
+sp_heap_t *sp_heap_create(sp_heap_kind_t kind, size_t capacity)
+{
+	sp_heap_t *heap = NULL;
+	size_t alloc_size, i;
+
+	if (kind == SP_HEAP_BUCKET)
+		return (sp_bucket_create(capacity, SP_BUCKET_MAX_WEIGHT));
+
+	if (kind > SP_HEAP_PAIRING)
+		return (NULL);
+
+	alloc_size = sizeof(sp_heap_t) + capacity * (sizeof(unsigned long) +
+		sizeof(size_t) + (kind == SP_HEAP_PAIRING
+			? sizeof(sp_pairing_node_t) : sizeof(size_t)));
+	heap = malloc(alloc_size);
+
+	if (!heap)
+		return (NULL);
+
+	heap->kind = kind;
+	heap->arity = kind == SP_HEAP_QUATERNARY ? 4 : 2;
+	heap->size = 0;
+	heap->capacity = capacity;
+	heap->key = (unsigned long *)(heap + 1);
+	heap->pos = (size_t *)(heap->key + capacity);
+	heap->items = heap->pos + capacity;
+	heap->nodes = (sp_pairing_node_t *)heap->items;
+	heap->root = SP_HEAP_NONE;
+
+	for (i = 0; i < capacity; ++i)
+		heap->pos[i] = SP_HEAP_NONE;
+
+	return (heap);
+}
+
+/**
+ * sp_heap_delete - Deallocates an indexed priority queue
+ *
+ * @heap: Pointer to sp_heap_t structure
+ */
+void sp_heap_delete(sp_heap_t *heap)
+{
+	free(heap);
+}
+
+/**
+ * sp_heap_clear - Empties a priority queue for reuse, without popping
+ * O(size), plus the buckets between the cursor and the largest key for the
+ * bucket kind
+ *
+ * @heap: Pointer to sp_heap_t structure
+ */
+void sp_heap_clear(sp_heap_t *heap)
+{
+	size_t b, id;
+
+	if (heap->kind == SP_HEAP_PAIRING)
+		sp_pairing_clear(heap);
+
+	/* Bucket lists are emptied from the cursor, at the smallest key */
+	for (b = heap->cursor; heap->kind == SP_HEAP_BUCKET && heap->size;
+		b = b + 1 == heap->nb_buckets ? 0 : b + 1)
+	{
+		for (id = heap->buckets[b]; id != SP_HEAP_NONE;
+			id = heap->nodes[id].sibling, --heap->size)
+			heap->pos[id] = SP_HEAP_NONE;
+		heap->buckets[b] = SP_HEAP_NONE;
+	}
+
+	if (heap->kind == SP_HEAP_BINARY || heap->kind == SP_HEAP_QUATERNARY)
+		while (heap->size)
+			heap->pos[heap->items[--heap->size]] = SP_HEAP_NONE;
+
+	heap->size = 0;
+}
+
+/**
+ * sp_heap_push - Queues an id, or lowers its key if it is already queued
+ *
+ * @heap: Pointer to sp_heap_t structure
+ * @id: Id in [0, capacity)
+ * @key: Priority (smaller comes out first)
+ *
+ * Return: 1 if the id was queued or its key lowered, 0 otherwise
+ */
+int sp_heap_push(sp_heap_t *heap, size_t id, unsigned long key)
+{
+	int queued;
+
+	if (id >= heap->capacity)
+		return (0);
+
+	queued = heap->pos[id] != SP_HEAP_NONE;
+
+	if (queued && key >= heap->key[id])
+		return (0);
+
+	if (heap->kind == SP_HEAP_BUCKET)
+		return (sp_bucket_push(heap, id, key, queued));
+
+	heap->key[id] = key;
+
+	if (heap->kind == SP_HEAP_PAIRING)
+	{
+		heap->pos[id] = 0;
+		heap->size += !queued;
+		sp_pairing_push(heap, id, queued);
+		return (1);
+	}
+
+	if (!queued)
+	{
+		heap->pos[id] = heap->size;
+		heap->items[heap->size++] = id;
+	}
+
+	sp_dary_sift_up(heap, heap->pos[id]);
+	return (1);
+}
+
+/**
+ * sp_heap_pop - Extracts the id with the smallest key
+ *
+ * @heap: Pointer to sp_heap_t structure
+ * @key: If not NULL, receives the extracted id's key
+ *
+ * Return: Extracted id, SP_HEAP_NONE if the queue is empty
+ */
+size_t sp_heap_pop(sp_heap_t *heap, unsigned long *key)
+{
+	size_t id;
+
+	if (!heap->size)
+		return (SP_HEAP_NONE);
+
+	if (heap->kind == SP_HEAP_BUCKET)
+		id = sp_bucket_pop(heap);
+	else if (heap->kind == SP_HEAP_PAIRING)
+		id = sp_pairing_pop(heap);
+	else
+		id = sp_dary_pop(heap);
+	--heap->size;
+	heap->pos[id] = SP_HEAP_NONE;
+
+	if (key)
+		*key = heap->key[id];
+
+	return (id);
+}
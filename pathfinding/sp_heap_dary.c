@@ -0,0 +1,97 @@
+#include "pathfinding.h"
+
+#define KEY_AT(heap, i) ((heap)->key[(heap)->items[i]])
+
+/* STATIC FUNCTIONS */
+
+static void sift_down(sp_heap_t *heap, size_t i);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_dary_sift_up - Restores heap order above a position after its key fell
+ *
+ * @heap: Pointer to sp_heap_t structure (d-ary kind)
+ * @i: Position in `items`
+ */
+void sp_dary_sift_up(sp_heap_t *heap, size_t i)
+{
+	size_t id = heap->items[i], parent;
+	unsigned long key = heap->key[id];
+
+	/* Hole-shifting: parents move down, `id` is written once */
+	while (i)
+	{
+		parent = (i - 1) / heap->arity;
+
+		if (KEY_AT(heap, parent) <= key)
+			break;
+
+		heap->items[i] = heap->items[parent];
+		heap->pos[heap->items[i]] = i;
+		i = parent;
+	}
+
+	heap->items[i] = id;
+	heap->pos[id] = i;
+}
+
+/**
+ * sp_dary_pop - Removes the root of a d-ary heap
+ * The caller updates `size` and the root's position mark
+ *
+ * @heap: Pointer to sp_heap_t structure (d-ary kind, not empty)
+ *
+ * Return: Root id
+ */
+size_t sp_dary_pop(sp_heap_t *heap)
+{
+	size_t root = heap->items[0], last = heap->size - 1;
+
+	if (last)
+	{
+		heap->items[0] = heap->items[last];
+		heap->pos[heap->items[0]] = 0;
+		heap->size = last;
+		sift_down(heap, 0);
+		heap->size = last + 1;
+	}
+
+	return (root);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * sift_down - Restores heap order below a position
+ *
+ * @heap: Pointer to sp_heap_t structure (d-ary kind)
+ * @i: Position in `items`
+ */
+static void sift_down(sp_heap_t *heap, size_t i)
+{
+	size_t id = heap->items[i], first, best, c, end;
+	unsigned long key = heap->key[id];
+
+	while ((first = i * heap->arity + 1) < heap->size)
+	{
+		end = first + heap->arity < heap->size
+			? first + heap->arity : heap->size;
+
+		for (best = first, c = first + 1; c < end; ++c)
+		{
+			if (KEY_AT(heap, c) < KEY_AT(heap, best))
+				best = c;
+		}
+
+		if (key <= KEY_AT(heap, best))
+			break;
+
+		heap->items[i] = heap->items[best];
+		heap->pos[heap->items[i]] = i;
+		i = best;
+	}
+
+	heap->items[i] = id;
+	heap->pos[id] = i;
+}
@@ -0,0 +1,166 @@
+#include "pathfinding.h"
+
+#define NODE(heap, id) ((heap)->nodes[id])
+
+/* STATIC FUNCTIONS */
+
+static size_t meld(sp_heap_t *heap, size_t a, size_t b);
+static size_t merge_pairs(sp_heap_t *heap, size_t first);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_pairing_push - Inserts an id, or re-roots it after a decrease-key
+ * The caller sets the key, `size` and the membership mark
+ *
+ * @heap: Pointer to sp_heap_t structure (pairing kind)
+ * @id: Id whose key was just set
+ * @queued: Non-0 if `id` was already in the heap (decrease-key)
+ */
+void sp_pairing_push(sp_heap_t *heap, size_t id, int queued)
+{
+	size_t prev, sibling;
+
+	if (queued)
+	{
+		if (id == heap->root)
+			return;
+
+		/* Cut the subtree of `id` out of its sibling list */
+		prev = NODE(heap, id).prev, sibling = NODE(heap, id).sibling;
+
+		if (NODE(heap, prev).child == id)
+			NODE(heap, prev).child = sibling;
+		else
+			NODE(heap, prev).sibling = sibling;
+
+		if (sibling != SP_HEAP_NONE)
+			NODE(heap, sibling).prev = prev;
+	}
+	else
+	{
+		NODE(heap, id).child = SP_HEAP_NONE;
+	}
+
+	NODE(heap, id).sibling = NODE(heap, id).prev = SP_HEAP_NONE;
+	heap->root = heap->root == SP_HEAP_NONE
+		? id : meld(heap, heap->root, id);
+}
+
+/**
+ * sp_pairing_pop - Removes the root of a pairing heap
+ * The caller updates `size` and the root's membership mark
+ *
+ * @heap: Pointer to sp_heap_t structure (pairing kind, not empty)
+ *
+ * Return: Root id
+ */
+size_t sp_pairing_pop(sp_heap_t *heap)
+{
+	size_t root = heap->root;
+
+	heap->root = merge_pairs(heap, NODE(heap, root).child);
+
+	if (heap->root != SP_HEAP_NONE)
+		NODE(heap, heap->root).prev = SP_HEAP_NONE;
+
+	return (root);
+}
+
+/**
+ * sp_pairing_clear - Unmarks every id of a pairing heap, in O(size)
+ * The caller resets `size`
+ *
+ * @heap: Pointer to sp_heap_t structure (pairing kind)
+ */
+void sp_pairing_clear(sp_heap_t *heap)
+{
+	size_t id = heap->root, last;
+
+	/* Each id's children are spliced in after it, so the walk meets all */
+	while (id != SP_HEAP_NONE)
+	{
+		last = NODE(heap, id).child;
+
+		if (last != SP_HEAP_NONE)
+		{
+			while (NODE(heap, last).sibling != SP_HEAP_NONE)
+				last = NODE(heap, last).sibling;
+			NODE(heap, last).sibling = NODE(heap, id).sibling;
+			NODE(heap, id).sibling = NODE(heap, id).child;
+		}
+
+		heap->pos[id] = SP_HEAP_NONE;
+		id = NODE(heap, id).sibling;
+	}
+
+	heap->root = SP_HEAP_NONE;
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * meld - Links two roots, the larger key becoming leftmost child
+ *
+ * @heap: Pointer to sp_heap_t structure (pairing kind)
+ * @a: First root id
+ * @b: Second root id
+ *
+ * Return: Id of the resulting root
+ */
+static size_t meld(sp_heap_t *heap, size_t a, size_t b)
+{
+	size_t tmp;
+
+	if (heap->key[b] < heap->key[a])
+		tmp = a, a = b, b = tmp;
+
+	NODE(heap, b).sibling = NODE(heap, a).child;
+
+	if (NODE(heap, a).child != SP_HEAP_NONE)
+		NODE(heap, NODE(heap, a).child).prev = b;
+
+	NODE(heap, b).prev = a;
+	NODE(heap, a).child = b;
+	return (a);
+}
+
+/**
+ * merge_pairs - Two-pass pairing of a sibling list into one tree
+ *
+ * @heap: Pointer to sp_heap_t structure (pairing kind)
+ * @first: Leftmost id of the sibling list
+ *
+ * Return: Id of the resulting root, SP_HEAP_NONE if the list is empty
+ */
+static size_t merge_pairs(sp_heap_t *heap, size_t first)
+{
+	size_t acc = SP_HEAP_NONE, a, b, next, merged;
+
+	/* Pass 1, left to right: meld pairs, stacking results via `sibling` */
+	while (first != SP_HEAP_NONE)
+	{
+		a = first, b = NODE(heap, a).sibling;
+		next = b == SP_HEAP_NONE ? SP_HEAP_NONE : NODE(heap, b).sibling;
+		merged = b == SP_HEAP_NONE ? a : meld(heap, a, b);
+		NODE(heap, merged).sibling = acc;
+		acc = merged, first = next;
+	}
+
+	if (acc == SP_HEAP_NONE)
+		return (SP_HEAP_NONE);
+
+	/* Pass 2, right to left: fold the stack into one tree */
+	merged = acc, acc = NODE(heap, acc).sibling;
+	NODE(heap, merged).sibling = SP_HEAP_NONE;
+
+	while (acc != SP_HEAP_NONE)
+	{
+		next = NODE(heap, acc).sibling;
+		NODE(heap, acc).sibling = SP_HEAP_NONE;
+		merged = meld(heap, merged, acc);
+		acc = next;
+	}
+
+	return (merged);
+}
@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_heap_peek - Reads the id with the smallest key without extracting it
+ * On the bucket kind this moves the cursor up to that key, so the caller
+ * must not push keys below it afterwards (Dijkstra-style searches never do)
+ *
+ * @heap: Pointer to sp_heap_t structure
+ * @key: If not NULL, receives the id's key
+ *
+ * Return: Smallest id, SP_HEAP_NONE if the queue is empty
+ */
+size_t sp_heap_peek(sp_heap_t *heap, unsigned long *key)
+{
+	size_t id;
+
+	if (!heap->size)
+		return (SP_HEAP_NONE);
+
+	if (heap->kind == SP_HEAP_BUCKET)
+		id = sp_bucket_first(heap);
+	else if (heap->kind == SP_HEAP_PAIRING)
+		id = heap->root;
+	else
+		id = heap->items[0];
+
+	if (key)
+		*key = heap->key[id];
+
+	return (id);
+}
+
+/**
+ * sp_bucket_first - Advances the cursor to the lowest non-empty bucket
+ *
+ * @heap: Pointer to sp_heap_t structure (bucket kind, not empty)
+ *
+ * Return: Head id of that bucket
+ */
+size_t sp_bucket_first(sp_heap_t *heap)
+{
+	/* The cursor only moves forward: O(1) amortised per key unit */
+	while (heap->buckets[heap->cursor] == SP_HEAP_NONE)
+	{
+		heap->cursor = heap->cursor + 1 == heap->nb_buckets
+			? 0 : heap->cursor + 1;
+		++heap->cursor_key;
+	}
+
+	return (heap->buckets[heap->cursor]);
+}
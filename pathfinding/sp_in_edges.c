@@ -0,0 +1,78 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_in_edges_create - Builds the incoming-edge view of a graph
+ * Two passes over the adjacency lists: count in-degrees, then scatter
+ *
+ * @graph: Pointer to graph_t structure
+ *
+ * Return: Pointer to sp_in_edges_t structure, NULL on failure
+ */
+sp_in_edges_t *sp_in_edges_create(graph_t const *graph)
+{
+	sp_in_edges_t *in = NULL;
+	const vertex_t *v = NULL;
+	const edge_t *e = NULL;
+	size_t n, m = 0, i, *fill = NULL;
+
+	if (!graph)
+		return (NULL);
+
+	n = graph->nb_vertices;
+
+	for (v = graph->vertices; v; v = v->next)
+		m += v->nb_edges;
+
+	in = calloc(1, sizeof(sp_in_edges_t) + (2 * n + 1) * sizeof(size_t) +
+		(n + m) * sizeof(const vertex_t *) + m * sizeof(int));
+
+	if (!in)
+		return (NULL);
+
+	in->nb_vertices = n;
+	in->nb_edges = m;
+	in->offsets = (size_t *)(in + 1);
+	fill = in->offsets + n + 1;
+	in->sources = (const vertex_t **)(fill + n);
+	in->vertices = in->sources + m;
+	in->weights = (int *)(in->vertices + n);
+
+	for (v = graph->vertices; v; v = v->next)
+	{
+		in->vertices[v->index] = v;
+
+		for (e = v->edges; e; e = e->next)
+			++in->offsets[e->dest->index + 1];
+	}
+
+	for (i = 0; i < n; ++i)
+	{
+		in->offsets[i + 1] += in->offsets[i];
+		fill[i] = in->offsets[i];
+	}
+
+	for (v = graph->vertices; v; v = v->next)
+	{
+		for (e = v->edges; e; e = e->next)
+		{
+			i = fill[e->dest->index]++;
+			in->sources[i] = v;
+			in->weights[i] = e->weight;
+		}
+	}
+
+	return (in);
+}
+
+/**
+ * sp_in_edges_delete - Deallocates an incoming-edge view
+ *
+ * @in: Pointer to sp_in_edges_t structure
+ */
+void sp_in_edges_delete(sp_in_edges_t *in)
+{
+	free(in);
+}
@@ -0,0 +1,177 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_io_write - Writes a whole buffer to a socket
+ * A peer that went away fails the write instead of raising SIGPIPE
+ *
+ * @fd: Socket
+ * @buf: Bytes to write
+ * @length: Number of bytes
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int sp_io_write(int fd, void const *buf, size_t length)
+{
+	const char *pos = buf;
+	ssize_t n;
+
+	while (length)
+	{
+		n = send(fd, pos, length, MSG_NOSIGNAL);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (0);
+
+		pos += n;
+		length -= (size_t)n;
+	}
+
+	return (1);
+}
+
+/**
+ * sp_io_read - Reads a whole buffer from a socket
+ *
+ * @fd: Socket
+ * @buf: Buffer to fill
+ * @length: Number of bytes
+ *
+ * Return: 1 on success, 0 on end of file or failure
+ */
+int sp_io_read(int fd, void *buf, size_t length)
+{
+	char *pos = buf;
+	ssize_t n;
+
+	while (length)
+	{
+		n = read(fd, pos, length);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (0);
+
+		pos += n;
+		length -= (size_t)n;
+	}
+
+	return (1);
+}
+
+/**
+ * sp_server_reply - Queues a whole reply on a connection, and wakes the
+ * reader up to send it
+ * Never waits on the client: a reply to a connection being dropped is
+ * discarded, and a reply that cannot be queued has the connection dropped
+ *
+ * @server: Pointer to sp_server_t structure
+ * @conn: Pointer to sp_conn_t structure
+ * @reply: Header, then payload
+ * @length: Number of bytes
+ *
+ * Return: 1 on success, 0 if the reply was discarded
+ */
+int sp_server_reply(sp_server_t *server, sp_conn_t *conn,
+	void const *reply, size_t length)
+{
+	size_t unsent, capacity;
+	unsigned char *out = NULL;
+	int wake, ok;
+
+	pthread_mutex_lock(&conn->lock);
+	unsent = conn->out_size - conn->out_sent;
+	wake = conn->pending-- == SP_CONN_PENDING_MAX || !unsent;
+	ok = !conn->closing;
+
+	/* Sent bytes are reclaimed before growing */
+	if (ok && conn->out_capacity - conn->out_size < length)
+	{
+		if (unsent)
+			memmove(conn->out, conn->out + conn->out_sent, unsent);
+		conn->out_sent = 0;
+		conn->out_size = unsent;
+		capacity = conn->out_capacity ? conn->out_capacity : 4096;
+		while (capacity - unsent < length)
+			capacity *= 2;
+		out = capacity > conn->out_capacity ?
+			realloc(conn->out, capacity) : conn->out;
+		ok = out != NULL;
+		if (!ok)
+			conn->closing = wake = 1;
+		else
+			conn->out = out, conn->out_capacity = capacity;
+	}
+
+	if (ok)
+	{
+		memcpy(conn->out + conn->out_size, reply, length);
+		conn->out_size += length;
+		if (!unsent)
+			conn->since = sp_clock_ns();
+	}
+
+	pthread_mutex_unlock(&conn->lock);
+
+	/* A full pipe already holds a wake-up */
+	if (wake && write(server->wake[1], "", 1) < 0)
+		return (ok);
+
+	return (ok);
+}
+
+/**
+ * sp_conn_release - Drops a reference to a connection, closing and freeing
+ * it with the last one
+ *
+ * @conn: Pointer to sp_conn_t structure
+ */
+void sp_conn_release(sp_conn_t *conn)
+{
+	if (__atomic_sub_fetch(&conn->refs, 1, __ATOMIC_ACQ_REL))
+		return;
+
+	close(conn->fd);
+	pthread_mutex_destroy(&conn->lock);
+	free(conn->buf);
+	free(conn->out);
+	free(conn);
+}
+
+/**
+ * sp_worker_reserve - Makes room for a reply in a worker's buffer
+ *
+ * @worker: Pointer to sp_worker_t structure
+ * @length: Number of payload bytes
+ *
+ * Return: Pointer to the payload, after room for the header, NULL on
+ *   failure
+ */
+void *sp_worker_reserve(sp_worker_t *worker, size_t length)
+{
+	size_t size = sizeof(sp_msg_header_t) + length, capacity;
+	unsigned char *out = NULL;
+
+	if (size > worker->out_capacity)
+	{
+		capacity = worker->out_capacity ? worker->out_capacity : 4096;
+		while (capacity < size)
+			capacity *= 2;
+		out = realloc(worker->out, capacity);
+		if (!out)
+			return (NULL);
+		worker->out = out;
+		worker->out_capacity = capacity;
+	}
+
+	return (worker->out + sizeof(sp_msg_header_t));
+}
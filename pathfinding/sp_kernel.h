@@ -0,0 +1,157 @@
+#ifndef SYSTEMALGORITHMS_SP_KERNEL_H
+#define SYSTEMALGORITHMS_SP_KERNEL_H
+
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/*
+ * Dijkstra kernels specialised on a weight type and a heap arity
+ *
+ * SP_KERNEL_DEFINE(name, weight_t, arity, valid) defines, in the including
+ * file, a static search name() whose distances are weight_t and whose
+ * indexed min-heap has `arity` children per node, both fixed at compile
+ * time: keys are compared as weight_t, with no conversion, bitfield or
+ * dispatch on a heap kind. `valid(w)` rejects weights the type cannot
+ * order (negative or NaN floats); pass SP_KERNEL_ANY for unsigned types
+ *
+ * The search has the signature
+ *   int name(graph_t const *graph, vertex_t const *start,
+ *     vertex_t const *target, weight_t (*weight)(edge_t const *, void *),
+ *     void *data, sp_path_t *path, weight_t *cost)
+ * With a NULL `weight`, edges weigh edge_t.weight (negative ones are
+ * skipped). Relaxations that would overflow an integer distance are
+ * dropped, as if the edge were missing. It returns 1 if a path was
+ * found, 0 if not or on failure
+ */
+
+/* Heap slot of vertices never queued, and of settled ones */
+#define SP_KERNEL_NEW SP_HEAP_NONE
+#define SP_KERNEL_SETTLED (SP_HEAP_NONE - 1)
+#define SP_KERNEL_ANY(w) 1
+#define SP_KERNEL_POSITIVE(w) ((w) >= 0)
+
+#define SP_KERNEL_DEFINE(name, weight_t, arity, valid) \
+\
+typedef struct name##_entry_s \
+{ \
+	weight_t dist; \
+	const vertex_t *vertex, *prev; \
+	size_t slot; \
+} name##_entry_t; \
+\
+static void name##_up(name##_entry_t *entries, size_t *heap, size_t i) \
+{ \
+	size_t id = heap[i], parent; \
+\
+	while (i && entries[heap[parent = (i - 1) / (arity)]].dist > \
+		entries[id].dist) \
+	{ \
+		heap[i] = heap[parent]; \
+		entries[heap[i]].slot = i; \
+		i = parent; \
+	} \
+\
+	heap[i] = id; \
+	entries[id].slot = i; \
+} \
+\
+static size_t name##_pop(name##_entry_t *entries, size_t *heap, \
+	size_t *size) \
+{ \
+	size_t top = heap[0], last = heap[--*size], i = 0, c, best, end; \
+\
+	while ((best = i * (arity) + 1) < *size) \
+	{ \
+		end = best + (arity) < *size ? best + (arity) : *size; \
+		for (c = best + 1; c < end; ++c) \
+			if (entries[heap[c]].dist < entries[heap[best]].dist) \
+				best = c; \
+		if (!(entries[heap[best]].dist < entries[last].dist)) \
+			break; \
+		heap[i] = heap[best]; \
+		entries[heap[i]].slot = i; \
+		i = best; \
+	} \
+\
+	heap[i] = last; \
+	entries[last].slot = i; \
+	entries[top].slot = SP_KERNEL_SETTLED; \
+	return (top); \
+} \
+\
+static int name##_path(name##_entry_t const *entries, \
+	vertex_t const *target, sp_path_t *path) \
+{ \
+	const vertex_t *pos = NULL; \
+	size_t i; \
+\
+	path->length = 0; \
+	for (pos = target; pos; pos = entries[pos->index].prev) \
+		++path->length; \
+	if (!sp_path_reserve(path, path->length)) \
+		return (0); \
+	for (pos = target, i = path->length; pos; \
+		pos = entries[pos->index].prev) \
+		path->vertices[--i] = pos; \
+	path->cost = (unsigned long)entries[target->index].dist; \
+	return (1); \
+} \
+\
+static int name(graph_t const *graph, vertex_t const *start, \
+	vertex_t const *target, weight_t (*weight)(edge_t const *, void *), \
+	void *data, sp_path_t *path, weight_t *cost) \
+{ \
+	size_t n = graph->nb_vertices, size = 0, id, *heap = NULL; \
+	name##_entry_t *entries = NULL, *to = NULL; \
+	const edge_t *edge = NULL; \
+	weight_t w, d; \
+	int found = 0; \
+\
+	entries = malloc(n * (sizeof(name##_entry_t) + sizeof(size_t))); \
+	if (!entries) \
+		return (0); \
+	heap = (size_t *)(entries + n); \
+	for (id = 0; id < n; ++id) \
+		entries[id].slot = SP_KERNEL_NEW; \
+	entries[start->index].dist = 0; \
+	entries[start->index].vertex = start; \
+	entries[start->index].prev = NULL; \
+	heap[size++] = start->index; \
+	entries[start->index].slot = 0; \
+\
+	while (size && !found) \
+	{ \
+		id = name##_pop(entries, heap, &size); \
+		found = id == target->index; \
+		d = entries[id].dist; \
+		for (edge = entries[id].vertex->edges; !found && edge; \
+			edge = edge->next) \
+		{ \
+			if (!weight && edge->weight < 0) \
+				continue; \
+			w = (weight_t)edge->weight; \
+			if (weight) \
+				w = weight(edge, data); \
+			to = entries + edge->dest->index; \
+			if (!valid(w) || d + w < d || \
+				to->slot == SP_KERNEL_SETTLED) \
+				continue; \
+			if (to->slot != SP_KERNEL_NEW && !(d + w < to->dist)) \
+				continue; \
+			to->dist = d + w; \
+			to->vertex = edge->dest; \
+			to->prev = entries[id].vertex; \
+			if (to->slot == SP_KERNEL_NEW) \
+				heap[to->slot = size++] = edge->dest->index; \
+			name##_up(entries, heap, to->slot); \
+		} \
+	} \
+\
+	found = found && name##_path(entries, target, path); \
+	if (found && cost) \
+		*cost = entries[target->index].dist; \
+	free(entries); \
+	return (found); \
+}
+
+#endif /* SYSTEMALGORITHMS_SP_KERNEL_H */
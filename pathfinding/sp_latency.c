@@ -0,0 +1,75 @@
+#include <time.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_clock_ns - Reads the monotonic clock
+ *
+ * Return: Nanoseconds since an arbitrary point
+ */
+unsigned long sp_clock_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((unsigned long)now.tv_sec * 1000000000UL +
+		(unsigned long)now.tv_nsec);
+}
+
+/**
+ * sp_latency_record - Counts one latency in a histogram
+ * Buckets double in width, so the histogram spans 1 us to over an hour in
+ * SP_LATENCY_BUCKETS counters; the owner may record while others read
+ *
+ * @latency: Histogram of SP_LATENCY_BUCKETS counters
+ * @ns: Latency, in nanoseconds
+ */
+void sp_latency_record(unsigned long *latency, unsigned long ns)
+{
+	unsigned long us = ns / 1000;
+	size_t bucket = 0;
+
+	while (us > 1 && bucket < SP_LATENCY_BUCKETS - 1)
+	{
+		us >>= 1;
+		++bucket;
+	}
+
+	__atomic_fetch_add(latency + bucket, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * sp_latency_percentile - Latency below which a fraction of a histogram's
+ * requests were served
+ *
+ * @latency: Histogram of SP_LATENCY_BUCKETS counters
+ * @fraction: Fraction of requests, 0.5 for the median
+ *
+ * Return: Upper edge of the bucket holding that request, in microseconds,
+ *   0 if the histogram is empty
+ */
+unsigned long sp_latency_percentile(unsigned long const *latency,
+	double fraction)
+{
+	unsigned long total = 0, seen = 0, rank;
+	size_t bucket;
+
+	for (bucket = 0; bucket < SP_LATENCY_BUCKETS; ++bucket)
+		total += latency[bucket];
+
+	if (!total)
+		return (0);
+
+	rank = (unsigned long)(fraction * (double)total);
+	rank = rank < total ? rank : total - 1;
+
+	for (bucket = 0; bucket < SP_LATENCY_BUCKETS - 1; ++bucket)
+	{
+		seen += latency[bucket];
+		if (seen > rank)
+			break;
+	}
+
+	return (2UL << bucket);
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/**
+ * main - Loads a path-query server and prints its round-trip latencies
+ *
+ * @ac: Arguments counter
+ * @av: Arguments vector
+ *
+ * Return: EXIT_SUCCESS, or EXIT_FAILURE on error
+ */
+int main(int ac, char **av)
+{
+	sp_loadgen_t loadgen;
+	size_t total;
+
+	if (ac < 3 || ac > 8)
+	{
+		fprintf(stderr, "Usage: %s socket path|grid|matrix "
+			"[connections] [requests] [depth] [matrix_size] "
+			"[seed]\n", av[0]);
+		return (EXIT_FAILURE);
+	}
+
+	memset(&loadgen, 0, sizeof(loadgen));
+	loadgen.socket_path = av[1];
+	loadgen.type = !strcmp(av[2], "path") ? SP_MSG_PATH :
+		!strcmp(av[2], "grid") ? SP_MSG_GRID :
+		!strcmp(av[2], "matrix") ? SP_MSG_MATRIX : SP_MSG_NONE;
+	loadgen.nb_connections = ac > 3 ? strtoul(av[3], NULL, 10) : 4;
+	loadgen.nb_requests = ac > 4 ? strtoul(av[4], NULL, 10) : 10000;
+	loadgen.depth = ac > 5 ? strtoul(av[5], NULL, 10) : 16;
+	loadgen.matrix_size = ac > 6 ? strtoul(av[6], NULL, 10) : 8;
+	loadgen.seed = ac > 7 ? strtoul(av[7], NULL, 10) : 1;
+
+	if (!sp_loadgen_run(&loadgen))
+	{
+		fprintf(stderr, "Cannot load %s with %s requests\n", av[1],
+			av[2]);
+		return (EXIT_FAILURE);
+	}
+
+	total = loadgen.nb_connections * loadgen.nb_requests;
+	printf("%lu requests, %lu errors, %.0f requests/s\n",
+		(unsigned long)total, (unsigned long)loadgen.nb_errors,
+		(double)total * 1e9 / (double)(loadgen.elapsed + 1));
+	printf("p50 < %lu us  p90 < %lu us  p99 < %lu us  p99.9 < %lu us\n",
+		sp_latency_percentile(loadgen.latency, 0.5),
+		sp_latency_percentile(loadgen.latency, 0.9),
+		sp_latency_percentile(loadgen.latency, 0.99),
+		sp_latency_percentile(loadgen.latency, 0.999));
+	return (loadgen.nb_errors ? EXIT_FAILURE : EXIT_SUCCESS);
+}
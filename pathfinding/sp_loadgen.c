@@ -0,0 +1,211 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/* xorshift64 step: the state must not be 0 */
+#define NEXT(s) ((s) ^= (s) << 13, (s) ^= (s) >> 7, (s) ^= (s) << 17)
+
+/* STATIC FUNCTIONS */
+
+static int sp_loadgen_bounds(sp_loadgen_t const *loadgen,
+	sp_msg_stats_t *bounds);
+static void *sp_loadgen_conn(void *arg);
+static size_t sp_loadgen_request(sp_loadgen_conn_t *conn);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_loadgen_run - Loads a path-query server with random requests
+ * Vertices and cells are drawn uniformly, so some grid requests start or
+ * end on a wall and are answered SP_MSG_NO_PATH, which is not an error
+ *
+ * @loadgen: Pointer to sp_loadgen_t structure; its latency histogram,
+ *   error count and duration are added to
+ *
+ * Return: 1 on success, 0 if the run could not start
+ */
+int sp_loadgen_run(sp_loadgen_t *loadgen)
+{
+	sp_loadgen_conn_t *conns = NULL;
+	sp_msg_stats_t bounds;
+	unsigned long start;
+	size_t i, nb_started = 0;
+
+	if (!loadgen || !loadgen->socket_path || !loadgen->nb_connections ||
+		!loadgen->nb_requests || !loadgen->depth ||
+		(loadgen->type == SP_MSG_MATRIX && (!loadgen->matrix_size ||
+		loadgen->matrix_size > SP_MSG_MAX / 16)) ||
+		!sp_loadgen_bounds(loadgen, &bounds))
+		return (0);
+
+	conns = calloc(loadgen->nb_connections, sizeof(sp_loadgen_conn_t));
+
+	if (!conns)
+		return (0);
+
+	start = sp_clock_ns();
+
+	for (i = 0; i < loadgen->nb_connections; ++i)
+	{
+		conns[i].loadgen = loadgen;
+		conns[i].bounds = &bounds;
+		conns[i].rng = (loadgen->seed + i) * 0x9E3779B97F4A7C15UL | 1;
+		if (pthread_create(&conns[i].tid, NULL, sp_loadgen_conn,
+			conns + i))
+			break;
+		++nb_started;
+	}
+
+	for (i = 0; i < nb_started; ++i)
+		pthread_join(conns[i].tid, NULL);
+
+	loadgen->elapsed += sp_clock_ns() - start;
+	free(conns);
+	return (nb_started == loadgen->nb_connections);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * sp_loadgen_bounds - Asks the server for the sizes requests are drawn in
+ *
+ * @loadgen: Pointer to sp_loadgen_t structure
+ * @bounds: Set to the server's statistics
+ *
+ * Return: 1 if the server can serve the requested type, 0 otherwise
+ */
+static int sp_loadgen_bounds(sp_loadgen_t const *loadgen,
+	sp_msg_stats_t *bounds)
+{
+	sp_client_t *client = sp_client_connect(loadgen->socket_path);
+	sp_msg_header_t header;
+	void *reply = NULL;
+	int ok;
+
+	ok = client && sp_client_send(client, SP_MSG_STATS, NULL, 0) &&
+		sp_client_recv(client, &header, &reply) &&
+		header.status == SP_MSG_OK && header.length == sizeof(*bounds);
+
+	if (ok)
+		memcpy(bounds, reply, sizeof(*bounds));
+
+	free(reply);
+	sp_client_close(client);
+
+	if (!ok)
+		return (0);
+
+	if (loadgen->type == SP_MSG_GRID)
+		return (bounds->rows > 0 && bounds->cols > 0);
+
+	return ((loadgen->type == SP_MSG_PATH ||
+		loadgen->type == SP_MSG_MATRIX) && bounds->nb_vertices);
+}
+
+/**
+ * sp_loadgen_conn - Keeps a connection's requests in flight, and times
+ * their replies
+ *
+ * @arg: Pointer to sp_loadgen_conn_t structure
+ *
+ * Return: NULL
+ */
+static void *sp_loadgen_conn(void *arg)
+{
+	sp_loadgen_conn_t *conn = arg;
+	sp_loadgen_t *loadgen = conn->loadgen;
+	size_t issued = 0, done = 0, errors = 0, length;
+	sp_client_t *client = sp_client_connect(loadgen->socket_path);
+	sp_msg_type_t type = loadgen->type;
+	sp_msg_header_t header;
+	unsigned long id, now;
+	void *reply = NULL;
+	int ok;
+
+	conn->sent = malloc((loadgen->nb_requests + 1) * sizeof(unsigned long));
+	conn->payload = malloc(sizeof(sp_msg_matrix_t) +
+		2 * loadgen->matrix_size * sizeof(unsigned long) +
+		sizeof(sp_msg_grid_t) + sizeof(sp_msg_path_t));
+	ok = client && conn->sent && conn->payload;
+
+	while (ok && done < loadgen->nb_requests)
+	{
+		while (ok && issued < loadgen->nb_requests &&
+			issued - done < loadgen->depth)
+		{
+			length = sp_loadgen_request(conn);
+			now = sp_clock_ns();
+			id = sp_client_send(client, type, conn->payload,
+				length);
+			ok = id == issued + 1;
+			if (ok)
+				conn->sent[id] = now;
+			issued += ok;
+		}
+
+		ok = ok && sp_client_recv(client, &header, &reply);
+		free(reply);
+		ok = ok && header.id && header.id <= issued;
+		if (!ok)
+			break;
+
+		sp_latency_record(loadgen->latency,
+			sp_clock_ns() - conn->sent[header.id]);
+		errors += header.status != SP_MSG_OK &&
+			header.status != SP_MSG_NO_PATH;
+		++done;
+	}
+
+	/* Requests never answered count as errors */
+	errors += loadgen->nb_requests - done;
+	__atomic_add_fetch(&loadgen->nb_errors, errors, __ATOMIC_RELAXED);
+	sp_client_close(client);
+	free(conn->sent);
+	free(conn->payload);
+	return (NULL);
+}
+
+/**
+ * sp_loadgen_request - Draws a random request into a connection's buffer
+ *
+ * @conn: Pointer to sp_loadgen_conn_t structure
+ *
+ * Return: Number of payload bytes
+ */
+static size_t sp_loadgen_request(sp_loadgen_conn_t *conn)
+{
+	const sp_msg_stats_t *bounds = conn->bounds;
+	sp_msg_matrix_t matrix;
+	sp_msg_grid_t grid;
+	size_t i, size = conn->loadgen->matrix_size;
+	unsigned long *indices = conn->payload;
+	unsigned long cols = (unsigned long)bounds->cols;
+	unsigned long rows = (unsigned long)bounds->rows;
+
+	if (conn->loadgen->type == SP_MSG_GRID)
+	{
+		grid.start.x = (int)(NEXT(conn->rng) % cols);
+		grid.start.y = (int)(NEXT(conn->rng) % rows);
+		grid.target.x = (int)(NEXT(conn->rng) % cols);
+		grid.target.y = (int)(NEXT(conn->rng) % rows);
+		grid.mode = GRID_SEARCH_JPS;
+		grid.connectivity = 8;
+		memcpy(conn->payload, &grid, sizeof(grid));
+		return (sizeof(grid));
+	}
+
+	if (conn->loadgen->type == SP_MSG_PATH)
+		size = 1;
+	else
+	{
+		matrix.nb_sources = matrix.nb_targets = size;
+		memcpy(indices, &matrix, sizeof(matrix));
+		indices += sizeof(matrix) / sizeof(unsigned long);
+	}
+
+	for (i = 0; i < 2 * size; ++i)
+		indices[i] = NEXT(conn->rng) % bounds->nb_vertices;
+
+	return ((size_t)(indices + 2 * size - conn->payload) *
+		sizeof(unsigned long));
+}
@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_path_reserve - Makes room for a path of a given length
+ *
+ * @path: Pointer to sp_path_t structure
+ * @length: Number of vertices to hold
+ *
+ * Return: 1 on success, 0 if a caller buffer is too small or on failure
+ */
+int sp_path_reserve(sp_path_t *path, size_t length)
+{
+	const vertex_t **vertices = NULL;
+	size_t capacity;
+
+	if (length <= path->capacity)
+		return (1);
+
+	if (path->vertices && !path->owned)
+		return (0);
+
+	capacity = path->capacity * 2 > length ? path->capacity * 2 : length;
+	vertices = realloc(path->vertices, capacity * sizeof(const vertex_t *));
+
+	if (!vertices)
+		return (0);
+
+	path->vertices = vertices;
+	path->capacity = capacity;
+	path->owned = 1;
+	return (1);
+}
+
+/**
+ * sp_path_push - Appends a vertex to a path
+ * Once a caller buffer is full, vertices are only counted, so `length`
+ * still ends up holding the size needed
+ *
+ * @path: Pointer to sp_path_t structure
+ * @vertex: Pointer to vertex
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int sp_path_push(sp_path_t *path, const vertex_t *vertex)
+{
+	if (path->length == path->capacity && path->vertices && !path->owned)
+	{
+		++path->length;
+		return (1);
+	}
+
+	if (!sp_path_reserve(path, path->length + 1))
+		return (0);
+
+	path->vertices[path->length++] = vertex;
+	return (1);
+}
+
+/**
+ * sp_path_reverse - Reverses a path in place
+ *
+ * @path: Pointer to sp_path_t structure (fitting in its buffer)
+ */
+void sp_path_reverse(sp_path_t *path)
+{
+	const vertex_t *tmp = NULL;
+	size_t i, j;
+
+	for (i = 0, j = path->length; i + 1 < j; ++i, --j)
+	{
+		tmp = path->vertices[i];
+		path->vertices[i] = path->vertices[j - 1];
+		path->vertices[j - 1] = tmp;
+	}
+}
+
+/**
+ * sp_path_release - Frees a buffer a search allocated, and empties the path
+ *
+ * @path: Pointer to sp_path_t structure
+ */
+void sp_path_release(sp_path_t *path)
+{
+	if (!path)
+		return;
+
+	if (path->owned)
+		free(path->vertices);
+
+	path->vertices = NULL;
+	path->length = path->capacity = 0;
+	path->cost = 0;
+	path->owned = 0;
+}
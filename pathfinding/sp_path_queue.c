@@ -0,0 +1,80 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_path_to_queue - Converts a path to the queue_t form of the original
+ * API (one strdup'd vertex name per node)
+ *
+ * @path: Pointer to sp_path_t structure
+ *
+ * Return: Pointer to queue_t structure, NULL on failure
+ */
+queue_t *sp_path_to_queue(sp_path_t const *path)
+{
+	queue_t *queue = queue_create();
+	char *content = NULL;
+	size_t i;
+
+	for (i = 0; queue && i < path->length; ++i)
+	{
+		content = strdup(path->vertices[i]->content);
+
+		if (!content || !queue_push_back(queue, content))
+		{
+			free(content);
+			queue_delete(queue);
+			return (NULL);
+		}
+	}
+
+	return (queue);
+}
+
+/**
+ * dijkstra_graph_workspace - dijkstra_graph reusing a caller's workspace
+ * Setup is O(1): the cost of a query follows the vertices it settles
+ *
+ * @ws: Workspace with room for every vertex of @graph (not shared between
+ *   threads)
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ *
+ * Return: Pointer to queue_t structure representing the path
+ */
+queue_t *dijkstra_graph_workspace(sp_workspace_t *ws, graph_t *graph,
+	vertex_t const *start, vertex_t const *target)
+{
+	sp_path_t path = { NULL, 0, 0, 0, 0 };
+	queue_t *queue = NULL;
+
+	if (dijkstra_graph_path(ws, graph, start, target, &path))
+		queue = sp_path_to_queue(&path);
+
+	sp_path_release(&path);
+	return (queue);
+}
+
+/**
+ * dijkstra_graph_path - Finds a minimum cost path into a vertex array
+ * Setup is O(1) and nothing is allocated per hop: the cost of a query
+ * follows the vertices it settles
+ *
+ * @ws: Workspace with room for every vertex of @graph (not shared between
+ *   threads)
+ * @graph: Pointer to graph_t structure
+ * @start: Pointer to source vertex
+ * @target: Pointer to destination vertex
+ * @path: Receives the path and its cost (see sp_path_t)
+ *
+ * Return: 1 on success, 0 if there is no path, it does not fit the
+ *   caller's buffer, or on failure
+ */
+int dijkstra_graph_path(sp_workspace_t *ws, graph_t *graph,
+	vertex_t const *start, vertex_t const *target, sp_path_t *path)
+{
+	return (dijkstra_graph_alt(ws, graph, NULL, start, target, path));
+}
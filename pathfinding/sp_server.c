@@ -0,0 +1,215 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int sp_server_listen(sp_server_t *server, char const *socket_path);
+static int sp_server_spawn(sp_server_t *server, sp_worker_t *worker);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_server_create - Binds a path-query server to a Unix domain socket and
+ * starts its workers
+ * Requests are only read once sp_server_run is called
+ *
+ * @graph: Pointer to graph_t structure (vertex indices 0 to n - 1), shared
+ *   read-only by the workers for the server's lifetime
+ * @grid: Pointer to grid_t structure for SP_MSG_GRID requests, or NULL
+ * @socket_path: Path to bind the socket to (a stale socket is replaced)
+ * @nb_workers: Number of worker threads
+ *
+ * Return: Pointer to sp_server_t structure, NULL on failure
+ */
+sp_server_t *sp_server_create(graph_t *graph, grid_t const *grid,
+	char const *socket_path, size_t nb_workers)
+{
+	sp_server_t *server = NULL;
+	const vertex_t *v = NULL;
+	int ok;
+
+	if (!graph || !socket_path || !nb_workers ||
+		strlen(socket_path) >= sizeof(server->socket_path))
+		return (NULL);
+
+	server = calloc(1, sizeof(sp_server_t));
+
+	if (!server)
+		return (NULL);
+
+	if (pthread_mutex_init(&server->lock, NULL))
+	{
+		free(server);
+		return (NULL);
+	}
+
+	pthread_cond_init(&server->ready, NULL);
+	server->graph = graph;
+	server->grid = grid;
+	server->listen_fd = server->wake[0] = server->wake[1] = -1;
+	server->vertices = malloc(graph->nb_vertices * sizeof(vertex_t *) + 1);
+	server->workers = calloc(nb_workers, sizeof(sp_worker_t));
+	ok = server->vertices && server->workers;
+
+	for (v = graph->vertices; ok && v; v = v->next)
+	{
+		ok = v->index < graph->nb_vertices;
+		if (ok)
+			server->vertices[v->index] = v;
+	}
+
+	/* Wake-ups are written by workers, which must never wait */
+	ok = ok && !pipe(server->wake) &&
+		!fcntl(server->wake[0], F_SETFL, O_NONBLOCK) &&
+		!fcntl(server->wake[1], F_SETFL, O_NONBLOCK) &&
+		sp_server_listen(server, socket_path);
+
+	while (ok && server->nb_workers < nb_workers)
+		ok = sp_server_spawn(server,
+			server->workers + server->nb_workers);
+
+	if (!ok)
+	{
+		sp_server_delete(server);
+		return (NULL);
+	}
+
+	return (server);
+}
+
+/**
+ * sp_server_stop - Makes sp_server_run stop accepting and reading, and
+ * return once the replies owed are sent
+ * Safe to call from a signal handler
+ *
+ * @server: Pointer to sp_server_t structure
+ */
+void sp_server_stop(sp_server_t *server)
+{
+	char byte = 0;
+
+	__atomic_store_n(&server->stopping, 1, __ATOMIC_RELEASE);
+
+	if (write(server->wake[1], &byte, 1) < 0)
+		return;
+}
+
+/**
+ * sp_server_delete - Lets the workers finish the requests still queued,
+ * then stops them, closes the socket and deallocates the server
+ * sp_server_run must have returned
+ *
+ * @server: Pointer to sp_server_t structure
+ */
+void sp_server_delete(sp_server_t *server)
+{
+	sp_worker_t *worker = NULL;
+	size_t i;
+
+	if (!server)
+		return;
+
+	pthread_mutex_lock(&server->lock);
+	server->draining = 1;
+	pthread_cond_broadcast(&server->ready);
+	pthread_mutex_unlock(&server->lock);
+
+	for (i = 0; i < server->nb_workers; ++i)
+	{
+		worker = server->workers + i;
+		pthread_join(worker->tid, NULL);
+		sp_workspace_delete(worker->ws);
+		grid_workspace_delete(worker->grid_ws);
+		sp_path_release(&worker->path);
+		free(worker->out);
+	}
+
+	for (i = 0; i < server->nb_conns; ++i)
+		sp_conn_release(server->conns[i]);
+
+	if (server->listen_fd != -1)
+		close(server->listen_fd);
+	if (server->socket_path[0])
+		unlink(server->socket_path);
+	if (server->wake[0] != -1)
+		close(server->wake[0]);
+	if (server->wake[1] != -1)
+		close(server->wake[1]);
+
+	pthread_cond_destroy(&server->ready);
+	pthread_mutex_destroy(&server->lock);
+	free(server->conns);
+	free(server->workers);
+	free(server->vertices);
+	free(server);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * sp_server_listen - Binds and listens on the server's socket
+ *
+ * @server: Pointer to sp_server_t structure
+ * @socket_path: Path to bind the socket to
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int sp_server_listen(sp_server_t *server, char const *socket_path)
+{
+	struct sockaddr_un addr;
+
+	server->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (server->listen_fd == -1)
+		return (0);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socket_path);
+	unlink(socket_path);
+
+	if (bind(server->listen_fd, (struct sockaddr *)&addr, sizeof(addr)))
+		return (0);
+
+	/* Only a socket this server bound is unlinked when it is deleted */
+	strcpy(server->socket_path, socket_path);
+	return (!listen(server->listen_fd, SOMAXCONN));
+}
+
+/**
+ * sp_server_spawn - Allocates a worker's query state and starts it
+ *
+ * @server: Pointer to sp_server_t structure
+ * @worker: Next worker slot
+ *
+ * Return: 1 on success, 0 on failure
+ */
+static int sp_server_spawn(sp_server_t *server, sp_worker_t *worker)
+{
+	const grid_t *grid = server->grid;
+
+	worker->server = server;
+	worker->ws = sp_workspace_create_for(server->graph, SP_HEAP_DEFAULT);
+
+	if (worker->ws && grid)
+		worker->grid_ws = grid_workspace_create((size_t)grid->rows *
+			(size_t)grid->cols);
+
+	if (worker->ws && (!grid || worker->grid_ws) &&
+		!pthread_create(&worker->tid, NULL, sp_server_worker, worker))
+	{
+		++server->nb_workers;
+		return (1);
+	}
+
+	sp_workspace_delete(worker->ws);
+	grid_workspace_delete(worker->grid_ws);
+	worker->ws = NULL;
+	worker->grid_ws = NULL;
+	return (0);
+}
@@ -0,0 +1,163 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* Smallest free space a read may fill */
+#define SP_READ_CHUNK 4096
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_conn_read - Reads what a connection sent
+ * A client that shuts its end down is marked `eof`, and is still answered
+ *
+ * @conn: Pointer to sp_conn_t structure
+ *
+ * Return: 1 to keep the connection, 0 to drop it
+ */
+int sp_conn_read(sp_conn_t *conn)
+{
+	unsigned char *grown = NULL;
+	size_t capacity = conn->capacity;
+	ssize_t n;
+
+	if (capacity - conn->size < SP_READ_CHUNK)
+	{
+		capacity = capacity ? 2 * capacity : 16 * SP_READ_CHUNK;
+		grown = realloc(conn->buf, capacity);
+		if (!grown)
+			return (0);
+		conn->buf = grown;
+		conn->capacity = capacity;
+	}
+
+	n = read(conn->fd, conn->buf + conn->size, conn->capacity - conn->size);
+
+	if (n < 0)
+		return (errno == EINTR || errno == EAGAIN);
+	if (!n)
+	{
+		conn->eof = 1;
+		return (1);
+	}
+
+	conn->size += (size_t)n;
+	return (1);
+}
+
+/**
+ * sp_conn_flush - Sends as many queued replies as the socket takes without
+ * waiting
+ *
+ * @conn: Pointer to sp_conn_t structure
+ *
+ * Return: 1 on success, 0 if the client went away
+ */
+int sp_conn_flush(sp_conn_t *conn)
+{
+	ssize_t n = 0;
+	int ok = 1;
+
+	pthread_mutex_lock(&conn->lock);
+
+	while (conn->out_sent < conn->out_size)
+	{
+		n = send(conn->fd, conn->out + conn->out_sent,
+			conn->out_size - conn->out_sent,
+			MSG_NOSIGNAL | MSG_DONTWAIT);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+		conn->out_sent += (size_t)n;
+		conn->since = sp_clock_ns();
+	}
+
+	if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+		ok = 0;
+	if (conn->out_sent == conn->out_size)
+		conn->out_sent = conn->out_size = 0;
+
+	pthread_mutex_unlock(&conn->lock);
+	return (ok);
+}
+
+/**
+ * sp_conn_parse - Queues the whole requests at the start of a
+ * connection's buffer, all at once
+ * No more are queued than bring the connection to SP_CONN_PENDING_MAX
+ * unanswered, and none while SP_CONN_OUT_MAX reply bytes are unsent: the
+ * others wait in the buffer
+ *
+ * @server: Pointer to sp_server_t structure
+ * @conn: Pointer to sp_conn_t structure
+ *
+ * Return: 1 on success, 0 if the connection sent a request too large or
+ *   the server ran out of memory
+ */
+int sp_conn_parse(sp_server_t *server, sp_conn_t *conn)
+{
+	sp_job_t *head = NULL, *tail = NULL, **link = &head, *job = NULL;
+	size_t pos = 0, count = 0, room, left;
+	sp_msg_header_t header;
+	unsigned long now;
+	int ok = 1;
+
+	if (conn->size < sizeof(header))
+		return (1);
+
+	/* Replies queued meanwhile are bounded by SP_CONN_PENDING_MAX */
+	pthread_mutex_lock(&conn->lock);
+	room = conn->pending < SP_CONN_PENDING_MAX &&
+		conn->out_size - conn->out_sent < SP_CONN_OUT_MAX ?
+		SP_CONN_PENDING_MAX - conn->pending : 0;
+	pthread_mutex_unlock(&conn->lock);
+	now = sp_clock_ns();
+
+	while (count < room && (left = conn->size - pos) >= sizeof(header))
+	{
+		memcpy(&header, conn->buf + pos, sizeof(header));
+		ok = header.length <= SP_MSG_MAX;
+		if (!ok || left - sizeof(header) < header.length)
+			break;
+		job = malloc(sizeof(sp_job_t) + header.length);
+		ok = job != NULL;
+		if (!ok)
+			break;
+		job->conn = conn;
+		job->header = header;
+		job->payload = (unsigned char *)(job + 1);
+		memcpy(job->payload, conn->buf + pos + sizeof(header),
+			header.length);
+		job->queued = now;
+		job->next = NULL;
+		*link = tail = job;
+		link = &job->next;
+		++count;
+		pos += sizeof(header) + header.length;
+	}
+
+	memmove(conn->buf, conn->buf + pos, conn->size - pos);
+	conn->size -= pos;
+
+	if (!count)
+		return (ok);
+
+	__atomic_add_fetch(&conn->refs, count, __ATOMIC_RELAXED);
+	pthread_mutex_lock(&conn->lock);
+	conn->pending += count;
+	pthread_mutex_unlock(&conn->lock);
+
+	pthread_mutex_lock(&server->lock);
+	*(server->tail ? &server->tail->next : &server->head) = head;
+	server->tail = tail;
+	if (count > 1)
+		pthread_cond_broadcast(&server->ready);
+	else
+		pthread_cond_signal(&server->ready);
+	pthread_mutex_unlock(&server->lock);
+	return (ok);
+}
@@ -0,0 +1,245 @@
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int sp_server_accept(sp_server_t *server);
+static int sp_server_events(sp_server_t *server, struct pollfd *fds,
+	int stopping);
+static int sp_server_serve(sp_server_t *server, sp_conn_t *conn,
+	short revents, int stopping);
+static void sp_server_drop(sp_server_t *server, size_t i);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_server_run - Accepts connections, queues their requests for the
+ * workers and sends the replies until sp_server_stop is called
+ * A client may send many requests without waiting for replies, but is not
+ * read while too many are owed to it. A client whose request is malformed
+ * beyond recovery, or who stops reading replies, is disconnected. Once
+ * stopped, the replies owed are sent before returning
+ *
+ * @server: Pointer to sp_server_t structure
+ *
+ * Return: 1 once stopped, 0 on failure
+ */
+int sp_server_run(sp_server_t *server)
+{
+	struct pollfd *fds = NULL, *grown = NULL;
+	size_t capacity = 0, nb_fds, i;
+	int ok = server != NULL, stopping = 0, timeout;
+	short revents;
+	sp_conn_t *conn = NULL;
+	char drain[64];
+
+	while (ok && (!stopping || server->nb_conns))
+	{
+		nb_fds = server->nb_conns + 2;
+		if (nb_fds > capacity)
+		{
+			capacity = 2 * nb_fds;
+			grown = realloc(fds, capacity * sizeof(struct pollfd));
+			ok = grown != NULL;
+			if (!ok)
+				break;
+			fds = grown;
+		}
+
+		timeout = sp_server_events(server, fds, stopping);
+		if (poll(fds, nb_fds, timeout) < 0)
+		{
+			ok = errno == EINTR;
+			continue;
+		}
+
+		/* Wake-ups only make poll return: the pipe is emptied */
+		while (fds[1].revents && read(server->wake[0], drain, 64) > 0)
+			;
+		stopping = __atomic_load_n(&server->stopping, __ATOMIC_ACQUIRE);
+
+		/* Dropping moves the last connection down: go backwards */
+		for (i = nb_fds - 2; i--;)
+		{
+			conn = server->conns[i];
+			revents = fds[i + 2].revents;
+			if ((revents & POLLIN) && !sp_conn_read(conn))
+				sp_server_drop(server, i);
+			else if (!sp_server_serve(server, conn, revents,
+				stopping))
+				sp_server_drop(server, i);
+		}
+
+		if (fds[0].revents && !stopping)
+			ok = sp_server_accept(server);
+	}
+
+	while (server && server->nb_conns)
+		sp_server_drop(server, server->nb_conns - 1);
+
+	free(fds);
+	return (ok);
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * sp_server_accept - Accepts a connection
+ * A connection that cannot be accepted or tracked is closed, and the
+ * server goes on
+ *
+ * @server: Pointer to sp_server_t structure
+ *
+ * Return: 1 on success, 0 if the listening socket failed
+ */
+static int sp_server_accept(sp_server_t *server)
+{
+	sp_conn_t *conn = NULL, **grown = NULL;
+	size_t capacity = 2 * server->conns_capacity + 8;
+	int fd = accept(server->listen_fd, NULL, NULL);
+
+	if (fd == -1)
+		return (errno != EBADF && errno != EINVAL && errno != ENOTSOCK);
+
+	if (server->nb_conns == server->conns_capacity)
+	{
+		grown = realloc(server->conns, capacity * sizeof(sp_conn_t *));
+		if (grown)
+		{
+			server->conns = grown;
+			server->conns_capacity = capacity;
+		}
+	}
+
+	if (server->nb_conns < server->conns_capacity)
+		conn = calloc(1, sizeof(sp_conn_t));
+
+	if (!conn || pthread_mutex_init(&conn->lock, NULL))
+	{
+		free(conn);
+		close(fd);
+		return (1);
+	}
+
+	conn->fd = fd;
+	conn->refs = 1;
+	server->conns[server->nb_conns++] = conn;
+	return (1);
+}
+
+/**
+ * sp_server_events - Sets up the poll of the listening socket, the wake-up
+ * pipe and every connection
+ * A connection is only read while it owes fewer than SP_CONN_PENDING_MAX
+ * replies and SP_CONN_OUT_MAX bytes, and only written with replies queued
+ *
+ * @server: Pointer to sp_server_t structure
+ * @fds: Poll entries, 2 + server->nb_conns of them
+ * @stopping: Set once the server stopped accepting and reading
+ *
+ * Return: Poll timeout, in milliseconds, until the first queued replies
+ *   time out, -1 if none are queued
+ */
+static int sp_server_events(sp_server_t *server, struct pollfd *fds,
+	int stopping)
+{
+	unsigned long now = sp_clock_ns(), left, first = (unsigned long)-1;
+	unsigned long timeout = SP_SEND_TIMEOUT_MS * 1000000UL;
+	sp_conn_t *conn = NULL;
+	size_t i, unsent;
+
+	fds[0].fd = server->listen_fd;
+	fds[0].events = stopping ? 0 : POLLIN;
+	fds[1].fd = server->wake[0];
+	fds[1].events = POLLIN;
+
+	for (i = 0; i < server->nb_conns; ++i)
+	{
+		conn = server->conns[i];
+		pthread_mutex_lock(&conn->lock);
+		unsent = conn->out_size - conn->out_sent;
+		fds[i + 2].fd = conn->fd;
+		fds[i + 2].events = unsent ? POLLOUT : 0;
+		if (!stopping && !conn->eof && unsent < SP_CONN_OUT_MAX &&
+			conn->pending < SP_CONN_PENDING_MAX)
+			fds[i + 2].events |= POLLIN;
+		left = now - conn->since < timeout ?
+			timeout - (now - conn->since) : 0;
+		first = unsent && left < first ? left : first;
+		pthread_mutex_unlock(&conn->lock);
+	}
+
+	/* Round up, so the poll does not return just before the deadline */
+	return (first == (unsigned long)-1 ? -1 : (int)((first + 999999) /
+		1000000));
+}
+
+/**
+ * sp_server_serve - Sends what a connection's socket takes of its queued
+ * replies, queues the requests it has room for, and tells whether to keep
+ * it
+ * A connection is dropped once its replies cannot be sent, have not
+ * drained for SP_SEND_TIMEOUT_MS, or once it is owed none and will send
+ * no more requests
+ *
+ * @server: Pointer to sp_server_t structure
+ * @conn: Pointer to sp_conn_t structure
+ * @revents: Poll result of its socket
+ * @stopping: Set once the server stopped accepting and reading
+ *
+ * Return: 1 to keep the connection, 0 to drop it
+ */
+static int sp_server_serve(sp_server_t *server, sp_conn_t *conn,
+	short revents, int stopping)
+{
+	unsigned long timeout = SP_SEND_TIMEOUT_MS * 1000000UL;
+	int ok = !(revents & (POLLERR | POLLHUP | POLLNVAL));
+
+	if (ok && (revents & POLLOUT))
+		ok = sp_conn_flush(conn);
+
+	/* Sent replies may have made room for requests already read */
+	ok = ok && sp_conn_parse(server, conn);
+
+	pthread_mutex_lock(&conn->lock);
+	ok = ok && !conn->closing;
+	if (conn->out_sent < conn->out_size)
+		ok = ok && sp_clock_ns() - conn->since < timeout;
+	else if (conn->eof || stopping)
+		ok = ok && conn->pending;
+	pthread_mutex_unlock(&conn->lock);
+	return (ok);
+}
+
+/**
+ * sp_server_drop - Stops serving a connection
+ * Its requests still queued are served, but their replies are discarded;
+ * it closes after the last one
+ *
+ * @server: Pointer to sp_server_t structure
+ * @i: Index of the connection
+ */
+static void sp_server_drop(sp_server_t *server, size_t i)
+{
+	sp_conn_t *conn = server->conns[i];
+
+	server->conns[i] = server->conns[--server->nb_conns];
+	free(conn->buf);
+	conn->buf = NULL;
+	conn->size = conn->capacity = 0;
+
+	pthread_mutex_lock(&conn->lock);
+	conn->closing = 1;
+	free(conn->out);
+	conn->out = NULL;
+	conn->out_sent = conn->out_size = conn->out_capacity = 0;
+	pthread_mutex_unlock(&conn->lock);
+
+	/* The client sees the end of the connection now, not after its jobs */
+	shutdown(conn->fd, SHUT_RDWR);
+	sp_conn_release(conn);
+}
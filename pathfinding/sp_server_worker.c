@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static int sp_serve_path(sp_worker_t *worker, sp_job_t const *job,
+	size_t *length);
+static int sp_serve_grid(sp_worker_t *worker, sp_job_t const *job,
+	size_t *length);
+static int sp_serve_matrix(sp_worker_t *worker, sp_job_t const *job,
+	size_t *length);
+static int sp_serve_stats(sp_worker_t *worker, sp_job_t const *job,
+	size_t *length);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_server_worker - Serves queued requests until the server is deleted
+ * Each reply is built in the worker's own buffer and queued whole on its
+ * connection, never waiting on the client; its latency, from the request
+ * being read to the reply being queued, is counted under the request's
+ * type
+ *
+ * @arg: Pointer to sp_worker_t structure
+ *
+ * Return: NULL
+ */
+void *sp_server_worker(void *arg)
+{
+	sp_worker_t *worker = arg;
+	sp_server_t *server = worker->server;
+	sp_msg_header_t header;
+	sp_job_t *job = NULL;
+	size_t length, type;
+
+	while (1)
+	{
+		pthread_mutex_lock(&server->lock);
+		while (!server->head && !server->draining)
+			pthread_cond_wait(&server->ready, &server->lock);
+		job = server->head;
+		if (job)
+			server->head = job->next;
+		if (!server->head)
+			server->tail = NULL;
+		pthread_mutex_unlock(&server->lock);
+
+		if (!job)
+			return (NULL);
+
+		header = job->header;
+		type = header.type < SP_MSG_TYPES ? header.type : SP_MSG_NONE;
+		length = 0;
+		switch (header.type)
+		{
+		case SP_MSG_PATH:
+			header.status = sp_serve_path(worker, job, &length);
+			break;
+		case SP_MSG_GRID:
+			header.status = sp_serve_grid(worker, job, &length);
+			break;
+		case SP_MSG_MATRIX:
+			header.status = sp_serve_matrix(worker, job, &length);
+			break;
+		case SP_MSG_STATS:
+			header.status = sp_serve_stats(worker, job, &length);
+			break;
+		default:
+			header.status = SP_MSG_BAD_REQUEST;
+		}
+
+		/* Replies without a payload need no buffer */
+		header.length = header.status == SP_MSG_OK ? length : 0;
+		if (header.length)
+			memcpy(worker->out, &header, sizeof(header));
+		sp_server_reply(server, job->conn, header.length ?
+			(void *)worker->out : (void *)&header,
+			sizeof(header) + header.length);
+		sp_latency_record(worker->latency[type],
+			sp_clock_ns() - job->queued);
+		sp_conn_release(job->conn);
+		free(job);
+	}
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * sp_serve_path - Serves a SP_MSG_PATH request
+ *
+ * @worker: Pointer to sp_worker_t structure
+ * @job: Request
+ * @length: Set to the size of the reply payload
+ *
+ * Return: sp_msg_status_t
+ */
+static int sp_serve_path(sp_worker_t *worker, sp_job_t const *job,
+	size_t *length)
+{
+	const sp_server_t *server = worker->server;
+	unsigned long *out = NULL;
+	sp_msg_path_t req;
+	size_t i;
+
+	if (job->header.length != sizeof(req))
+		return (SP_MSG_BAD_REQUEST);
+
+	memcpy(&req, job->payload, sizeof(req));
+
+	if (req.source >= server->graph->nb_vertices ||
+		req.target >= server->graph->nb_vertices)
+		return (SP_MSG_BAD_REQUEST);
+
+	if (!dijkstra_graph_path(worker->ws, server->graph,
+		server->vertices[req.source], server->vertices[req.target],
+		&worker->path))
+		return (SP_MSG_NO_PATH);
+
+	*length = (2 + worker->path.length) * sizeof(unsigned long);
+	out = sp_worker_reserve(worker, *length);
+
+	if (!out)
+		return (SP_MSG_FAILED);
+
+	out[0] = worker->path.cost;
+	out[1] = worker->path.length;
+	for (i = 0; i < worker->path.length; ++i)
+		out[2 + i] = worker->path.vertices[i]->index;
+
+	return (SP_MSG_OK);
+}
+
+/**
+ * sp_serve_grid - Serves a SP_MSG_GRID request
+ *
+ * @worker: Pointer to sp_worker_t structure
+ * @job: Request
+ * @length: Set to the size of the reply payload
+ *
+ * Return: sp_msg_status_t
+ */
+static int sp_serve_grid(sp_worker_t *worker, sp_job_t const *job,
+	size_t *length)
+{
+	const grid_t *grid = worker->server->grid;
+	const queue_node_t *node = NULL;
+	point_t *point = NULL, *cells = NULL;
+	unsigned long count = 0;
+	queue_t *path = NULL;
+	sp_msg_grid_t req;
+
+	if (!grid || job->header.length != sizeof(req))
+		return (SP_MSG_BAD_REQUEST);
+
+	memcpy(&req, job->payload, sizeof(req));
+
+	if ((req.mode != GRID_SEARCH_BFS && req.mode != GRID_SEARCH_JPS) ||
+		(req.connectivity != 4 && req.connectivity != 8) ||
+		!GRID_IN(grid, req.start.x, req.start.y) ||
+		!GRID_IN(grid, req.target.x, req.target.y))
+		return (SP_MSG_BAD_REQUEST);
+
+	path = grid_shortest_path_workspace(worker->grid_ws, grid, &req.start,
+		&req.target, (grid_search_t)req.mode, req.connectivity, NULL);
+
+	if (!path)
+		return (SP_MSG_NO_PATH);
+
+	for (node = path->front; node; node = node->next)
+		++count;
+
+	*length = sizeof(count) + count * sizeof(point_t);
+	cells = sp_worker_reserve(worker, *length);
+
+	if (cells)
+	{
+		memcpy(cells, &count, sizeof(count));
+		cells = (point_t *)((unsigned long *)cells + 1);
+	}
+
+	while ((point = dequeue(path)))
+	{
+		if (cells)
+			*cells++ = *point;
+		free(point);
+	}
+
+	queue_delete(path);
+	return (cells ? SP_MSG_OK : SP_MSG_FAILED);
+}
+
+/**
+ * sp_serve_matrix - Serves a SP_MSG_MATRIX request
+ * One thread per request: the workers already run requests in parallel
+ *
+ * @worker: Pointer to sp_worker_t structure
+ * @job: Request
+ * @length: Set to the size of the reply payload
+ *
+ * Return: sp_msg_status_t
+ */
+static int sp_serve_matrix(sp_worker_t *worker, sp_job_t const *job,
+	size_t *length)
+{
+	const sp_server_t *server = worker->server;
+	const unsigned long *indices = NULL;
+	const vertex_t **vertices = NULL;
+	unsigned long *out = NULL;
+	sp_msg_matrix_t req;
+	size_t i, count;
+	int ok;
+
+	if (job->header.length < sizeof(req))
+		return (SP_MSG_BAD_REQUEST);
+
+	memcpy(&req, job->payload, sizeof(req));
+	count = (job->header.length - sizeof(req)) / sizeof(unsigned long);
+
+	/* The reply must fit in a message too */
+	if ((job->header.length - sizeof(req)) % sizeof(unsigned long) ||
+		!req.nb_sources || !req.nb_targets || req.nb_sources > count ||
+		req.nb_targets != count - req.nb_sources ||
+		req.nb_targets > SP_MSG_MAX / sizeof(unsigned long) /
+		req.nb_sources)
+		return (SP_MSG_BAD_REQUEST);
+
+	indices = (const unsigned long *)(job->payload + sizeof(req));
+
+	for (i = 0; i < count; ++i)
+		if (indices[i] >= server->graph->nb_vertices)
+			return (SP_MSG_BAD_REQUEST);
+
+	*length = req.nb_sources * req.nb_targets * sizeof(unsigned long);
+	out = sp_worker_reserve(worker, *length);
+	vertices = malloc(count * sizeof(vertex_t *));
+	ok = out && vertices;
+
+	for (i = 0; ok && i < count; ++i)
+		vertices[i] = server->vertices[indices[i]];
+
+	ok = ok && distance_matrix_threads(server->graph, vertices,
+		req.nb_sources, vertices + req.nb_sources, req.nb_targets, out,
+		1);
+	free(vertices);
+	return (ok ? SP_MSG_OK : SP_MSG_FAILED);
+}
+
+/**
+ * sp_serve_stats - Serves a SP_MSG_STATS request
+ * Latencies are read while the other workers record theirs: the counts
+ * are a near-instant snapshot
+ *
+ * @worker: Pointer to sp_worker_t structure
+ * @job: Request
+ * @length: Set to the size of the reply payload
+ *
+ * Return: sp_msg_status_t
+ */
+static int sp_serve_stats(sp_worker_t *worker, sp_job_t const *job,
+	size_t *length)
+{
+	const sp_server_t *server = worker->server;
+	sp_msg_stats_t *stats = NULL;
+	size_t w, t, b;
+
+	if (job->header.length)
+		return (SP_MSG_BAD_REQUEST);
+
+	*length = sizeof(sp_msg_stats_t);
+	stats = sp_worker_reserve(worker, *length);
+
+	if (!stats)
+		return (SP_MSG_FAILED);
+
+	memset(stats, 0, sizeof(sp_msg_stats_t));
+	stats->nb_vertices = server->graph->nb_vertices;
+	stats->rows = server->grid ? server->grid->rows : 0;
+	stats->cols = server->grid ? server->grid->cols : 0;
+
+	for (w = 0; w < server->nb_workers; ++w)
+		for (t = 0; t < SP_MSG_TYPES; ++t)
+			for (b = 0; b < SP_LATENCY_BUCKETS; ++b)
+				stats->latency[t][b] += __atomic_load_n(
+					&server->workers[w].latency[t][b],
+					__ATOMIC_RELAXED);
+
+	return (SP_MSG_OK);
+}
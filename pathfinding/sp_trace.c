@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+__thread sp_trace_sink_t *sp_trace_active;
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_trace_sink_create - Allocates a trace sink
+ *
+ * @capacity: Number of events buffered between two flushes
+ * @flush: Callback receiving batches of events, or NULL to keep the last
+ *   @capacity events
+ * @data: User data passed to @flush
+ *
+ * Return: Pointer to sp_trace_sink_t structure, NULL on failure
+ */
+sp_trace_sink_t *sp_trace_sink_create(size_t capacity, sp_trace_fn_t flush,
+	void *data)
+{
+	sp_trace_sink_t *sink = NULL;
+
+	if (!capacity)
+		return (NULL);
+
+	sink = calloc(1, sizeof(sp_trace_sink_t) +
+		capacity * sizeof(sp_trace_event_t));
+
+	if (!sink)
+		return (NULL);
+
+	sink->flush = flush;
+	sink->data = data;
+	sink->mask = SP_TRACE_ALL;
+	sink->capacity = capacity;
+	sink->events = (sp_trace_event_t *)(sink + 1);
+	return (sink);
+}
+
+/**
+ * sp_trace_sink_delete - Flushes and deallocates a trace sink, detaching
+ * it from the calling thread
+ *
+ * @sink: Pointer to sp_trace_sink_t structure
+ */
+void sp_trace_sink_delete(sp_trace_sink_t *sink)
+{
+	if (!sink)
+		return;
+
+	if (sp_trace_active == sink)
+		sp_trace_active = NULL;
+
+	sp_trace_flush(sink);
+	free(sink);
+}
+
+/**
+ * sp_trace_attach - Routes the calling thread's trace events to a sink
+ *
+ * @sink: Pointer to sp_trace_sink_t structure, NULL to turn tracing off
+ *
+ * Return: Sink previously attached, NULL if none
+ */
+sp_trace_sink_t *sp_trace_attach(sp_trace_sink_t *sink)
+{
+	sp_trace_sink_t *prev = sp_trace_active;
+
+	sp_trace_active = sink;
+	return (prev);
+}
+
+/**
+ * sp_trace_emit - Stores a trace event (called through SP_TRACE)
+ *
+ * @sink: Pointer to sp_trace_sink_t structure
+ * @kind: Step taken
+ * @search: Search taking it
+ * @vertex: Vertex concerned, NULL for the array search
+ * @source: Start vertex of the search, NULL for the array search
+ * @x: X coordinate of the cell concerned (array search)
+ * @y: Y coordinate of the cell concerned (array search)
+ * @value: Distance of the vertex, 0 if not applicable
+ */
+void sp_trace_emit(sp_trace_sink_t *sink, sp_trace_kind_t kind,
+	sp_trace_search_t search, const vertex_t *vertex,
+	const vertex_t *source, int x, int y, unsigned long value)
+{
+	sp_trace_event_t *event = NULL;
+
+	if (sink->size == sink->capacity)
+	{
+		if (sink->flush)
+			sp_trace_flush(sink);
+		else
+		{
+			/* Recorder mode: the oldest event gives way */
+			sink->head = (sink->head + 1) % sink->capacity;
+			--sink->size;
+			++sink->dropped;
+		}
+	}
+
+	event = &sink->events[(sink->head + sink->size++) % sink->capacity];
+	event->kind = kind;
+	event->search = search;
+	event->vertex = vertex;
+	event->source = source;
+	event->x = x;
+	event->y = y;
+	event->value = value;
+}
+
+/**
+ * sp_trace_flush - Hands the buffered events to the sink's callback, in at
+ * most two batches, and empties the ring
+ * Without a callback the events are kept
+ *
+ * @sink: Pointer to sp_trace_sink_t structure
+ */
+void sp_trace_flush(sp_trace_sink_t *sink)
+{
+	size_t first;
+
+	if (!sink || !sink->flush || !sink->size)
+		return;
+
+	first = sink->capacity - sink->head;
+
+	if (first > sink->size)
+		first = sink->size;
+
+	sink->flush(sink->events + sink->head, first, sink->data);
+
+	if (first < sink->size)
+		sink->flush(sink->events, sink->size - first, sink->data);
+
+	sink->head = 0;
+	sink->size = 0;
+}
@@ -0,0 +1,39 @@
+#include <stdio.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_trace_print - Trace callback printing expansions the way the searches
+ * used to print them unconditionally
+ * Attach a sink with this callback and SP_TRACE_BIT(SP_TRACE_EXPAND) as its
+ * mask to get the former output back
+ *
+ * @events: Events, oldest first
+ * @count: Number of events
+ * @data: FILE stream to print to, NULL for stdout
+ */
+void sp_trace_print(const sp_trace_event_t *events, size_t count,
+	void *data)
+{
+	FILE *stream = data ? (FILE *)data : stdout;
+	size_t i;
+
+	for (i = 0; i < count; ++i)
+	{
+		if (events[i].kind != SP_TRACE_EXPAND)
+			continue;
+
+		if (events[i].search == SP_TRACE_ARRAY)
+			fprintf(stream, "Checking coordinates [%d, %d]\n",
+				events[i].x, events[i].y);
+		else if (events[i].search == SP_TRACE_GRAPH)
+			fprintf(stream, "Checking %s\n",
+				events[i].vertex->content);
+		else
+			fprintf(stream,
+				"Checking %s, distance from %s is %lu\n",
+				events[i].vertex->content,
+				events[i].source->content, events[i].value);
+	}
+}
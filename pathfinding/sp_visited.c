@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding.h"
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_visited_create - Allocates visited marks for backtracking
+ *
+ * @capacity: Number of marks (vertices of the largest graph, or cells of
+ *   the largest maze, the marks will serve)
+ *
+ * Return: Pointer to sp_visited_t structure, NULL on failure
+ */
+sp_visited_t *sp_visited_create(size_t capacity)
+{
+	sp_visited_t *visited = NULL;
+
+	/* calloc leaves every mark at epoch 0, which no search uses */
+	visited = calloc(1, sizeof(sp_visited_t) + capacity);
+
+	if (!visited)
+		return (NULL);
+
+	visited->capacity = capacity;
+	visited->marks = (unsigned char *)(visited + 1);
+	return (visited);
+}
+
+/**
+ * sp_visited_delete - Deallocates visited marks
+ *
+ * @visited: Pointer to sp_visited_t structure
+ */
+void sp_visited_delete(sp_visited_t *visited)
+{
+	free(visited);
+}
+
+/**
+ * sp_visited_reset - Forgets the previous search's marks
+ * O(1), except once every 255 searches when the epoch wraps around and the
+ * marks are cleared
+ *
+ * @visited: Pointer to sp_visited_t structure
+ */
+void sp_visited_reset(sp_visited_t *visited)
+{
+	if (++visited->epoch)
+		return;
+
+	memset(visited->marks, 0, visited->capacity);
+	visited->epoch = 1;
+}
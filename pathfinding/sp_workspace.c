@@ -0,0 +1,110 @@
+#include <stdlib.h>
+#include "pathfinding.h"
+
+/* STATIC FUNCTIONS */
+
+static sp_workspace_t *workspace_wrap(size_t capacity, sp_heap_t *pq);
+
+/* API IMPLEMENTATION */
+
+/**
+ * sp_workspace_create - Allocates a query workspace
+ *
+ * @capacity: Number of entries (vertices of the largest graph, or cells of
+ *   the largest grid, the workspace will serve)
+ * @kind: Priority queue implementation (any but SP_HEAP_AUTO)
+ *
+ * Return: Pointer to sp_workspace_t structure, NULL on failure
+ */
+sp_workspace_t *sp_workspace_create(size_t capacity, sp_heap_kind_t kind)
+{
+	return (workspace_wrap(capacity, sp_heap_create(kind, capacity)));
+}
+
+/**
+ * sp_workspace_create_for - Allocates a query workspace sized for a graph
+ *
+ * @graph: Pointer to graph_t structure the workspace will serve
+ * @kind: Priority queue implementation, or SP_HEAP_AUTO
+ *
+ * Return: Pointer to sp_workspace_t structure, NULL on failure
+ */
+sp_workspace_t *sp_workspace_create_for(graph_t const *graph,
+	sp_heap_kind_t kind)
+{
+	if (!graph)
+		return (NULL);
+
+	return (workspace_wrap(graph->nb_vertices,
+		sp_heap_create_for(graph, kind)));
+}
+
+/**
+ * sp_workspace_delete - Deallocates a query workspace
+ *
+ * @ws: Pointer to sp_workspace_t structure
+ */
+void sp_workspace_delete(sp_workspace_t *ws)
+{
+	if (!ws)
+		return;
+
+	sp_heap_delete(ws->pq);
+	free(ws);
+}
+
+/**
+ * sp_workspace_reset - Forgets the previous query's state
+ * O(1) apart from emptying what the previous query left queued (see
+ * sp_heap_clear); entries are only rewritten when the epoch counter wraps
+ * around
+ *
+ * @ws: Pointer to sp_workspace_t structure
+ */
+void sp_workspace_reset(sp_workspace_t *ws)
+{
+	size_t i;
+
+	sp_heap_clear(ws->pq);
+
+	if (++ws->epoch)
+		return;
+
+	for (i = 0; i < ws->capacity; ++i)
+		ws->entries[i].epoch = 0;
+
+	ws->epoch = 1;
+}
+
+/* STATIC FUNCTIONS */
+
+/**
+ * workspace_wrap - Allocates a workspace's entries around a priority queue
+ *
+ * @capacity: Number of entries
+ * @pq: Priority queue (the workspace takes ownership), NULL on failure
+ *
+ * Return: Pointer to sp_workspace_t structure, NULL on failure
+ */
+static sp_workspace_t *workspace_wrap(size_t capacity, sp_heap_t *pq)
+{
+	sp_workspace_t *ws = NULL;
+
+	if (!pq)
+		return (NULL);
+
+	/* calloc leaves every entry at epoch 0, which no query uses */
+	ws = calloc(1, sizeof(sp_workspace_t) +
+		capacity * sizeof(dijkstra_entry_t));
+
+	if (!ws)
+	{
+		sp_heap_delete(pq);
+		return (NULL);
+	}
+
+	ws->capacity = capacity;
+	ws->entries = (dijkstra_entry_t *)(ws + 1);
+	ws->pq = pq;
+	return (ws);
+}